@@ -0,0 +1,157 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory_resource>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::string_literals;
+
+/**
+ * @brief parameters of the benchmarked workload : each thread handles
+ *        `requests` requests of `operations` operations each, every
+ *        `error_rate`th of which fails with a dynamic description
+ *
+ * @note: descriptions fit into the small buffer of `std::string` so
+ *        payloads are the only allocations measured
+ */
+auto constexpr requests =
+  std::size_t{256};
+auto constexpr operations =
+  std::size_t{256};
+auto constexpr error_rate =
+  std::size_t{16};
+
+auto operation( std::size_t i )
+  -> mry::expect< std::int64_t >
+{
+  if (i % error_rate == 0)
+    return mry::error_t{ "failed at "s + std::to_string(i) };
+
+  return static_cast<std::int64_t>( i );
+}
+
+/**
+ * @brief request performs the operations of a single request
+ */
+auto request( std::size_t r )
+  -> std::size_t
+{
+  auto described =
+    std::size_t{0};
+
+  for (auto i =std::size_t{0}; i < operations; ++i)
+  {
+    auto result =
+      operation( r * operations + i );
+
+    if (result.holds_error())
+      described += result.fail().get().size();
+  }
+
+  return described;
+}
+
+/**
+ * @brief run runs `threads` threads each handling its requests by
+ *        `handle` -- returned results accumulated
+ */
+template <typename Handle>
+  auto run( std::size_t threads, Handle handle )
+    -> std::size_t
+{
+  auto described =
+    std::atomic<std::size_t>{0};
+  auto pool =
+    std::vector<std::thread>{};
+
+  pool.reserve( threads );
+
+  for (auto t =std::size_t{0}; t < threads; ++t)
+    pool.emplace_back( [&]{ described += handle(); } );
+
+  for (auto &thread : pool)
+    thread.join();
+
+  return described.load();
+}
+
+TEST_CASE( "benchmark error_t arena", "[benchmark][error_t][arena]" )
+{
+  auto global =
+    []
+    {
+      auto described =
+        std::size_t{0};
+
+      for (auto r =std::size_t{0}; r < requests; ++r)
+        described += request( r );
+
+      return described;
+    };
+
+  auto arena =
+    []
+    {
+      auto described =
+        std::size_t{0};
+      auto arena =
+        mry::error_arena{ std::size_t{4096} };
+
+      for (auto r =std::size_t{0}; r < requests; ++r)
+      {
+        described += request( r );
+        arena.release();
+      }
+
+      return described;
+    };
+
+  REQUIRE( global() == arena() );
+
+  BENCHMARK( "{baseline}: global heap : 1 thread" )
+  { return run( 1, global ); };
+
+  BENCHMARK( "error_t : arena : 1 thread" )
+  { return run( 1, arena ); };
+
+  BENCHMARK( "{baseline}: global heap : 4 threads" )
+  { return run( 4, global ); };
+
+  BENCHMARK( "error_t : arena : 4 threads" )
+  { return run( 4, arena ); };
+
+  BENCHMARK( "{baseline}: global heap : 16 threads" )
+  { return run( 16, global ); };
+
+  BENCHMARK( "error_t : arena : 16 threads" )
+  { return run( 16, arena ); };
+}
+
+} //< namespace
@@ -0,0 +1,161 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string_view>
+#include <cstdint>
+#include <vector>
+#include <array>
+
+namespace {
+
+enum class chain_errc
+{
+  negative,
+  out_of_bounds,
+  odd
+};
+
+} //< namespace
+
+template <>
+  struct mry::error_category< chain_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "chain" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "negative", "out of bounds", "odd" });
+};
+
+namespace {
+
+using value_t =
+  std::int64_t;
+using expect_t =
+  mry::expect< value_t, chain_errc >;
+
+/**
+ * @brief stages of the 5-stage chain benchmarked
+ */
+auto validate( value_t v ) noexcept
+  -> expect_t
+{
+  if (v < 0)
+    return chain_errc::negative;
+
+  return v;
+}
+
+auto twice( value_t v ) noexcept
+  -> value_t
+{ return v * 2; }
+
+auto bound( value_t v ) noexcept
+  -> expect_t
+{
+  if (v > 1'000'000)
+    return chain_errc::out_of_bounds;
+
+  return v;
+}
+
+auto offset( value_t v ) noexcept
+  -> value_t
+{ return v + 3; }
+
+auto even( value_t v ) noexcept
+  -> expect_t
+{
+  if (v % 2)
+    return chain_errc::odd;
+
+  return v;
+}
+
+TEST_CASE( "benchmark expect<T> combinators", "[benchmark][expect<T>][combinators]" )
+{
+  auto inputs =
+    std::vector<value_t>( 4096 );
+
+  for (auto i =std::size_t{0}; i < inputs.size(); ++i)
+    inputs[i] =
+      static_cast<value_t>( i * 7919 % 2'000'000 ) - ( i % 32 == 0 ? 2'000'000 : 0 );
+
+  auto manual =
+    []( value_t input ) noexcept
+      -> expect_t
+    {
+      auto validated =
+        validate( input );
+
+      if (validated.holds_error())
+        return validated;
+
+      auto bounded =
+        bound( twice( validated.success() ) );
+
+      if (bounded.holds_error())
+        return bounded;
+
+      return even( offset( bounded.success() ) );
+    };
+
+  auto chained =
+    []( value_t input ) noexcept
+      -> expect_t
+    {
+      return validate( input )
+        .transform( twice )
+        .and_then( bound )
+        .transform( offset )
+        .and_then( even );
+    };
+
+  /* @note: as `offset` always yields odd values `even` fails whenever
+   *        reached -- hence both paths are taken */
+  REQUIRE( manual( 8 ).holds_error() == chained( 8 ).holds_error() );
+  REQUIRE( manual( -1 ).fail() == chained( -1 ).fail() );
+
+  BENCHMARK( "{baseline}: manual branching : 5 stages" )
+  {
+    auto errors =
+      std::size_t{0};
+
+    for (auto input : inputs)
+      errors += manual( input ).holds_error();
+
+    return errors;
+  };
+
+  BENCHMARK( "expect<T> : combinators : 5 stages" )
+  {
+    auto errors =
+      std::size_t{0};
+
+    for (auto input : inputs)
+      errors += chained( input ).holds_error();
+
+    return errors;
+  };
+}
+
+} //< namespace
@@ -0,0 +1,130 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using expect_t =
+  mry::expect< std::int64_t >;
+
+/**
+ * @brief co_await_depth propagates the result of the leaf `depth`
+ *        frames deep by `co_await`
+ */
+auto co_await_depth( int depth, bool fail )
+  -> expect_t
+{
+  if (depth == 0)
+  {
+    if (fail)
+      co_return mry::error_t{"e"};
+
+    co_return 0;
+  }
+
+  co_return co_await co_await_depth( depth - 1, fail ) + 1;
+}
+
+/**
+ * @brief manual_depth propagates the result of the leaf `depth`
+ *        frames deep by branching
+ */
+auto manual_depth( int depth, bool fail ) noexcept
+  -> expect_t
+{
+  if (depth == 0)
+  {
+    if (fail)
+      return mry::error_t{"e"};
+
+    return 0;
+  }
+
+  auto r =
+    manual_depth( depth - 1, fail );
+
+  if (r.holds_error())
+    return r;
+
+  return r.success() + 1;
+}
+
+/**
+ * @brief throw_depth propagates the result of the leaf `depth`
+ *        frames deep by raising exceptions
+ */
+auto throw_depth( int depth, bool fail )
+  -> std::int64_t
+{
+  if (depth == 0)
+  {
+    if (fail)
+      throw std::runtime_error{"e"};
+
+    return 0;
+  }
+
+  return throw_depth( depth - 1, fail ) + 1;
+}
+
+auto catch_depth( int depth, bool fail ) noexcept
+  -> std::int64_t
+try { return throw_depth( depth, fail ); }
+catch( ... ) { return -1; }
+
+TEST_CASE( "benchmark expect<T> coroutines", "[benchmark][expect<T>][coroutine]" )
+{
+  /* @note: reading depths from a volatile keeps them opaque
+   *        to the optimizer */
+  static int volatile depths[] =
+    { 1, 8, 32 };
+
+  for (int depth : depths)
+  {
+    auto const suffix =
+      " : depth " + std::to_string(depth);
+
+    REQUIRE( co_await_depth( depth, false ).success() == depth );
+    REQUIRE( co_await_depth( depth, true ).holds_error() );
+
+    BENCHMARK( "{baseline}: try-catch : {surely} throw" + suffix )
+    { return catch_depth( depth, true ); };
+
+    BENCHMARK( "{baseline}: manual branching : {surely} return fail" + suffix )
+    { return manual_depth( depth, true ); };
+
+    BENCHMARK( "expect<T> : co_await : {surely} return fail" + suffix )
+    { return co_await_depth( depth, true ); };
+
+    BENCHMARK( "{baseline}: manual branching : {surely} return success" + suffix )
+    { return manual_depth( depth, false ); };
+
+    BENCHMARK( "expect<T> : co_await : {surely} return success" + suffix )
+    { return co_await_depth( depth, false ); };
+  }
+}
+
+} //< namespace
@@ -0,0 +1,108 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+/**
+ * @file error_counters.cc benchmarks the overhead of recording the error
+ *       conditions met per call site
+ *
+ * the fail paths of `error_handling.cc` are measured as is -- recording
+ * only when built with `ErrorCounters=ON` -- and recording explicitly,
+ * hence showing the overhead in either build
+ */
+#include "mry/error_t/counters.h"
+#include "mry/expect.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <source_location>
+#include <string_view>
+#include <cstddef>
+#include <array>
+
+namespace {
+
+enum class bench_errc
+{
+  e
+};
+
+} //< namespace
+
+template <>
+  struct mry::error_category< bench_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "bench" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "e" });
+};
+
+namespace {
+
+/**
+ * @brief recorded records a hit against the call site of the caller
+ *        regardless of the build
+ */
+auto recorded( std::source_location where =std::source_location::current() ) noexcept
+  -> void
+{ mry::internal::this_thread_sites().record( where ); }
+
+TEST_CASE( "benchmark error counters", "[benchmark][error_t][counters]" )
+{
+  using expect_t =
+    mry::expect<int>;
+  using expect_code_t =
+    mry::expect<int, bench_errc>;
+
+  SECTION( "fail" )
+  {
+    auto expect_fail =
+      []() noexcept -> expect_t
+         { return mry::error_t{"e"}; };
+    auto expect_code_fail =
+      []() noexcept -> expect_code_t
+         { return bench_errc::e; };
+    auto expect_recorded_fail =
+      []() noexcept -> expect_t
+         { recorded(); return mry::error_t{"e"}; };
+    auto expect_code_recorded_fail =
+      []() noexcept -> expect_code_t
+         { recorded(); return bench_errc::e; };
+
+    BENCHMARK( "{baseline}: expect<T> : {surely} return fail" )
+    { return expect_fail(); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : recorded" )
+    { return expect_recorded_fail(); };
+
+    BENCHMARK( "{baseline}: expect<T, E> : {surely} return fail : error code" )
+    { return expect_code_fail(); };
+
+    BENCHMARK( "expect<T, E> : {surely} return fail : error code : recorded" )
+    { return expect_code_recorded_fail(); };
+  }
+
+  SECTION( "snapshot" )
+  {
+    BENCHMARK( "error_counts() : snapshot" )
+    { return mry::error_counts().size(); };
+  }
+}
+
+} //< namespace
@@ -22,13 +22,60 @@
 
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <source_location>
+#include <string_view>
 #include <stdexcept>
 #include <iostream>
+#include <optional>
+#include <string>
 #include <variant>
 #include <vector>
+#include <memory>
+#include <cstddef>
+#include <array>
+
+namespace {
+
+enum class bench_errc
+{
+  e
+};
+
+} //< namespace
+
+template <>
+  struct mry::error_category< bench_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "bench" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "e" });
+};
 
 namespace {
 
+/**
+ * @brief located_t stands in for `mry::error_t` holding its call site
+ *        -- as built with `ErrorLocation=ON` -- comparing both in a
+ *        single build
+ */
+struct located_t
+{
+  mry::error_t         error;
+  std::source_location where;
+};
+
+/**
+ * @brief traced_t stands in for `mry::error_t` capturing its backtrace
+ *        -- as built with `ErrorBacktrace` set -- comparing both in a
+ *        single build
+ */
+struct traced_t
+{
+  mry::error_t   error;
+  mry::backtrace trace;
+};
+
 /**
  * @brief plain_success describes a pure operation runtime
  *        where no errors occure
@@ -88,8 +135,36 @@ TEST_CASE( "benchmark error_t", "[benchmark][error_t]" )
     BENCHMARK( "{baseline}: try-catch : {surely} throw" )
     { return surely_throw(); };
 
+    auto string_error =
+      []() noexcept -> mry::error_t
+        { return mry::error_t{ std::string{"e"} }; };
+    auto located_error =
+      []() noexcept -> located_t
+        { return { mry::error_t{"e"}, std::source_location::current() }; };
+    auto located_string_error =
+      []() noexcept -> located_t
+        { return { mry::error_t{ std::string{"e"} }, std::source_location::current() }; };
+    auto traced_error =
+      []() noexcept -> traced_t
+        { return { mry::error_t{"e"}, mry::backtrace::capture() }; };
+
     BENCHMARK( "error_t : return error" )
     { return error(); };
+
+    BENCHMARK( "error_t : return error : std::string" )
+    { return string_error(); };
+
+    BENCHMARK( "error_t : return error : located" )
+    { return located_error(); };
+
+    BENCHMARK( "error_t : return error : std::string : located" )
+    { return located_string_error(); };
+
+    BENCHMARK( "error_t : return error : backtrace" )
+    { return traced_error(); };
+
+    BENCHMARK( "error_t : return error : backtrace : symbolize" )
+    { return traced_error().trace.symbolize().size(); };
   }
 }
 
@@ -128,7 +203,7 @@ TEST_CASE( "benchmark expect<T>", "[benchmark][expect<T>]" )
     { return variant_success(); };
 
     BENCHMARK( "expect<T> : {surely} return success" )
-    { return variant_success(); };
+    { return expect_success(); };
   }
 
   SECTION( "fail" )
@@ -143,6 +218,12 @@ TEST_CASE( "benchmark expect<T>", "[benchmark][expect<T>]" )
     auto expect_fail =
       [&]() noexcept -> expect_t
          { return mry::error_t{"e"}; };
+    auto expect_code_fail =
+      [&]() noexcept -> expect_t
+         { return mry::error_t{ bench_errc::e }; };
+    auto expect_string_fail =
+      [&]() noexcept -> expect_t
+         { return mry::error_t{ std::string{"e"} }; };
 
     BENCHMARK( "{baseline}: try-catch : {surely} throw" )
     { return surely_throw(); };
@@ -152,11 +233,419 @@ TEST_CASE( "benchmark expect<T>", "[benchmark][expect<T>]" )
 
     BENCHMARK( "expect<T> : {surely} return fail" )
     { return expect_fail(); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : error code" )
+    { return expect_code_fail(); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : error code : read" )
+    { return expect_code_fail().fail().get().size(); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : std::string" )
+    { return expect_string_fail(); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : std::string : read" )
+    { return expect_string_fail().fail().get().size(); };
+  }
+
+  SECTION( "fail : message length" )
+  {
+    /* @note: `legacy_t` mirrors the former `std::optional<std::string>`
+     *        layout of `error_t` as a baseline for dynamic messages */
+    using legacy_t =
+      std::variant< success_t
+                  , std::optional<std::string> >;
+
+    /* @note: 15 characters is the SSO capacity of libstdc++ and libc++
+     *        {on 64-bit} strings -- the 16th one allocates */
+    static char constexpr sso[] =
+      "fifteen chars!!";
+    static char constexpr sso_exceeded[] =
+      "sixteen chars!!!";
+    static char constexpr long_message[] =
+      "a long, descriptive message well beyond any SSO capacity";
+
+    auto legacy_fail =
+      []( char const *m ) noexcept -> legacy_t
+        { return std::optional<std::string>{ m }; };
+    auto expect_literal_fail =
+      []( mry::internal::literal_string m ) noexcept -> expect_t
+        { return mry::error_t{ m }; };
+    auto expect_dynamic_fail =
+      []( char const *m ) noexcept -> expect_t
+        { return mry::error_t{ std::string{ m } }; };
+
+    BENCHMARK( "{baseline}: optional<string> : {surely} return fail : short" )
+    { return legacy_fail( "e" ); };
+
+    BENCHMARK( "{baseline}: optional<string> : {surely} return fail : SSO" )
+    { return legacy_fail( sso ); };
+
+    BENCHMARK( "{baseline}: optional<string> : {surely} return fail : SSO exceeded" )
+    { return legacy_fail( sso_exceeded ); };
+
+    BENCHMARK( "{baseline}: optional<string> : {surely} return fail : long" )
+    { return legacy_fail( long_message ); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : literal : short" )
+    { return expect_literal_fail( "e" ); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : literal : long" )
+    { return expect_literal_fail( long_message ); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : dynamic : short" )
+    { return expect_dynamic_fail( "e" ); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : dynamic : SSO" )
+    { return expect_dynamic_fail( sso ); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : dynamic : SSO exceeded" )
+    { return expect_dynamic_fail( sso_exceeded ); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : dynamic : long" )
+    { return expect_dynamic_fail( long_message ); };
+
+    std::cout << "optional<string> variant : " << sizeof(legacy_t) << " [B]\n"
+              << std::endl;
+  }
+
+  SECTION( "fail : deferred description" )
+  {
+    auto index =
+      std::size_t{1024};
+    auto bound =
+      std::size_t{512};
+
+    auto eager_fail =
+      [&]() noexcept -> expect_t
+        { return mry::error_t{ "index " + std::to_string( index )
+                             + " out of range [0, " + std::to_string( bound ) + ")" }; };
+    auto deferred_fail =
+      [&]() noexcept -> expect_t
+        { return mry::error_t{ "index {} out of range [0, {})", index, bound }; };
+
+    REQUIRE( eager_fail().fail().get() == deferred_fail().fail().get() );
+
+    BENCHMARK( "expect<T> : {surely} return fail : eager : discard" )
+    { return eager_fail(); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : deferred : discard" )
+    { return deferred_fail(); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : eager : read" )
+    { return eager_fail().fail().get().size(); };
+
+    BENCHMARK( "expect<T> : {surely} return fail : deferred : read" )
+    { return deferred_fail().fail().get().size(); };
   }
 
   std::cout << "std::variant : " << sizeof(variant_t) << " [B]\n"
             << "expect<T>    : " << sizeof(expect_t)  << " [B]\n"
+            << "error_t      : " << sizeof(mry::error_t) << " [B]\n"
             << std::endl;
 }
 
+TEST_CASE( "benchmark exception boundary", "[benchmark][expect<T>][exception]" )
+{
+  using success_t =
+    std::vector<int>;
+  using expect_t =
+    mry::expect<success_t>;
+  using code_expect_t =
+    mry::expect<success_t, bench_errc>;
+
+  /* @note: calling through function pointers keeps the raising code
+   *        opaque -- as third-party code would be */
+  auto success =
+    +[]() -> success_t
+       { return success_t{}; };
+  auto surely_throw =
+    +[]() -> success_t
+       { throw std::out_of_range{ "e" }; };
+
+  SECTION( "success" )
+  {
+    auto try_catch =
+      [&]() -> success_t
+        { try { return success(); }
+          catch( std::out_of_range const & ) { return success_t{}; } };
+    auto catch_into =
+      [&]() -> code_expect_t
+        { return mry::catch_into<success_t, bench_errc>( success
+                                                       , mry::catching<std::out_of_range>( bench_errc::e ) ); };
+    auto catch_into_many =
+      [&]() -> code_expect_t
+        { return mry::catch_into<success_t, bench_errc>( success
+                                                       , mry::catching<std::invalid_argument>( bench_errc::e )
+                                                       , mry::catching<std::length_error>( bench_errc::e )
+                                                       , mry::catching<std::out_of_range>( bench_errc::e ) ); };
+    auto value_or_throw =
+      []() -> success_t
+        { return expect_t{ success_t{} }.value_or_throw(); };
+
+    BENCHMARK( "{baseline}: {surely} return success" )
+    { return success(); };
+
+    BENCHMARK( "{baseline}: try-catch : {surely} return success" )
+    { return try_catch(); };
+
+    BENCHMARK( "expect<T> : catch_into : {surely} return success" )
+    { return catch_into(); };
+
+    BENCHMARK( "expect<T> : catch_into : {surely} return success : 3 mappings" )
+    { return catch_into_many(); };
+
+    BENCHMARK( "expect<T> : value_or_throw : {surely} return success" )
+    { return value_or_throw(); };
+  }
+
+  SECTION( "fail" )
+  {
+    auto try_catch =
+      [&]() -> success_t
+        { try { return surely_throw(); }
+          catch( std::out_of_range const & ) { return success_t{}; } };
+    auto catch_into =
+      [&]() -> code_expect_t
+        { return mry::catch_into<success_t, bench_errc>( surely_throw
+                                                       , mry::catching<std::out_of_range>( bench_errc::e ) ); };
+    auto catch_into_last =
+      [&]() -> code_expect_t
+        { return mry::catch_into<success_t, bench_errc>( surely_throw
+                                                       , mry::catching<std::invalid_argument>( bench_errc::e )
+                                                       , mry::catching<std::length_error>( bench_errc::e )
+                                                       , mry::catching<std::out_of_range>( bench_errc::e ) ); };
+    auto catch_into_what =
+      [&]() -> expect_t
+        { return mry::catch_into<success_t>( surely_throw ); };
+    auto value_or_throw =
+      []() -> success_t
+        { try { return expect_t{ mry::error_t{"e"} }.value_or_throw(); }
+          catch( mry::bad_expect_access<mry::error_t> const & ) { return success_t{}; } };
+    auto round_trip =
+      []() -> code_expect_t
+        { return mry::catch_into<success_t, bench_errc>(
+            []{ return code_expect_t{ bench_errc::e }.value_or_throw(); } ); };
+
+    BENCHMARK( "{baseline}: try-catch : {surely} throw" )
+    { return try_catch(); };
+
+    BENCHMARK( "expect<T> : catch_into : {surely} throw : error code" )
+    { return catch_into(); };
+
+    BENCHMARK( "expect<T> : catch_into : {surely} throw : error code : 3 mappings : last" )
+    { return catch_into_last(); };
+
+    BENCHMARK( "expect<T> : catch_into : {surely} throw : what()" )
+    { return catch_into_what(); };
+
+    BENCHMARK( "expect<T> : value_or_throw : {surely} throw : error_t" )
+    { return value_or_throw(); };
+
+    BENCHMARK( "expect<T> : value_or_throw : {surely} throw : error code : round trip" )
+    { return round_trip(); };
+  }
+}
+
+TEST_CASE( "benchmark expect<T> niche", "[benchmark][expect<T>][niche]" )
+{
+  using success_t =
+    int*;
+  using variant_t =
+    std::variant< success_t
+                , mry::error_t >;
+  using expect_t =
+    mry::expect<success_t>;
+
+  auto constexpr size =
+    std::size_t{ 1 << 20 };
+
+  auto value =
+    0;
+  auto variants =
+    std::vector<variant_t>( size, variant_t{ &value } );
+  auto expects =
+    std::vector<expect_t>( size, expect_t{ &value } );
+
+  for (auto i =std::size_t{0}; i < size; i += 16)
+  {
+    variants[i] =
+      mry::error_t{"e"};
+    expects[i] =
+      expect_t{ mry::error_t{"e"} };
+  }
+
+  BENCHMARK( "{baseline}: std::variant : scan for errors" )
+  {
+    auto errors =
+      std::size_t{0};
+
+    for (auto const &v : variants)
+      errors += v.index();
+
+    return errors;
+  };
+
+  BENCHMARK( "expect<T*> : scan for errors" )
+  {
+    auto errors =
+      std::size_t{0};
+
+    for (auto const &e : expects)
+      errors += e.holds_error();
+
+    return errors;
+  };
+
+  std::cout << "std::variant<T*> : " << sizeof(variant_t) << " [B]\n"
+            << "expect<T*>       : " << sizeof(expect_t)  << " [B]\n"
+            << std::endl;
+}
+
+TEST_CASE( "benchmark expect<T> relocation", "[benchmark][expect<T>][relocate]" )
+{
+  auto constexpr size =
+    std::size_t{ 10'000'000 };
+
+  SECTION( "push_back" )
+  {
+    using success_t =
+      std::string;
+    using variant_t =
+      std::variant< success_t
+                  , mry::error_t >;
+    using expect_t =
+      mry::expect<success_t>;
+
+    BENCHMARK( "{baseline}: std::variant : push_back 10M" )
+    {
+      auto results =
+        std::vector<variant_t>{};
+
+      for (auto i =std::size_t{0}; i < size; ++i)
+        results.push_back( i % 16 ? variant_t{ success_t{} }
+                                  : variant_t{ mry::error_t{"e"} } );
+
+      return results.size();
+    };
+
+    BENCHMARK( "expect<T> : push_back 10M" )
+    {
+      auto results =
+        std::vector<expect_t>{};
+
+      for (auto i =std::size_t{0}; i < size; ++i)
+        results.push_back( i % 16 ? expect_t{ success_t{} }
+                                  : expect_t{ mry::error_t{"e"} } );
+
+      return results.size();
+    };
+  }
+
+  SECTION( "reallocate : std::string" )
+  {
+    using success_t =
+      std::string;
+    using variant_t =
+      std::variant< success_t
+                  , mry::error_t >;
+    using expect_t =
+      mry::expect<success_t>;
+
+    auto variants =
+      std::vector<variant_t>{};
+    auto expects =
+      std::vector<expect_t>{};
+
+    for (auto i =std::size_t{0}; i < size; ++i)
+    {
+      variants.push_back( i % 16 ? variant_t{ success_t{} }
+                                 : variant_t{ mry::error_t{"e"} } );
+      expects.push_back( i % 16 ? expect_t{ success_t{} }
+                                : expect_t{ mry::error_t{"e"} } );
+    }
+
+    /* @note: growing and shrinking back reallocates twice -- moving each
+     *        element, std::string not being trivially relocatable -- and
+     *        keeps the vector intact across iterations */
+    auto reallocate =
+      []<typename T>( std::vector<T> &results )
+        {
+          results.reserve( 2 * results.capacity() );
+          results.shrink_to_fit();
+
+          return results.capacity();
+        };
+
+    BENCHMARK( "{baseline}: std::variant : reallocate 10M" )
+    { return reallocate( variants ); };
+
+    BENCHMARK( "expect<T> : reallocate 10M" )
+    { return reallocate( expects ); };
+  }
+
+  SECTION( "reallocate" )
+  {
+    using success_t =
+      std::unique_ptr<int>;
+    using variant_t =
+      std::variant< success_t
+                  , mry::error_t >;
+    using expect_t =
+      mry::expect<success_t>;
+
+    auto variants =
+      std::vector<variant_t>{};
+    auto expects =
+      std::vector<expect_t>{};
+
+    for (auto i =std::size_t{0}; i < size; ++i)
+    {
+      variants.emplace_back( mry::error_t{"e"} );
+      expects.emplace_back( mry::error_t{"e"} );
+    }
+
+    /* @note: `to` is never constructed, relocating into it and back
+     *        keeps the source vector intact across iterations */
+    auto to =
+      std::make_unique_for_overwrite< std::byte[] >( size * sizeof(expect_t) );
+    auto to_variants =
+      std::make_unique_for_overwrite< std::byte[] >( size * sizeof(variant_t) );
+
+    auto move_and_destroy =
+      []<typename T>( std::vector<T> &from, std::byte *storage )
+        {
+          auto first =
+            reinterpret_cast<T*>(storage);
+          auto last =
+            std::uninitialized_move( from.begin(), from.end(), first );
+
+          std::destroy( from.begin(), from.end() );
+          std::uninitialized_move( first, last, from.data() );
+          std::destroy( first, last );
+
+          return last - first;
+        };
+
+    BENCHMARK( "{baseline}: std::variant : move and destroy 10M" )
+    { return move_and_destroy( variants, to_variants.get() ); };
+
+    BENCHMARK( "expect<T> : move and destroy 10M" )
+    { return move_and_destroy( expects, to.get() ); };
+
+    BENCHMARK( "expect<T> : relocate 10M" )
+    {
+      auto first =
+        reinterpret_cast<expect_t*>( to.get() );
+      auto last =
+        mry::uninitialized_relocate( expects.data()
+                                   , expects.data() + expects.size()
+                                   , first );
+
+      mry::uninitialized_relocate( first, last, expects.data() );
+
+      return last - first;
+    };
+  }
+}
+
 } //< namespace
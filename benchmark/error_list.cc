@@ -0,0 +1,182 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/error_list.h"
+#include "mry/expect.h"
+#include "mry/error_t.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string_view>
+#include <iostream>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <array>
+
+namespace {
+
+/**
+ * @brief fields of the validated records, each failing with its own
+ *        error code
+ */
+auto constexpr fields =
+  std::size_t{8};
+
+enum class field_errc
+{
+  id, kind, owner, size, offset, flags, created, updated
+};
+
+} //< namespace
+
+template <>
+  struct mry::error_category< field_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "field" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "id out of range", "kind out of range"
+                                    , "owner out of range", "size out of range"
+                                    , "offset out of range", "flags out of range"
+                                    , "created out of range", "updated out of range" });
+};
+
+namespace {
+
+struct record
+{
+  std::array< std::uint32_t, fields > values;
+};
+
+auto constexpr limit =
+  std::uint32_t{ 1u << 20 };
+
+/**
+ * @brief records returns `size` records, the ith failing its first
+ *        `i % 9` fields -- 0 to 8 failing fields each
+ */
+auto records( std::size_t size )
+  -> std::vector<record>
+{
+  auto result =
+    std::vector<record>( size );
+
+  for (auto i =std::size_t{0}; i < size; ++i)
+    for (auto f =std::size_t{0}; f < fields; ++f)
+      result[i].values[f] =
+        f < i % ( fields + 1 ) ? limit + static_cast<std::uint32_t>(i)
+                               : static_cast<std::uint32_t>( i % limit );
+
+  return result;
+}
+
+/**
+ * @brief validate collects the error conditions of all the fields of
+ *        `r` failing into `Errors`
+ */
+template <typename Errors, typename ...Args>
+  auto validate( record const &r, Args &&...args )
+    -> mry::expect< record const*, Errors >
+{
+  auto errors =
+    Errors( std::forward<Args>(args)... );
+
+  for (auto f =std::size_t{0}; f < fields; ++f)
+    if (r.values[f] >= limit)
+      errors.push_back( mry::error_t{ static_cast<field_errc>(f) } );
+
+  if (! errors.empty())
+    return { std::move(errors) };
+
+  return { &r };
+}
+
+/**
+ * @brief validate_all validates each of `rs` returning the number of
+ *        error conditions met
+ */
+template <typename Errors, typename ...Args>
+  auto validate_all( std::vector<record> const &rs, Args &&...args )
+    -> std::size_t
+{
+  auto errors =
+    std::size_t{0};
+
+  for (auto const &r : rs)
+  {
+    auto result =
+      validate<Errors>( r, args... );
+
+    if (result.holds_error())
+      errors += result.fail().size();
+  }
+
+  return errors;
+}
+
+TEST_CASE( "benchmark error_list<E, N>", "[benchmark][error_list]" )
+{
+  auto constexpr size =
+    std::size_t{ 1'000'000 };
+
+  auto const rs =
+    records( size );
+  auto const expected =
+    validate_all< std::vector<mry::error_t> >( rs );
+
+  REQUIRE( expected == validate_all< mry::error_list<mry::error_t, 8> >( rs ) );
+  REQUIRE( expected == validate_all< mry::error_list<mry::error_t, 4> >( rs ) );
+
+  SECTION( "validate 1M records : 0-8 failing fields" )
+  {
+    BENCHMARK( "{baseline}: vector<error_t> : validate 1M" )
+    { return validate_all< std::vector<mry::error_t> >( rs ); };
+
+    BENCHMARK( "error_list<E, 8> : validate 1M" )
+    { return validate_all< mry::error_list<mry::error_t, 8> >( rs ); };
+
+    BENCHMARK( "error_list<E, 4> : validate 1M : spilled" )
+    { return validate_all< mry::error_list<mry::error_t, 4> >( rs ); };
+
+    BENCHMARK( "error_list<E, 4> : validate 1M : spilled : error_arena" )
+    {
+      auto arena =
+        mry::error_arena{};
+
+      return validate_all< mry::error_list<mry::error_t, 4> >( rs );
+    };
+
+    BENCHMARK( "error_list<E, 2> : validate 1M : spilled : error_pool" )
+    {
+      auto pool =
+        mry::error_pool{};
+
+      return validate_all< mry::error_list<mry::error_t, 2> >( rs );
+    };
+  }
+
+  std::cout << "expect<T*, vector<error_t>>    : " << sizeof(mry::expect< record const*, std::vector<mry::error_t> >) << " [B]\n"
+            << "expect<T*, error_list<E, 8>>   : " << sizeof(mry::expect< record const*, mry::error_list<mry::error_t, 8> >) << " [B]\n"
+            << "expect<T*, error_list<E, 4>>   : " << sizeof(mry::expect< record const*, mry::error_list<mry::error_t, 4> >) << " [B]\n"
+            << std::endl;
+}
+
+} //< namespace
@@ -0,0 +1,171 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string_view>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <array>
+
+namespace {
+
+enum class token_errc : std::uint8_t
+{
+  negative,
+  odd
+};
+
+/**
+ * @brief token_position describes the domain error : where the
+ *        token failed
+ */
+struct token_position
+{
+  std::uint32_t line;
+  std::uint32_t column;
+};
+
+} //< namespace
+
+template <>
+  struct mry::error_category< token_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "token" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "negative", "odd" });
+};
+
+namespace {
+
+using value_t =
+  std::int32_t;
+
+/**
+ * @brief check_* validate `v` -- failing by an error code or by the
+ *        position of `v` otherwise
+ */
+[[gnu::noinline]]
+  auto check_error( value_t v, std::uint32_t at ) noexcept
+    -> mry::expect< value_t >
+{
+  if (v < 0)
+    return mry::error_t{ token_errc::negative };
+
+  if (v % 64 == 1)
+    return mry::error_t{ "at {}", at };
+
+  return v;
+}
+
+[[gnu::noinline]]
+  auto check_errors( value_t v, std::uint32_t at ) noexcept
+    -> mry::expect< value_t, token_errc, token_position >
+{
+  if (v < 0)
+    return token_errc::negative;
+
+  if (v % 64 == 1)
+    return token_position{ 1, at };
+
+  return v;
+}
+
+TEST_CASE( "benchmark expect<T, Es...>", "[benchmark][expect<T>][errors]" )
+{
+  auto inputs =
+    std::vector<value_t>( 4096 );
+
+  for (auto i =std::size_t{0}; i < inputs.size(); ++i)
+    inputs[i] =
+      static_cast<value_t>( i * 7919 % 4096 ) - ( i % 32 == 0 ? 4096 : 0 );
+
+  BENCHMARK( "{baseline}: expect<T> : error_t" )
+  {
+    auto sum =
+      std::int64_t{0};
+
+    for (auto i =std::uint32_t{0}; i < inputs.size(); ++i)
+    {
+      auto checked =
+        check_error( inputs[i], i );
+
+      if (checked)
+        sum += checked.success();
+
+      else
+        sum -= checked.fail().is( token_errc::negative ) ? 1 : 2;
+    }
+
+    return sum;
+  };
+
+  BENCHMARK( "expect<T> : expect<T, E1, E2> : visit" )
+  {
+    auto sum =
+      std::int64_t{0};
+
+    for (auto i =std::uint32_t{0}; i < inputs.size(); ++i)
+    {
+      auto checked =
+        check_errors( inputs[i], i );
+
+      if (checked)
+        sum += checked.success();
+
+      else
+        sum -= checked.fail().visit( []( auto e ) { return std::is_same_v< decltype(e), token_errc > ? 1 : 2; } );
+    }
+
+    return sum;
+  };
+
+  BENCHMARK( "{baseline}: vector<expect<T>> : error_t" )
+  {
+    auto results =
+      std::vector< mry::expect< value_t > >{};
+
+    results.reserve( inputs.size() );
+
+    for (auto i =std::uint32_t{0}; i < inputs.size(); ++i)
+      results.push_back( check_error( inputs[i], i ) );
+
+    return results.size();
+  };
+
+  BENCHMARK( "expect<T> : vector<expect<T, E1, E2>>" )
+  {
+    auto results =
+      std::vector< mry::expect< value_t, token_errc, token_position > >{};
+
+    results.reserve( inputs.size() );
+
+    for (auto i =std::uint32_t{0}; i < inputs.size(); ++i)
+      results.push_back( check_errors( inputs[i], i ) );
+
+    return results.size();
+  };
+}
+
+} //< namespace
@@ -0,0 +1,164 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/executor.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief parameters of the benchmarked fan-out : `tasks` tasks, every
+ *        `failure_rate`th of which fails
+ */
+auto constexpr tasks =
+  std::size_t{1000};
+
+auto work( std::size_t i ) noexcept
+  -> std::uint64_t
+{
+  auto v =
+    std::uint64_t{ i + 1 };
+
+  for (auto round =0; round < 64; ++round)
+    v =
+      ( v ^ ( v >> 31 ) ) * 0x9e3779b97f4a7c15ull;
+
+  return v;
+}
+
+TEST_CASE( "benchmark executor", "[benchmark][expect<T>][executor]" )
+{
+  auto pool =
+    mry::executor{};
+
+  for (auto failure_rate : { std::size_t{100}, std::size_t{2} })
+  {
+    auto name =
+      std::string{ failure_rate == 100 ? "1%" : "50%" } + " failure rate";
+
+    auto fallible =
+      [failure_rate]( std::size_t i ) noexcept
+        -> mry::expect<std::uint64_t>
+      {
+        if (i % failure_rate == 0)
+          return mry::error_t{ "task failed" };
+
+        return work(i);
+      };
+
+    auto throwing =
+      [failure_rate]( std::size_t i )
+        -> std::uint64_t
+      {
+        if (i % failure_rate == 0)
+          throw std::runtime_error{ "task failed" };
+
+        return work(i);
+      };
+
+    BENCHMARK( "{baseline}: std::async : exceptions : " + name )
+    {
+      auto futures =
+        std::vector< std::future<std::uint64_t> >{};
+
+      futures.reserve( tasks );
+
+      for (auto i =std::size_t{0}; i < tasks; ++i)
+        futures.push_back( std::async( std::launch::async, throwing, i ) );
+
+      auto errors =
+        std::size_t{0};
+
+      for (auto &f : futures)
+        try { f.get(); }
+        catch (std::runtime_error const &) { ++errors; }
+
+      return errors;
+    };
+
+    BENCHMARK( "{baseline}: std::async : deferred : exceptions : " + name )
+    {
+      auto futures =
+        std::vector< std::future<std::uint64_t> >{};
+
+      futures.reserve( tasks );
+
+      for (auto i =std::size_t{0}; i < tasks; ++i)
+        futures.push_back( std::async( std::launch::deferred, throwing, i ) );
+
+      auto errors =
+        std::size_t{0};
+
+      for (auto &f : futures)
+        try { f.get(); }
+        catch (std::runtime_error const &) { ++errors; }
+
+      return errors;
+    };
+
+    BENCHMARK( "executor : expect<T> : " + name )
+    {
+      auto futures =
+        std::vector< mry::future<std::uint64_t> >{};
+
+      futures.reserve( tasks );
+
+      for (auto i =std::size_t{0}; i < tasks; ++i)
+        futures.push_back( pool.submit( [=]{ return fallible(i); } ) );
+
+      auto errors =
+        std::size_t{0};
+
+      for (auto &f : futures)
+        errors += f.get().holds_error();
+
+      return errors;
+    };
+
+    BENCHMARK( "executor : expect<T> : then : " + name )
+    {
+      auto futures =
+        std::vector< mry::future<std::uint64_t> >{};
+
+      futures.reserve( tasks );
+
+      for (auto i =std::size_t{0}; i < tasks; ++i)
+        futures.push_back( pool.submit( [=]{ return fallible(i); } )
+                               .then( []( std::uint64_t v ){ return v + 1; } ) );
+
+      auto errors =
+        std::size_t{0};
+
+      for (auto &f : futures)
+        errors += f.get().holds_error();
+
+      return errors;
+    };
+  }
+}
+
+} //< namespace
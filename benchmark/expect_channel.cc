@@ -0,0 +1,343 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect_channel.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string_view>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <vector>
+#include <queue>
+#include <mutex>
+#include <array>
+
+namespace {
+
+enum class stage_errc
+{
+  e
+};
+
+} //< namespace
+
+template <>
+  struct mry::error_category< stage_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "stage" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "e" });
+};
+
+namespace {
+
+using value_t =
+  std::int64_t;
+using expect_t =
+  mry::expect< value_t >;
+
+/**
+ * @brief parameters of the benchmarked stages : each producer passes
+ *        `values` values, every 100th failing, in batches of `batch`
+ */
+auto constexpr values =
+  std::int64_t{200'000};
+auto constexpr batch =
+  std::size_t{32};
+auto constexpr round_trips =
+  std::int64_t{10'000};
+
+auto produce( value_t i ) noexcept
+  -> expect_t
+{
+  if (i % 100 == 99)
+    return mry::error_t{ stage_errc::e };
+
+  return i;
+}
+
+/**
+ * @brief mutex_queue is the baseline -- a mutex protected `std::queue`
+ */
+class mutex_queue final
+{
+  public :
+    explicit
+      mutex_queue( std::size_t capacity )
+        : capacity_{ capacity }
+    {}
+
+    auto push_n( expect_t *first, std::size_t n )
+      -> std::size_t
+    {
+      auto lock =
+        std::scoped_lock{ mutex_ };
+      auto pushed =
+        std::min( n, capacity_ - queue_.size() );
+
+      for (auto i =std::size_t{0}; i < pushed; ++i)
+        queue_.push( std::move( first[i] ) );
+
+      return pushed;
+    }
+
+    template <typename It>
+      auto pop_n( It out, std::size_t n )
+        -> std::size_t
+    {
+      auto lock =
+        std::scoped_lock{ mutex_ };
+      auto popped =
+        std::min( n, queue_.size() );
+
+      for (auto i =std::size_t{0}; i < popped; ++i)
+      {
+        *out++ = std::move( queue_.front() );
+        queue_.pop();
+      }
+
+      return popped;
+    }
+
+  private :
+    std::size_t          capacity_;
+    std::mutex           mutex_;
+    std::queue<expect_t> queue_;
+};
+
+/**
+ * @brief pass passes `values` values per producer through `channel` in
+ *        batches of `n`, returning the number of errors received
+ */
+template <typename Channel>
+  auto pass( Channel &channel, std::size_t producers, std::size_t consumers, std::size_t n )
+    -> std::int64_t
+{
+  auto received =
+    std::atomic<std::int64_t>{0};
+  auto errors =
+    std::atomic<std::int64_t>{0};
+  auto threads =
+    std::vector<std::jthread>{};
+
+  for (auto p =std::size_t{0}; p < producers; ++p)
+    threads.emplace_back( [&]
+    {
+      auto buffer =
+        std::vector<expect_t>( n, expect_t{ 0 } );
+
+      for (auto i =std::int64_t{0}; i < values;)
+      {
+        auto size =
+          std::min<std::size_t>( n, values - i );
+
+        for (auto k =std::size_t{0}; k < size; ++k)
+          buffer[k] = produce( i + k );
+
+        for (auto pushed =std::size_t{0}; pushed < size;)
+          if (auto p =channel.push_n( buffer.data() + pushed, size - pushed ))
+            pushed += p;
+
+          else
+            std::this_thread::yield();
+
+        i += size;
+      }
+    } );
+
+  for (auto c =std::size_t{0}; c < consumers; ++c)
+    threads.emplace_back( [&]
+    {
+      auto buffer =
+        std::vector<expect_t>{};
+
+      buffer.reserve( n );
+
+      while (received.load( std::memory_order_relaxed ) < values * std::int64_t( producers ))
+      {
+        buffer.clear();
+
+        auto popped =
+          channel.pop_n( std::back_inserter(buffer), n );
+
+        if (popped == 0)
+          std::this_thread::yield();
+
+        for (auto const &v : buffer)
+          errors.fetch_add( v.holds_error(), std::memory_order_relaxed );
+
+        received += popped;
+      }
+    } );
+
+  threads.clear();
+
+  return errors.load();
+}
+
+/**
+ * @brief ping_pong passes a value back and forth `round_trips` times
+ */
+template <typename Channel>
+  auto ping_pong( Channel &ping, Channel &pong )
+    -> std::int64_t
+{
+  auto echo =
+    std::jthread{ [&]
+    {
+      auto v =
+        std::vector<expect_t>{};
+
+      for (auto i =std::int64_t{0}; i < round_trips; ++i)
+      {
+        v.clear();
+
+        while (ping.pop_n( std::back_inserter(v), 1 ) == 0)
+          std::this_thread::yield();
+
+        while (pong.push_n( v.data(), 1 ) == 0)
+          std::this_thread::yield();
+      }
+    } };
+
+  auto v =
+    std::vector<expect_t>{};
+  auto sum =
+    std::int64_t{0};
+
+  for (auto i =std::int64_t{0}; i < round_trips; ++i)
+  {
+    auto value =
+      produce( i );
+
+    while (ping.push_n( &value, 1 ) == 0)
+      std::this_thread::yield();
+
+    v.clear();
+
+    while (pong.pop_n( std::back_inserter(v), 1 ) == 0)
+      std::this_thread::yield();
+
+    sum += v.front().holds_error();
+  }
+
+  return sum;
+}
+
+TEST_CASE( "benchmark expect_channel", "[benchmark][expect<T>][channel]" )
+{
+  using spsc_t =
+    mry::expect_channel< value_t, mry::error_t, mry::spsc >;
+  using mpmc_t =
+    mry::expect_channel< value_t, mry::error_t, mry::mpmc >;
+
+  auto constexpr capacity =
+    std::size_t{1024};
+
+  SECTION( "throughput" )
+  {
+    for (auto n : { std::size_t{1}, batch })
+    {
+      auto name =
+        n == 1 ? std::string{ " : single" } : std::string{ " : batched" };
+
+      BENCHMARK( "{baseline}: mutex queue : 1:1" + name )
+      {
+        auto channel =
+          mutex_queue{ capacity };
+
+        return pass( channel, 1, 1, n );
+      };
+
+      BENCHMARK( "expect_channel<T> : spsc : 1:1" + name )
+      {
+        auto channel =
+          spsc_t{ capacity };
+
+        return pass( channel, 1, 1, n );
+      };
+
+      BENCHMARK( "expect_channel<T> : mpmc : 1:1" + name )
+      {
+        auto channel =
+          mpmc_t{ capacity };
+
+        return pass( channel, 1, 1, n );
+      };
+
+      BENCHMARK( "{baseline}: mutex queue : 4:4" + name )
+      {
+        auto channel =
+          mutex_queue{ capacity };
+
+        return pass( channel, 4, 4, n );
+      };
+
+      BENCHMARK( "expect_channel<T> : mpmc : 4:4" + name )
+      {
+        auto channel =
+          mpmc_t{ capacity };
+
+        return pass( channel, 4, 4, n );
+      };
+    }
+  }
+
+  SECTION( "latency : round trip" )
+  {
+    BENCHMARK( "{baseline}: mutex queue : ping-pong" )
+    {
+      auto ping =
+        mutex_queue{ capacity };
+      auto pong =
+        mutex_queue{ capacity };
+
+      return ping_pong( ping, pong );
+    };
+
+    BENCHMARK( "expect_channel<T> : spsc : ping-pong" )
+    {
+      auto ping =
+        spsc_t{ capacity };
+      auto pong =
+        spsc_t{ capacity };
+
+      return ping_pong( ping, pong );
+    };
+
+    BENCHMARK( "expect_channel<T> : mpmc : ping-pong" )
+    {
+      auto ping =
+        mpmc_t{ capacity };
+      auto pong =
+        mpmc_t{ capacity };
+
+      return ping_pong( ping, pong );
+    };
+  }
+}
+
+} //< namespace
@@ -0,0 +1,171 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect_vector.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string_view>
+#include <functional>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <array>
+
+namespace {
+
+enum class batch_errc
+{
+  e
+};
+
+} //< namespace
+
+template <>
+  struct mry::error_category< batch_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "batch" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "e" });
+};
+
+namespace {
+
+using value_t =
+  std::int32_t;
+using expect_t =
+  mry::expect< value_t >;
+
+/**
+ * @brief parameters of the benchmarked batches : every `error_rate`th
+ *        element fails -- `partitioned` bounding the batches copied
+ *        per partition sample
+ */
+auto constexpr elements =
+  std::size_t{100'000'000};
+auto constexpr partitioned =
+  std::size_t{10'000'000};
+auto constexpr error_rate =
+  std::size_t{64};
+
+auto element( std::size_t i ) noexcept
+  -> expect_t
+{
+  if (i % error_rate == error_rate / 2)
+    return mry::error_t{ batch_errc::e };
+
+  return static_cast<value_t>( i );
+}
+
+template <typename Batch>
+  auto fill( Batch &batch, std::size_t n )
+    -> Batch&
+{
+  batch.reserve( n );
+
+  for (auto i =std::size_t{0}; i < n; ++i)
+    batch.push_back( element(i) );
+
+  return batch;
+}
+
+TEST_CASE( "benchmark expect_vector<T>", "[benchmark][expect_vector<T>]" )
+{
+  SECTION( "scan : 100M" )
+  {
+    auto aos =
+      std::vector<expect_t>{};
+    auto soa =
+      mry::expect_vector<value_t>{};
+
+    fill( aos, elements );
+    fill( soa, elements );
+
+    REQUIRE( soa.count_errors()
+          == std::size_t( std::ranges::count_if( aos, &expect_t::holds_error ) ) );
+
+    BENCHMARK( "{baseline}: vector<expect<T>> : count errors" )
+    { return std::ranges::count_if( aos, &expect_t::holds_error ); };
+
+    BENCHMARK( "expect_vector<T> : count errors" )
+    { return soa.count_errors(); };
+
+    BENCHMARK( "{baseline}: vector<expect<T>> : first error" )
+    { return std::ranges::find_if( aos, &expect_t::holds_error ) - aos.begin(); };
+
+    BENCHMARK( "expect_vector<T> : first error" )
+    { return soa.first_error(); };
+
+    BENCHMARK( "{baseline}: vector<expect<T>> : sum successes" )
+    {
+      auto sum =
+        std::int64_t{0};
+
+      for (auto const &e : aos)
+        if (!e.holds_error())
+          sum += e.success();
+
+      return sum;
+    };
+
+    BENCHMARK( "expect_vector<T> : sum successes" )
+    {
+      auto sum =
+        std::int64_t{0};
+
+      for (auto s : soa.successes())
+        sum += s;
+
+      return sum;
+    };
+  }
+
+  SECTION( "partition : 10M" )
+  {
+    auto aos =
+      std::vector<expect_t>{};
+    auto soa =
+      mry::expect_vector<value_t>{};
+
+    fill( aos, partitioned );
+    fill( soa, partitioned );
+
+    BENCHMARK_ADVANCED( "{baseline}: vector<expect<T>> : stable partition" )( auto meter )
+    {
+      auto batch =
+        aos;
+
+      meter.measure( [&]
+                     { return std::ranges::stable_partition( batch, std::not_fn( &expect_t::holds_error ) )
+                              .begin() - batch.begin(); } );
+    };
+
+    BENCHMARK_ADVANCED( "expect_vector<T> : partition" )( auto meter )
+    {
+      auto batch =
+        soa;
+
+      meter.measure( [&]{ return batch.partition(); } );
+    };
+  }
+}
+
+} //< namespace
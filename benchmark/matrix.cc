@@ -0,0 +1,294 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string_view>
+#include <type_traits>
+#include <exception>
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include <version>
+#include <string>
+#include <vector>
+#include <array>
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202202L
+#  include <expected>
+#  define MRY_BENCHMARK_STD_EXPECTED 1
+#endif
+
+/**
+ * @file matrix.cc sweeps the error handling mechanisms across failure
+ *       rates, propagation depths and payload sizes
+ *
+ * the benchmarks are hidden, named by `key=value` pairs for their results
+ * to be machine-readable -- eg. run by
+ *
+ * ```sh
+ * $ ./benchmarks "[matrix]" --reporter xml::out=matrix.xml
+ * ```
+ */
+namespace {
+
+/**
+ * @brief payload describes a result type of `N` bytes
+ */
+template <std::size_t N>
+  struct payload
+{
+  std::array<std::byte, N> bytes;
+};
+
+template <typename P>
+  auto make( std::size_t seed ) noexcept
+    -> P
+{
+  if constexpr (std::is_arithmetic_v<P>)
+    return static_cast<P>( seed );
+
+  else
+  {
+    auto p =
+      P{};
+
+    p.bytes.front() = static_cast<std::byte>( seed );
+
+    return p;
+  }
+}
+
+template <typename P>
+  auto touch( P const &p ) noexcept
+    -> std::size_t
+{
+  if constexpr (std::is_arithmetic_v<P>)
+    return static_cast<std::size_t>( p );
+
+  else
+    return static_cast<std::size_t>( p.bytes.front() );
+}
+
+/**
+ * @brief leaf_error is raised by the exception based mechanism -- not
+ *        allocating any description for a fair comparison
+ */
+struct leaf_error
+  : std::exception
+{};
+
+/**
+ * @brief *_depth propagate the result of the leaf `depth` frames deep,
+ *        failing when `fail`
+ */
+template <typename P>
+  auto throw_depth( int depth, bool fail )
+    -> P
+{
+  if (depth == 0)
+  {
+    if (fail)
+      throw leaf_error{};
+
+    return make<P>( depth );
+  }
+
+  return throw_depth<P>( depth - 1, fail );
+}
+
+template <typename P>
+  auto variant_depth( int depth, bool fail ) noexcept
+    -> std::variant< P, mry::error_t >
+{
+  if (depth == 0)
+  {
+    if (fail)
+      return mry::error_t{"e"};
+
+    return make<P>( depth );
+  }
+
+  auto r =
+    variant_depth<P>( depth - 1, fail );
+
+  if (r.index() == 1)
+    return std::move( std::get<1>(r) );
+
+  return std::move( std::get<0>(r) );
+}
+
+#if defined(MRY_BENCHMARK_STD_EXPECTED)
+template <typename P>
+  auto expected_depth( int depth, bool fail ) noexcept
+    -> std::expected< P, mry::error_t >
+{
+  if (depth == 0)
+  {
+    if (fail)
+      return std::unexpected{ mry::error_t{"e"} };
+
+    return make<P>( depth );
+  }
+
+  auto r =
+    expected_depth<P>( depth - 1, fail );
+
+  if (!r)
+    return std::unexpected{ std::move( r.error() ) };
+
+  return std::move( *r );
+}
+#endif
+
+template <typename P>
+  auto expect_depth( int depth, bool fail ) noexcept
+    -> mry::expect< P >
+{
+  if (depth == 0)
+  {
+    if (fail)
+      return mry::error_t{"e"};
+
+    return make<P>( depth );
+  }
+
+  auto r =
+    expect_depth<P>( depth - 1, fail );
+
+  if (r.holds_error())
+    return std::move( r.fail() );
+
+  return std::move( r.success() );
+}
+
+/**
+ * @brief failures returns a pattern of failures at the rate of `ppm`
+ *        parts per million -- spread by an LCG
+ */
+auto failures( std::uint32_t ppm )
+  -> std::vector<char>
+{
+  auto pattern =
+    std::vector<char>( std::size_t{1} << 16 );
+  auto state =
+    std::uint64_t{ 0x2545f4914f6cdd1dull };
+
+  for (auto &fail : pattern)
+  {
+    state =
+      state * 6364136223846793005ull + 1442695040888963407ull;
+    fail =
+      ( state >> 33 ) % 1'000'000 < ppm;
+  }
+
+  return pattern;
+}
+
+/**
+ * @brief sweep registers the benchmarks of result type P across the
+ *        failure rates and depths of the matrix
+ */
+template <typename P>
+  auto sweep( std::string_view payload_name )
+    -> void
+{
+  struct rate
+  {
+    std::uint32_t    ppm;
+    std::string_view name;
+  };
+
+  static auto constexpr rates =
+    std::to_array<rate>({ {       0, "0%"    }
+                        , {     100, "0.01%" }
+                        , {  10'000, "1%"    }
+                        , { 100'000, "10%"   }
+                        , { 500'000, "50%"   } });
+
+  /* @note: reading depths from a volatile keeps them opaque
+   *        to the optimizer */
+  static int volatile depths[] =
+    { 1, 4, 16, 64 };
+
+  for (auto const &r : rates)
+  {
+    auto const pattern =
+      failures( r.ppm );
+    auto const mask =
+      pattern.size() - 1;
+
+    for (int depth : depths)
+    {
+      auto const key =
+        " : failure=" + std::string{ r.name }
+      + " : depth="   + std::to_string( depth )
+      + " : payload=" + std::string{ payload_name };
+
+      auto i =
+        std::size_t{0};
+
+      BENCHMARK( "mechanism=exceptions" + key )
+      {
+        auto fail =
+          pattern[ i++ & mask ];
+
+        try { return touch( throw_depth<P>( depth, fail ) ); }
+        catch( leaf_error const & ) { return std::size_t{0}; }
+      };
+
+      BENCHMARK( "mechanism=std::variant" + key )
+      {
+        auto r =
+          variant_depth<P>( depth, pattern[ i++ & mask ] );
+
+        return r.index() == 0 ? touch( std::get<0>(r) ) : 0;
+      };
+
+#if defined(MRY_BENCHMARK_STD_EXPECTED)
+      BENCHMARK( "mechanism=std::expected" + key )
+      {
+        auto r =
+          expected_depth<P>( depth, pattern[ i++ & mask ] );
+
+        return r ? touch( *r ) : 0;
+      };
+#endif
+
+      BENCHMARK( "mechanism=expect<T>" + key )
+      {
+        auto r =
+          expect_depth<P>( depth, pattern[ i++ & mask ] );
+
+        return r.holds_error() ? 0 : touch( r.success() );
+      };
+    }
+  }
+}
+
+TEST_CASE( "benchmark error handling matrix", "[.][benchmark][matrix]" )
+{
+  sweep< int >( "4B" );
+  sweep< payload<64> >( "64B" );
+  sweep< payload<4096> >( "4KiB" );
+}
+
+} //< namespace
@@ -0,0 +1,151 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/parallel.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string_view>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+#include <array>
+
+namespace {
+
+enum class validate_errc
+{
+  rejected
+};
+
+} //< namespace
+
+template <>
+  struct mry::error_category< validate_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "validate" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "rejected" });
+};
+
+namespace {
+
+using value_t =
+  std::uint64_t;
+using expect_t =
+  mry::expect< value_t, validate_errc >;
+
+/**
+ * @brief parameters of the benchmarked batches, the rejected sentinel
+ *        placed at the positions of the first failure benchmarked
+ *
+ * @note: the small batch exposes the cost of handing out the work to
+ *        threads, paid per call
+ */
+auto constexpr batch_sizes =
+  std::to_array<std::size_t>({ 4'000'000, 16'384 });
+auto constexpr rejected =
+  value_t{0};
+
+/**
+ * @brief validate converts `v` by a few rounds of mixing -- rejecting
+ *        the sentinel
+ */
+auto validate( value_t v ) noexcept
+  -> expect_t
+{
+  if (v == rejected)
+    return validate_errc::rejected;
+
+  for (auto round =0; round < 16; ++round)
+    v =
+      ( v ^ ( v >> 31 ) ) * 0x9e3779b97f4a7c15ull;
+
+  return v;
+}
+
+TEST_CASE( "benchmark parallel algorithms", "[benchmark][expect<T>][parallel]" )
+{
+  auto threads =
+    std::vector<std::size_t>{ 1 };
+
+  for (auto t =std::size_t{2}; t <= std::thread::hardware_concurrency(); t *= 2)
+    threads.push_back( t );
+
+  for (auto elements : batch_sizes)
+  {
+    /* @note: positions of the first failure in percents of the batch,
+     *        100 denoting none */
+    for (auto failure : { 100, 50, 10, 1 })
+    {
+      auto batch =
+        std::vector<value_t>( elements );
+
+      std::iota( batch.begin(), batch.end(), value_t{1} );
+
+      if (failure < 100)
+        batch[ elements * failure / 100 ] = rejected;
+
+      for (auto t : threads)
+      {
+        auto name =
+          std::to_string(elements) + " elements : "
+        + std::to_string(t) + " threads : first failure at "
+        + ( failure < 100 ? std::to_string(failure) + "%" : std::string{"none"} );
+        auto policy =
+          mry::parallel_policy{ .threads = t };
+
+        BENCHMARK( "{baseline}: sequential collect : " + name )
+        {
+          auto collected =
+            std::vector<value_t>{};
+
+          for (auto v : batch)
+          {
+            auto validated =
+              validate( v );
+
+            if (validated.holds_error())
+              return collected.size();
+
+            collected.push_back( validated.success() );
+          }
+
+          return collected.size();
+        };
+
+        BENCHMARK( "expect<T> : parallel_collect : " + name )
+        { return mry::parallel_collect( batch, validate, policy ).holds_error(); };
+
+        BENCHMARK( "expect<T> : parallel_transform_reduce : " + name )
+        {
+          return mry::parallel_transform_reduce( batch, value_t{0}, std::plus<>{}, validate, policy )
+                   .holds_error();
+        };
+      }
+    }
+  }
+}
+
+} //< namespace
@@ -0,0 +1,370 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/parse.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <system_error>
+#include <string_view>
+#include <filesystem>
+#include <stdexcept>
+#include <iostream>
+#include <type_traits>
+#include <charconv>
+#include <fstream>
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <string>
+#include <random>
+
+/**
+ * @file parse.cc measures the throughput of parsing numeric text -- by
+ *       `mry::parse`, `std::from_chars` and exception based `std::stoi`
+ *
+ * besides the timings of the benchmarks, throughputs are reported in
+ * [GB/s] of text parsed, the best of a few runs each. the instruction
+ * set is chosen by the `ParseISA` CMake option.
+ */
+namespace {
+
+auto constexpr text_size =
+  std::size_t{ 8 << 20 };
+
+/**
+ * @brief integers returns `text_size` bytes of newline separated
+ *        integers of 1 to 10 digits, every `invalid_rate`th token
+ *        being invalid -- none given 0
+ */
+auto integers( std::size_t invalid_rate )
+  -> std::string
+{
+  auto random =
+    std::mt19937_64{ 42 };
+  auto text =
+    std::string{};
+
+  text.reserve( text_size + 32 );
+
+  for (auto i =std::size_t{1}; text.size() < text_size; ++i)
+  {
+    auto digits =
+      random() % 10 + 1;
+    auto value =
+      static_cast<std::int64_t>( random() % 2147483647 );
+
+    for (auto d =digits; d < 10; ++d)
+      value /= 10;
+
+    if (invalid_rate && i % invalid_rate == 0)
+      text += "x";
+
+    text += std::to_string( i % 4 ? value : -value );
+    text += '\n';
+  }
+
+  return text;
+}
+
+/**
+ * @brief floats returns `text_size` bytes of newline separated decimal
+ *        floating point numbers
+ */
+auto floats()
+  -> std::string
+{
+  auto random =
+    std::mt19937_64{ 42 };
+  auto text =
+    std::string{};
+
+  text.reserve( text_size + 32 );
+
+  while (text.size() < text_size)
+  {
+    text += std::to_string( random() % 100000 );
+    text += '.';
+    text += std::to_string( random() % 1000000 );
+
+    if (random() % 4 == 0)
+      text += "e-" + std::to_string( random() % 20 );
+
+    text += '\n';
+  }
+
+  return text;
+}
+
+/**
+ * @brief for_each_token invokes `f` with each token of `text` -- found
+ *        char by char, as the baselines would
+ */
+template <typename F>
+  auto for_each_token( std::string_view text, F &&f )
+    -> void
+{
+  auto at =
+    text.data();
+  auto last =
+    at + text.size();
+
+  while (at != last)
+  {
+    while (at != last && mry::internal::is_separator( *at ))
+      ++at;
+
+    auto first =
+      at;
+
+    while (at != last && ! mry::internal::is_separator( *at ))
+      ++at;
+
+    if (first != at)
+      f( first, at );
+  }
+}
+
+/**
+ * @brief sum_t denotes the type the parsed Ts are summed by
+ */
+template <typename T>
+  using sum_t =
+    std::conditional_t< std::is_integral_v<T>, std::int64_t, T >;
+
+/**
+ * @brief by_stoi sums the integers of `text` parsed by `std::stoi`,
+ *        counting invalid ones by the exceptions raised
+ */
+auto by_stoi( std::string_view text )
+  -> std::int64_t
+{
+  auto sum =
+    std::int64_t{0};
+
+  for_each_token( text, [&]( char const *first, char const *last )
+    {
+      try { sum += std::stoi( std::string{ first, last } ); }
+      catch( std::invalid_argument const & ) { --sum; }
+      catch( std::out_of_range const & ) { --sum; }
+    } );
+
+  return sum;
+}
+
+template <typename T>
+  auto by_from_chars( std::string_view text )
+    -> sum_t<T>
+{
+  auto sum =
+    sum_t<T>{0};
+
+  for_each_token( text, [&]( char const *first, char const *last )
+    {
+      auto value =
+        T{};
+      auto [end, error] =
+        std::from_chars( first, last, value );
+
+      sum += error == std::errc{} && end == last ? value : -1;
+    } );
+
+  return sum;
+}
+
+template <typename T>
+  auto by_parse( std::string_view text )
+    -> sum_t<T>
+{
+  auto sum =
+    sum_t<T>{0};
+
+  for_each_token( text, [&]( char const *first, char const *last )
+    {
+      auto parsed =
+        mry::parse<T>( { first, static_cast<std::size_t>( last - first ) } );
+
+      sum += parsed ? parsed.success() : -1;
+    } );
+
+  return sum;
+}
+
+template <typename T>
+  auto by_parse_many( std::string_view text, mry::expect_vector<T, mry::parse_errc> &out )
+    -> sum_t<T>
+{
+  out.clear();
+  mry::parse_many<T>( text, out );
+
+  auto sum =
+    sum_t<T>{0};
+
+  for (auto i =std::size_t{0}; i < out.size(); ++i)
+    sum += out.holds_error(i) ? -1 : out.success(i);
+
+  return sum;
+}
+
+/**
+ * @brief report_throughput reports the throughput of `f` parsing `bytes`
+ *        -- the best of 5 runs
+ */
+template <typename F>
+  auto report_throughput( std::string_view name, std::size_t bytes, F &&f )
+    -> void
+{
+  auto best =
+    std::chrono::nanoseconds::max();
+  auto volatile sink =
+    0.0;
+
+  for (auto run =0; run < 5; ++run)
+  {
+    auto start =
+      std::chrono::steady_clock::now();
+
+    sink = sink + static_cast<double>( f() );
+
+    best = std::min( best, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start ) );
+  }
+
+  std::cout << name << " : "
+            << static_cast<double>(bytes) / static_cast<double>( best.count() ) << " [GB/s]\n";
+}
+
+TEST_CASE( "benchmark parse", "[benchmark][parse]" )
+{
+  SECTION( "integers" )
+  {
+    auto const valid =
+      integers(0);
+    auto const invalid =
+      integers(64);
+    auto out =
+      mry::expect_vector<int, mry::parse_errc>{};
+
+    REQUIRE( by_stoi( valid ) == by_from_chars<int>( valid ) );
+    REQUIRE( by_stoi( valid ) == by_parse<int>( valid ) );
+    REQUIRE( by_stoi( valid ) == by_parse_many<int>( valid, out ) );
+    REQUIRE( by_from_chars<int>( invalid ) == by_parse_many<int>( invalid, out ) );
+
+    BENCHMARK( "{baseline}: std::stoi : 8MB" )
+    { return by_stoi( valid ); };
+
+    BENCHMARK( "{baseline}: std::stoi : 8MB : 1/64 invalid" )
+    { return by_stoi( invalid ); };
+
+    BENCHMARK( "{baseline}: std::from_chars : 8MB" )
+    { return by_from_chars<int>( valid ); };
+
+    BENCHMARK( "{baseline}: std::from_chars : 8MB : 1/64 invalid" )
+    { return by_from_chars<int>( invalid ); };
+
+    BENCHMARK( "mry::parse<int> : 8MB" )
+    { return by_parse<int>( valid ); };
+
+    BENCHMARK( "mry::parse_many<int> : 8MB" )
+    { return by_parse_many<int>( valid, out ); };
+
+    BENCHMARK( "mry::parse_many<int> : 8MB : 1/64 invalid" )
+    { return by_parse_many<int>( invalid, out ); };
+
+    std::cout << '\n';
+    report_throughput( "std::stoi                      ", valid.size(), [&]{ return by_stoi( valid ); } );
+    report_throughput( "std::stoi            : invalid ", invalid.size(), [&]{ return by_stoi( invalid ); } );
+    report_throughput( "std::from_chars                ", valid.size(), [&]{ return by_from_chars<int>( valid ); } );
+    report_throughput( "std::from_chars      : invalid ", invalid.size(), [&]{ return by_from_chars<int>( invalid ); } );
+    report_throughput( "mry::parse<int>                ", valid.size(), [&]{ return by_parse<int>( valid ); } );
+    report_throughput( "mry::parse_many<int>           ", valid.size(), [&]{ return by_parse_many<int>( valid, out ); } );
+    report_throughput( "mry::parse_many<int> : invalid ", invalid.size(), [&]{ return by_parse_many<int>( invalid, out ); } );
+    std::cout << std::endl;
+  }
+
+  SECTION( "floating point numbers" )
+  {
+    auto const text =
+      floats();
+    auto out =
+      mry::expect_vector<double, mry::parse_errc>{};
+
+    auto by_stod =
+      [&]
+        {
+          auto sum =
+            0.0;
+
+          for_each_token( text, [&]( char const *first, char const *last )
+            { sum += std::stod( std::string{ first, last } ); } );
+
+          return sum;
+        };
+
+    REQUIRE( by_from_chars<double>( text ) == by_parse_many<double>( text, out ) );
+
+    BENCHMARK( "{baseline}: std::stod : 8MB" )
+    { return by_stod(); };
+
+    BENCHMARK( "{baseline}: std::from_chars<double> : 8MB" )
+    { return by_from_chars<double>( text ); };
+
+    BENCHMARK( "mry::parse<double> : 8MB" )
+    { return by_parse<double>( text ); };
+
+    BENCHMARK( "mry::parse_many<double> : 8MB" )
+    { return by_parse_many<double>( text, out ); };
+
+    std::cout << '\n';
+    report_throughput( "std::stod                      ", text.size(), by_stod );
+    report_throughput( "std::from_chars<double>        ", text.size(), [&]{ return by_from_chars<double>( text ); } );
+    report_throughput( "mry::parse<double>             ", text.size(), [&]{ return by_parse<double>( text ); } );
+    report_throughput( "mry::parse_many<double>        ", text.size(), [&]{ return by_parse_many<double>( text, out ); } );
+    std::cout << std::endl;
+  }
+
+  SECTION( "memory-mapped file" )
+  {
+    auto path =
+      ( std::filesystem::temp_directory_path() / "mry_benchmark_parse.txt" ).string();
+
+    std::ofstream{ path } << integers(0);
+
+    auto file =
+      mry::mapped_file::open( path );
+
+    REQUIRE( ! file.holds_error() );
+
+    auto text =
+      file.success().text();
+    auto out =
+      mry::expect_vector<int, mry::parse_errc>{};
+
+    BENCHMARK( "mry::parse_many<int> : 8MB : mapped" )
+    { return by_parse_many<int>( text, out ); };
+
+    std::cout << '\n';
+    report_throughput( "mry::parse_many<int> : mapped  ", text.size(), [&]{ return by_parse_many<int>( text, out ); } );
+    std::cout << std::endl;
+
+    std::filesystem::remove( path );
+  }
+}
+
+} //< namespace
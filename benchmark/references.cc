@@ -0,0 +1,187 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <array>
+
+namespace {
+
+/**
+ * @brief record describes a looked up entry too large to be copied
+ *        for free
+ */
+struct record
+{
+  std::int64_t                 key;
+  std::array<std::int64_t, 15> fields;
+};
+
+auto constexpr table_size =
+  std::size_t{ 1024 };
+
+/**
+ * @brief lookup_* find the `record` of `key` -- failing for keys
+ *        not present
+ */
+[[gnu::noinline]]
+  auto lookup_copy( std::vector<record> const &table, std::int64_t key )
+    -> mry::expect< record >
+{
+  if (key < 0 || key >= static_cast<std::int64_t>( table.size() ))
+    return mry::error_t{"not found"};
+
+  return table[ static_cast<std::size_t>(key) ];
+}
+
+[[gnu::noinline]]
+  auto lookup_pointer( std::vector<record> const &table, std::int64_t key )
+    -> mry::expect< record const* >
+{
+  if (key < 0 || key >= static_cast<std::int64_t>( table.size() ))
+    return mry::error_t{"not found"};
+
+  return &table[ static_cast<std::size_t>(key) ];
+}
+
+[[gnu::noinline]]
+  auto lookup_reference( std::vector<record> const &table, std::int64_t key )
+    -> mry::expect< record const& >
+{
+  if (key < 0 || key >= static_cast<std::int64_t>( table.size() ))
+    return mry::error_t{"not found"};
+
+  return table[ static_cast<std::size_t>(key) ];
+}
+
+/**
+ * @brief check_* validate `v` -- yielding nothing but whether it
+ *        succeeded
+ */
+[[gnu::noinline]]
+  auto check_bool( std::int64_t v ) noexcept
+    -> mry::expect< bool >
+{
+  if (v % 16 == 0)
+    return mry::error_t{"multiple of 16"};
+
+  return true;
+}
+
+[[gnu::noinline]]
+  auto check_void( std::int64_t v ) noexcept
+    -> mry::expect<void>
+{
+  if (v % 16 == 0)
+    return mry::error_t{"multiple of 16"};
+
+  return {};
+}
+
+TEST_CASE( "benchmark expect<T&> lookups", "[benchmark][expect<T>][reference]" )
+{
+  auto table =
+    std::vector<record>( table_size );
+
+  for (auto i =std::size_t{0}; i < table.size(); ++i)
+    table[i] =
+      record{ static_cast<std::int64_t>(i), {} };
+
+  auto keys =
+    std::vector<std::int64_t>( 4096 );
+
+  for (auto i =std::size_t{0}; i < keys.size(); ++i)
+    keys[i] =
+      static_cast<std::int64_t>( i * 7919 % ( table_size + table_size / 8 ) );
+
+  BENCHMARK( "{baseline}: expect<T> : copied" )
+  {
+    auto sum =
+      std::int64_t{0};
+
+    for (auto key : keys)
+      if (auto found =lookup_copy( table, key ))
+        sum += found.success().key;
+
+    return sum;
+  };
+
+  BENCHMARK( "{baseline}: expect<T*>" )
+  {
+    auto sum =
+      std::int64_t{0};
+
+    for (auto key : keys)
+      if (auto found =lookup_pointer( table, key ))
+        sum += found.success()->key;
+
+    return sum;
+  };
+
+  BENCHMARK( "expect<T> : expect<T&>" )
+  {
+    auto sum =
+      std::int64_t{0};
+
+    for (auto key : keys)
+      if (auto found =lookup_reference( table, key ))
+        sum += found.success().key;
+
+    return sum;
+  };
+}
+
+TEST_CASE( "benchmark expect<void> checks", "[benchmark][expect<T>][void]" )
+{
+  auto inputs =
+    std::vector<std::int64_t>( 4096 );
+
+  for (auto i =std::size_t{0}; i < inputs.size(); ++i)
+    inputs[i] =
+      static_cast<std::int64_t>( i * 7919 );
+
+  BENCHMARK( "{baseline}: expect<bool>" )
+  {
+    auto errors =
+      std::size_t{0};
+
+    for (auto input : inputs)
+      errors += check_bool( input ).holds_error();
+
+    return errors;
+  };
+
+  BENCHMARK( "expect<T> : expect<void>" )
+  {
+    auto errors =
+      std::size_t{0};
+
+    for (auto input : inputs)
+      errors += check_void( input ).holds_error();
+
+    return errors;
+  };
+}
+
+} //< namespace
@@ -17,4 +17,345 @@
 // LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
-#include <catch2/catch.hpp>
+/**
+ * @file main.cc defines the runner of the benchmark suites
+ *
+ * when built with `BenchmarkCounters=ON` the runner takes a
+ * `--counters <file>` option, recording per benchmark -- and per
+ * iteration -- the hardware counters below along with the allocations
+ * made by the global `operator new` as CSV :
+ *
+ *   - cycles, instructions and branch misses
+ *   - L1 instruction and data cache read misses
+ *   - allocations and bytes allocated
+ *
+ * @note: counters unavailable -- eg. by `perf_event_paranoid` or
+ *        virtualization -- are recorded empty
+ */
+#include <catch2/catch_session.hpp>
+
+#if defined(MRY_BENCHMARK_COUNTERS)
+#  include <catch2/benchmark/catch_benchmark.hpp>
+#  include <catch2/reporters/catch_reporter_event_listener.hpp>
+#  include <catch2/reporters/catch_reporter_registrars.hpp>
+#  include <cstdlib>
+#  include <cstddef>
+#  include <cstdint>
+#  include <fstream>
+#  include <atomic>
+#  include <string>
+#  include <array>
+#  include <new>
+
+#  if defined(__linux__)
+#    include <linux/perf_event.h>
+#    include <sys/syscall.h>
+#    include <sys/ioctl.h>
+#    include <unistd.h>
+#  endif
+#endif
+
+#if defined(MRY_BENCHMARK_COUNTERS)
+namespace {
+
+/**
+ * @brief allocations counts the allocations made by the global
+ *        `operator new` -- across all threads
+ */
+struct allocations
+{
+  std::atomic<std::uint64_t> count =0;
+  std::atomic<std::uint64_t> bytes =0;
+};
+
+constinit auto allocated =
+  allocations{};
+
+inline
+  auto record_allocation( std::size_t size ) noexcept
+    -> void
+{
+  allocated.count.fetch_add( 1, std::memory_order_relaxed );
+  allocated.bytes.fetch_add( size, std::memory_order_relaxed );
+}
+
+/**
+ * @brief counter describes a hardware counter of the calling thread and
+ *        the threads it spawns while enabled -- unavailable until opened
+ */
+class counter final
+{
+  public :
+    counter() noexcept
+      =default;
+
+    counter( counter const & )
+      =delete;
+    auto operator=( counter const & )
+      -> counter& =delete;
+
+    ~counter() noexcept
+    {
+#  if defined(__linux__)
+      if (available())
+        ::close( fd_ );
+#  endif
+    }
+
+    /**
+     * @brief open opens the counter of the event `config` of `type`
+     */
+    auto open( std::uint32_t type, std::uint64_t config ) noexcept
+      -> void
+    {
+#  if defined(__linux__)
+      auto attr =
+        perf_event_attr{};
+
+      attr.size           = sizeof(attr);
+      attr.type           = type;
+      attr.config         = config;
+      attr.disabled       = 1;
+      attr.inherit        = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+
+      fd_ =
+        static_cast<int>( ::syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 ) );
+#  else
+      (void) type;
+      (void) config;
+#  endif
+    }
+
+    inline
+      auto available() const noexcept
+        -> bool
+    { return fd_ >= 0; }
+
+    auto start() noexcept
+      -> void
+    {
+#  if defined(__linux__)
+      if (!available())
+        return;
+
+      ::ioctl( fd_, PERF_EVENT_IOC_RESET, 0 );
+      ::ioctl( fd_, PERF_EVENT_IOC_ENABLE, 0 );
+#  endif
+    }
+
+    /**
+     * @brief stop stops counting, returning the events counted
+     */
+    auto stop() noexcept
+      -> std::uint64_t
+    {
+      auto value =
+        std::uint64_t{0};
+
+#  if defined(__linux__)
+      if (!available())
+        return value;
+
+      ::ioctl( fd_, PERF_EVENT_IOC_DISABLE, 0 );
+
+      if (::read( fd_, &value, sizeof(value) ) != sizeof(value))
+        value = 0;
+#  endif
+
+      return value;
+    }
+
+  private :
+    int fd_ =-1;
+};
+
+#  if defined(__linux__)
+auto constexpr l1_read_miss( std::uint64_t cache ) noexcept
+  -> std::uint64_t
+{ return cache
+       | ( PERF_COUNT_HW_CACHE_OP_READ << 8 )
+       | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 ); }
+#  endif
+
+/**
+ * @brief counters_listener records the counters of each benchmark
+ *        between its start and end -- ie. its samples
+ *
+ * @note: the runner disables the warm-up and analysis phases while
+ *        recording, leaving the samples the only user code run
+ *
+ * @note: the counters are opened only once recording is requested
+ */
+class counters_listener final
+  : public Catch::EventListenerBase
+{
+  public :
+    using Catch::EventListenerBase::EventListenerBase;
+
+    /**
+     * @brief path denotes the CSV file recorded to -- none when empty
+     */
+    static auto path() noexcept
+      -> std::string&
+    {
+      static auto path =
+        std::string{};
+
+      return path;
+    }
+
+    auto testRunStarting( Catch::TestRunInfo const & )
+      -> void override
+    {
+      if (path().empty())
+        return;
+
+#  if defined(__linux__)
+      counters_[0].open( PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES );
+      counters_[1].open( PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS );
+      counters_[2].open( PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES );
+      counters_[3].open( PERF_TYPE_HW_CACHE, l1_read_miss( PERF_COUNT_HW_CACHE_L1I ) );
+      counters_[4].open( PERF_TYPE_HW_CACHE, l1_read_miss( PERF_COUNT_HW_CACHE_L1D ) );
+#  endif
+
+      csv_.open( path() );
+      csv_ << "benchmark,iterations,cycles,instructions,branch-misses"
+              ",l1i-misses,l1d-misses,allocations,bytes\n";
+    }
+
+    auto benchmarkStarting( Catch::BenchmarkInfo const & )
+      -> void override
+    {
+      if (!csv_.is_open())
+        return;
+
+      allocations_ = allocated.count.load();
+      bytes_       = allocated.bytes.load();
+
+      for (auto &c : counters_)
+        c.start();
+    }
+
+    auto benchmarkEnded( Catch::BenchmarkStats<> const &stats )
+      -> void override
+    {
+      if (!csv_.is_open())
+        return;
+
+      auto values =
+        std::array<std::uint64_t, 5>{};
+
+      for (auto i =std::size_t{0}; i < counters_.size(); ++i)
+        values[i] = counters_[i].stop();
+
+      auto allocations =
+        allocated.count.load() - allocations_;
+      auto bytes =
+        allocated.bytes.load() - bytes_;
+
+      auto iterations =
+        static_cast<double>( stats.info.iterations ) * stats.info.samples;
+      auto per_iteration =
+        [&]( std::uint64_t v ){ return std::to_string( v / iterations ); };
+
+      csv_ << '"' << stats.info.name << '"' << ',' << iterations;
+
+      for (auto i =std::size_t{0}; i < counters_.size(); ++i)
+        csv_ << ',' << ( counters_[i].available() ? per_iteration( values[i] ) : "" );
+
+      csv_ << ',' << per_iteration( allocations )
+           << ',' << per_iteration( bytes )
+           << '\n';
+    }
+
+  private :
+    std::array<counter, 5> counters_ ={};
+
+    std::ofstream csv_;
+    std::uint64_t allocations_ =0;
+    std::uint64_t bytes_ =0;
+};
+
+} //< namespace
+
+CATCH_REGISTER_LISTENER( counters_listener )
+
+/* @note: the replacements of the global `operator new` and `delete`
+ *        -- the array and nothrow forms forward to these by default */
+auto operator new( std::size_t size )
+  -> void*
+{
+  record_allocation( size );
+
+  if (auto p =std::malloc( size ? size : 1 ))
+    return p;
+
+  throw std::bad_alloc{};
+}
+
+auto operator new( std::size_t size, std::align_val_t alignment )
+  -> void*
+{
+  record_allocation( size );
+
+  auto a =
+    static_cast<std::size_t>( alignment );
+
+  if (auto p =std::aligned_alloc( a, ( size + a - 1 ) / a * a ))
+    return p;
+
+  throw std::bad_alloc{};
+}
+
+auto operator delete( void *p ) noexcept
+  -> void
+{ std::free( p ); }
+
+auto operator delete( void *p, std::size_t ) noexcept
+  -> void
+{ std::free( p ); }
+
+auto operator delete( void *p, std::align_val_t ) noexcept
+  -> void
+{ std::free( p ); }
+
+auto operator delete( void *p, std::size_t, std::align_val_t ) noexcept
+  -> void
+{ std::free( p ); }
+#endif
+
+auto main( int argc, char *argv[] )
+  -> int
+{
+  auto session =
+    Catch::Session{};
+
+#if defined(MRY_BENCHMARK_COUNTERS)
+  using Catch::Clara::Opt;
+
+  session.cli( session.cli()
+             | Opt( counters_listener::path(), "file" )
+                  ["--counters"]
+                  ( "records hardware counters and allocations per benchmark iteration to a CSV file" ) );
+#endif
+
+  if (auto failed =session.applyCommandLine( argc, argv ))
+    return failed;
+
+#if defined(MRY_BENCHMARK_COUNTERS)
+  if (!counters_listener::path().empty())
+  {
+    auto &config =
+      session.configData();
+
+    config.benchmarkNoAnalysis =
+      true;
+    config.benchmarkWarmupTime =
+      decltype(config.benchmarkWarmupTime){};
+  }
+#endif
+
+  return session.run();
+}
@@ -19,9 +19,22 @@
 # SOFTWARE.
 cmake_minimum_required( VERSION 3.22 )
 
-option( BuildBenchmarks "Build project benchmarks and run alongside tests" OFF )
+option( BuildBenchmarks   "Build project benchmarks and run alongside tests" OFF )
+option( BenchmarkCounters "Record hardware counters and allocations of benchmarks" OFF )
+option( ErrorCounters     "Record the error conditions met per call site" OFF )
+option( ErrorLocation     "Hold the call site constructing error_t, see error_t::where()" OFF )
 
 set(    Sanitize        "" CACHE STRING "Build project with given Sanitizer enabled" )
 set_property( CACHE Sanitize PROPERTY STRINGS address
                                               thread
                                               "" )
+
+set(    ErrorBacktrace  "" CACHE STRING "Capture the backtrace constructing error_t, see error_t::trace()" )
+set_property( CACHE ErrorBacktrace PROPERTY STRINGS unwind
+                                                    frame-pointer
+                                                    "" )
+
+set(    ParseISA        "" CACHE STRING "Instruction set the parsers of mry::parse classify text by, see parse/simd.h" )
+set_property( CACHE ParseISA PROPERTY STRINGS avx2
+                                              scalar
+                                              "" )
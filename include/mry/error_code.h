@@ -0,0 +1,129 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file error_code.h defines {strongly typed}, enum backed error codes
+ *       and their categories describing such codes at compile time
+ *
+ * @see: `mry::error_category<Enum>`
+ * @see: `mry::error_t`
+ */
+#include <string_view>
+#include <type_traits>
+#include <concepts>
+#include <cstddef>
+#include <array>
+
+namespace mry {
+
+/**
+ * @brief error_category is the customization point describing the
+ *        enumeration `Enum` as error codes
+ *
+ * specializations shall define
+ *
+ *   - `name` : a `std::string_view` naming the category
+ *   - `messages` : a constexpr `std::array<std::string_view, N>` of the
+ *                  descriptions of each code, indexed by the underlying
+ *                  values of `Enum` -- which hence are dense in `[0, N)`
+ *
+ * ```cpp
+ * enum class parse_errc { invalid_char, overflow };
+ *
+ * template <>
+ *   struct mry::error_category<parse_errc>
+ * {
+ *   static auto constexpr name =
+ *     std::string_view{ "parse" };
+ *   static auto constexpr messages =
+ *     std::to_array<std::string_view>({ "invalid char", "overflow" });
+ * };
+ * ```
+ */
+template <typename Enum>
+  struct error_category;
+
+/**
+ * @brief error_code_enum concept describes enumerations having their
+ *        `mry::error_category<Enum>` defined
+ */
+template <typename Enum>
+  concept error_code_enum =
+    std::is_enum_v<Enum>
+ && requires { { error_category<Enum>::name } -> std::convertible_to<std::string_view>;
+               error_category<Enum>::messages.size(); };
+
+namespace internal {
+
+/**
+ * @brief code_entry describes a single error code of a category
+ *
+ * @note: entries are aligned to leave the low bits of their addresses
+ *        available for tagging by `mry::error_t`
+ */
+struct alignas(8) code_entry final
+{
+  std::string_view category;
+  std::size_t      value;
+  std::string_view message;
+};
+
+/**
+ * @brief code_table defines the {static} table of `code_entry`s of
+ *        the category of `Enum`, built at compile time
+ */
+template <error_code_enum Enum>
+  struct code_table final
+{
+  using category_type =
+    error_category<Enum>;
+
+  static auto constexpr size =
+    category_type::messages.size();
+
+  static auto constexpr entries =
+    []() constexpr
+      {
+        auto table =
+          std::array< code_entry, size >{};
+
+        for (auto i =std::size_t{0}; i < size; ++i)
+          table[i] =
+            code_entry{ category_type::name
+                      , i
+                      , category_type::messages[i] };
+
+        return table;
+      }();
+
+  /**
+   * @brief entry returns the entry describing `e`
+   *
+   * @note: it is the responsibility of the caller to ensure `e` is
+   *        described by the category of `Enum`
+   */
+  static constexpr
+    auto entry( Enum e ) noexcept
+      -> code_entry const*
+  { return &entries[ static_cast<std::size_t>(e) ]; }
+};
+
+} // namespace internal
+} // namespace mry
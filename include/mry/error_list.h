@@ -0,0 +1,474 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file error_list.h defines a list of error conditions holding its
+ *       first few inline -- collecting all the error conditions met
+ *       by a validation, not merely the first one
+ *
+ * @see: `mry::error_list<E, N>`
+ */
+#include "mry/expect.h"
+#include "mry/error_t.h"
+#include "mry/relocate.h"
+
+#include <memory_resource>
+#include <type_traits>
+#include <stdexcept>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <limits>
+#include <memory>
+#include <span>
+#include <new>
+
+namespace mry {
+
+/**
+ * @brief error_list<E, N> is a list of the error conditions E met,
+ *        holding the first N of them inline -- should more be met
+ *        they spill to storage allocated from a memory resource
+ *
+ * ```cpp
+ * auto validate( user const &u )
+ *   -> mry::expect< user const*, mry::error_list<> >
+ * {
+ *   auto errors =
+ *     mry::error_list<>{};
+ *
+ *   if (u.name.empty())
+ *     errors.push_back( mry::error_t{ "name is empty" } );
+ *   if (u.age > 150)
+ *     errors.push_back( mry::error_t{ "age {} out of range", u.age } );
+ *
+ *   return std::move(errors).into( &u );
+ * }
+ * ```
+ *
+ * hence collecting up to N error conditions described by string
+ * literals or error codes does not allocate at all.
+ *
+ * @note: storage is spilled to the memory resource given on
+ *        construction, or to `mry::error_resource()` of the thread
+ *        spilling -- eg. an `mry::error_arena` -- otherwise, each time
+ *        the list spills or grows. assignments keep such resource,
+ *        relocating the error conditions assigned unless their storage
+ *        is of an equal resource
+ *
+ * @note: error_list<E, N> is trivially relocatable whenever E is,
+ *        its inline storage is never referred to but by computing
+ *        its address
+ *
+ * @see: `mry::expect<T, E>`
+ */
+template <typename E =error_t, std::size_t N =8>
+  class error_list final
+{
+    static_assert( N > 0 && N < UINT32_MAX
+                 , "error_list<E, N> requires an inline capacity of 1 to 2^32 - 2" );
+    static_assert( std::is_nothrow_move_constructible_v<E>
+                 , "error_list<E, N> requires nothrow move constructible E" );
+
+  public :
+    using value_type =
+      E;
+    using size_type =
+      std::uint32_t;
+    using iterator =
+      E*;
+    using const_iterator =
+      E const*;
+
+    static auto constexpr inline_capacity =
+      size_type{ N };
+
+    /**
+     * @brief constructs an empty list spilling to the error resource
+     *        of the thread spilling
+     */
+    error_list() noexcept
+      =default;
+
+    /**
+     * @brief constructs an empty list spilling to `resource`
+     *
+     * @note: it is the responsibility of the caller to ensure
+     *        `resource` outlives the list
+     */
+    explicit
+      error_list( std::pmr::memory_resource *resource ) noexcept
+        : resource_{ resource }
+    {}
+
+    /**
+     * @brief copy constructs the list, spilling to the resource of `o`
+     */
+    error_list( error_list const &o )
+      : resource_{ o.resource_ }
+    {
+      reserve( o.size_ );
+
+      /* @note: the destructor is not run of a constructor throwing,
+       *        hence the storage spilled is released here */
+      try
+      { std::uninitialized_copy( o.begin(), o.end(), data() ); }
+
+      catch (...)
+      {
+        deallocate();
+        throw;
+      }
+
+      size_ = o.size_;
+    }
+
+    /**
+     * @brief move constructs the list leaving `o` empty, spilling to
+     *        the resource of `o`
+     *
+     * @note: spilled storage is taken over, inline error conditions
+     *        are relocated
+     */
+    error_list( error_list &&o ) noexcept
+      : resource_{ o.resource_ }
+    { take( std::move(o) ); }
+
+    /**
+     * @brief copy assigns `o`
+     */
+    auto operator=( error_list const &o )
+      -> error_list&
+    { return *this = error_list{ o }; }
+
+    /**
+     * @brief move assigns `o` leaving it empty, keeping the resource
+     *        the list spills to
+     *
+     * @note: the spilled storage of `o` is taken over given it is of a
+     *        resource equal to such, the error conditions of `o` are
+     *        relocated otherwise -- throwing should spilling them fail
+     *        to allocate, the list being left intact
+     */
+    auto operator=( error_list &&o )
+      -> error_list&
+    {
+      if (this == &o)
+        return *this;
+
+      auto resource =
+        spilling_resource();
+
+      if (o.spilled_ && o.owner_->is_equal( *resource ))
+      {
+        clear();
+        deallocate();
+        take( std::move(o) );
+
+        return *this;
+      }
+
+      auto storage =
+        o.size_ > inline_capacity ? static_cast<E*>( resource->allocate( o.size_ * sizeof(E), alignof(E) ) )
+                                  : nullptr;
+
+      clear();
+      deallocate();
+
+      spilled_  = storage;
+      owner_    = storage ? resource : nullptr;
+      capacity_ = storage ? o.size_ : inline_capacity;
+
+      uninitialized_relocate( o.data(), o.data() + o.size_, data() );
+
+      size_     = std::exchange( o.size_, 0 );
+      return *this;
+    }
+
+    /**
+     * @brief destroys the error conditions held releasing any spilled
+     *        storage
+     */
+    ~error_list() noexcept
+    {
+      clear();
+      deallocate();
+    }
+
+    /**
+     * @brief size returns the number of error conditions held
+     */
+    inline
+      auto size() const noexcept
+        -> size_type
+    { return size_; }
+
+    inline
+      auto empty() const noexcept
+        -> bool
+    { return size_ == 0; }
+
+    /**
+     * @brief capacity returns the number of error conditions the list
+     *        holds before growing its storage
+     */
+    inline
+      auto capacity() const noexcept
+        -> size_type
+    { return capacity_; }
+
+    /**
+     * @brief spilled predicate tests whether the error conditions are
+     *        held by storage allocated from a memory resource
+     */
+    inline
+      auto spilled() const noexcept
+        -> bool
+    { return spilled_ != nullptr; }
+
+    /**
+     * @brief holds_error predicate tests whether any error condition
+     *        is held
+     *
+     * @see: `mry::error_t::holds_error()`
+     */
+    inline
+      auto holds_error() const noexcept
+        -> bool
+    { return size_ != 0; }
+
+    /**
+     * @brief {explicit} operator bool is a convenience layer over
+     *        `holds_error()`
+     */
+    inline explicit
+      operator bool() const noexcept
+    { return holds_error(); }
+
+    /**
+     * @brief reserve grows the storage to hold at least `n` error
+     *        conditions
+     */
+    auto reserve( size_type n )
+      -> void
+    {
+      if (n <= capacity_)
+        return;
+
+      auto resource =
+        spilling_resource();
+      auto storage =
+        static_cast<E*>( resource->allocate( n * sizeof(E), alignof(E) ) );
+
+      uninitialized_relocate( data(), data() + size_, storage );
+      deallocate();
+
+      spilled_  = storage;
+      owner_    = resource;
+      capacity_ = n;
+    }
+
+    /**
+     * @brief emplace_back appends the error condition E constructed
+     *        from `args`
+     *
+     * @note: the inline storage is spilled, or the spilled one grown
+     *        by doubling, should the list be full -- throwing
+     *        `std::length_error` should it hold `UINT32_MAX` already
+     */
+    template <typename ...Args>
+      auto emplace_back( Args &&...args )
+        -> E&
+    {
+      if (size_ == capacity_) [[unlikely]]
+        reserve( grown() );
+
+      auto at =
+        ::new (static_cast<void*>( data() + size_ )) E{ std::forward<Args>(args)... };
+
+      ++size_;
+      return *at;
+    }
+
+    /**
+     * @brief push_back appends the error condition `e`
+     */
+    inline
+      auto push_back( E e )
+        -> E&
+    { return emplace_back( std::move(e) ); }
+
+    /**
+     * @brief clear destroys the error conditions held, keeping any
+     *        spilled storage
+     */
+    inline
+      auto clear() noexcept
+        -> void
+    {
+      std::destroy( begin(), end() );
+      size_ = 0;
+    }
+
+    inline
+      auto operator[]( size_type i ) noexcept
+        -> E&
+    { return data()[i]; }
+
+    inline
+      auto operator[]( size_type i ) const noexcept
+        -> E const&
+    { return data()[i]; }
+
+    inline auto begin() noexcept -> iterator { return data(); }
+    inline auto end() noexcept -> iterator { return data() + size_; }
+
+    inline auto begin() const noexcept -> const_iterator { return data(); }
+    inline auto end() const noexcept -> const_iterator { return data() + size_; }
+
+    /**
+     * @brief errors returns a view of the error conditions held
+     */
+    inline
+      auto errors() const noexcept
+        -> std::span<E const>
+    { return { data(), size_ }; }
+
+    /**
+     * @brief into returns `expect<T, error_list>` holding `value`
+     *        -- or the list itself should it hold any error condition
+     */
+    template <typename T>
+      auto into( T &&value ) &&
+        -> expect< std::remove_cvref_t<T>, error_list >
+    {
+      if (holds_error())
+        return { std::move(*this) };
+
+      return { std::forward<T>(value) };
+    }
+
+  private :
+    /**
+     * @brief spilling_resource returns the resource the list spills to
+     *        -- the one given on construction, or the error resource of
+     *        the calling thread
+     */
+    inline
+      auto spilling_resource() const noexcept
+        -> std::pmr::memory_resource*
+    { return resource_ ? resource_ : error_resource(); }
+
+    /**
+     * @brief grown returns the capacity doubled -- clamped to the
+     *        largest `size_type`, computed wider not to wrap around
+     */
+    inline
+      auto grown() const
+        -> size_type
+    {
+      auto constexpr largest =
+        std::size_t{ std::numeric_limits<size_type>::max() };
+
+      if (capacity_ == largest)
+        throw std::length_error{ "error_list exceeds UINT32_MAX error conditions" };
+
+      return static_cast<size_type>( std::min( std::size_t{ capacity_ } * 2, largest ) );
+    }
+
+    /**
+     * @brief data returns the storage of the error conditions held
+     */
+    inline
+      auto data() noexcept
+        -> E*
+    { return spilled_ ? spilled_ : inline_data(); }
+
+    inline
+      auto data() const noexcept
+        -> E const*
+    { return spilled_ ? spilled_ : inline_data(); }
+
+    inline
+      auto inline_data() noexcept
+        -> E*
+    { return std::launder( reinterpret_cast<E*>( inline_ ) ); }
+
+    inline
+      auto inline_data() const noexcept
+        -> E const*
+    { return std::launder( reinterpret_cast<E const*>( inline_ ) ); }
+
+    /**
+     * @brief take takes over the error conditions `o` holds leaving it
+     *        empty -- relocating inline ones -- along with the resource
+     *        its spilled storage is of
+     *
+     * @note: it is the responsibility of the caller to ensure the
+     *        instance holds no error conditions nor spilled storage
+     */
+    inline
+      auto take( error_list &&o ) noexcept
+        -> void
+    {
+      spilled_  = std::exchange( o.spilled_, nullptr );
+      owner_    = std::exchange( o.owner_, nullptr );
+      size_     = std::exchange( o.size_, 0 );
+      capacity_ = std::exchange( o.capacity_, inline_capacity );
+
+      if (spilled_ == nullptr)
+        uninitialized_relocate( o.inline_data(), o.inline_data() + size_, inline_data() );
+    }
+
+    /**
+     * @brief deallocate releases any spilled storage
+     *
+     * @note: it is the responsibility of the caller to ensure no error
+     *        conditions are alive within such storage
+     */
+    inline
+      auto deallocate() noexcept
+        -> void
+    {
+      if (spilled_)
+        owner_->deallocate( spilled_, capacity_ * sizeof(E), alignof(E) );
+    }
+
+    /* @note: `owner_` is the resource `spilled_` is of, `resource_` the
+     *        one given on construction -- if any */
+    E                         *spilled_  =nullptr;
+    std::pmr::memory_resource *owner_    =nullptr;
+    std::pmr::memory_resource *resource_ =nullptr;
+    size_type                  size_     =0;
+    size_type                  capacity_ =inline_capacity;
+
+    alignas(E) std::byte inline_[ N * sizeof(E) ];
+};
+
+/**
+ * @brief error_list<E, N> is trivially relocatable whenever E is
+ */
+template <typename E, std::size_t N>
+  struct is_trivially_relocatable< error_list<E, N> >
+    : std::bool_constant< is_trivially_relocatable_v<E> >
+{};
+
+} // namespace mry
@@ -24,48 +24,346 @@
  *       
  * @see: `mry::error_t`
  */
-#include <optional>
+#include "mry/error_t/resource.h"
+#include "mry/error_t/backtrace.h"
+#include "mry/error_t/counters.h"
+#include "mry/error_t/site.h"
+#include "mry/error_t/payload.h"
+#include "mry/error_t/format.h"
+#include "mry/error_code.h"
+#include "mry/relocate.h"
+#include "mry/meta.h"
+
+#include <source_location>
+#include <string_view>
+#include <type_traits>
+#include <concepts>
+#include <cstdint>
+#include <utility>
+#include <cstddef>
 #include <string>
 
 namespace mry {
+namespace internal {
+
+template <typename T, typename E>
+  struct discriminant;
+
+} // namespace internal
 
 /**
  * @brief error_t describes a {strongly typed} error condition that
  *        may occure during runtime
  *
+ * error_t is a single pointer-sized handle, its lowest 3 bits tagging
+ * which kind of description it refers to :
+ *
+ *   - `0b001` : a {dynamically allocated} `internal::error_payload` -- or none
+ *               at all when the address is null, denoting no error
+ *   - `0b011` : a {static} `internal::code_entry` of an error code
+ *   - `0b101` : a string literal, its address shifted left by 3 bits
+ *
+ * hence describing an error condition by an error code or a string
+ * literal does not allocate, only dynamic descriptions do.
+ *
+ * @note: constructing an error_t records a hit against its call site
+ *        when error counters are enabled
+ *
+ * @see: `mry::error_counts()`
+ *
+ * @note: error_t holds the call site constructing it in a second word
+ *        when `MRY_ERROR_LOCATION` is defined
+ *
+ * @see: `where()`
+ *
+ * @note: error_t holds the backtrace of the call site constructing it
+ *        when `MRY_ERROR_BACKTRACE` is defined
+ *
+ * @see: `trace()`
+ *
+ * @note: the lowest bit of the representation is always set -- even in
+ *        the "empty" state -- which `mry::niche_traits<T>` may rely on
+ *
+ * @note: error_t is usable within constant evaluation, describing error
+ *        conditions by string literals and error codes -- held by an
+ *        `internal::constant_payload` allocated within the evaluation,
+ *        hence not outliving it
+ *
  * @note: error_t is a {strongly typed} alternative to raising exceptions
  *        in a context when an operation would only have side-effects
  *        and not yield a result otherwise
  */
 class error_t final
 {
+    using word_type =
+      std::uintptr_t;
+
+    static_assert( sizeof(word_type) == 8
+                 , "error_t packs string literal addresses into 61 bits" );
+
+    static word_type constexpr tag_mask =
+      0b111;
+    static word_type constexpr payload_tag =
+      0b001;
+    static word_type constexpr code_tag =
+      0b011;
+    static word_type constexpr literal_tag =
+      0b101;
+    static word_type constexpr literal_shift =
+      3;
+
+    /**
+     * @brief no_error denotes the representation of the "empty" state,
+     *        the lack of an `internal::error_payload`
+     */
+    static word_type constexpr no_error =
+      payload_tag;
+
   public :
     /**
      * @brief constructs "empty" state denoting no error
      *        condition met during runtime -- "holds" no errors
      */
     constexpr error_t() noexcept
-      =default;
+    {}
 
     /**
      * @brief constructs an instance denoting an error condition
-     *        met along with the description of such condition
+     *        met along with the {static} description of such condition
+     *
+     * @note: the description is referred to by its address, hence
+     *        `literal` is required to be a constant expression -- a
+     *        string literal or an array of static storage duration --
+     *        arrays of automatic storage are to be copied by
+     *        `error_t( std::string )` instead
+     *
+     * @see: `internal::literal_string`
+     */
+    constexpr explicit
+      error_t( internal::literal_string literal, internal::call_site site ={} ) noexcept
+        : location_{ site }
+        , trace_{ internal::error_backtrace::capture }
+    {
+      if (std::is_constant_evaluated())
+        constant_ =
+          new internal::constant_payload{ literal.text, nullptr };
+
+      else
+        word_ =
+          ( reinterpret_cast<word_type>( literal.text ) << literal_shift ) | literal_tag;
+
+      internal::record_error( site );
+    }
+
+    /**
+     * @brief constructs an instance denoting an error condition
+     *        met along with the {deferred} description of such condition
+     *        -- `format` having its `{}` placeholders substituted by `args`
+     *
+     * ```cpp
+     * return mry::error_t{ "non digit char {}", c };
+     * ```
      *
+     * @note: `args` are captured into a payload allocated from the error
+     *        resource of the calling thread -- throwing should the resource
+     *        fail to allocate -- the description is rendered only on the
+     *        first `get()` -- and cached
+     *
+     * @see: `mry::format_argument`
      */
-    explicit
-      error_t( std::string e ) noexcept
-        : err_{ std::move(e) }
+    template <format_argument ...Args>
+      requires ( sizeof...(Args) > 0 )
+      explicit
+        error_t( internal::format_string format, Args &&...args )
+          : word_{ adopt( internal::format_payload< internal::format_arg_t<Args>... >
+                            ::make( format.text, std::forward<Args>(args)... ) ) }
+          , location_{ format.site }
+          , trace_{ internal::error_backtrace::capture }
+    { internal::record_error( format.site ); }
+
+    /**
+     * @brief constructs an instance denoting an error condition
+     *        met by its error code `e`
+     *
+     * @note: the description of `e` is resolved only on `get()`
+     *
+     * @see: `mry::error_category<Enum>`
+     */
+    template <error_code_enum Enum>
+      constexpr explicit
+        error_t( Enum e, internal::call_site site ={} ) noexcept
+          : location_{ site }
+          , trace_{ internal::error_backtrace::capture }
+    {
+      auto entry =
+        internal::code_table<Enum>::entry(e);
+
+      if (std::is_constant_evaluated())
+        constant_ =
+          new internal::constant_payload{ entry->message, entry };
+
+      else
+        word_ =
+          reinterpret_cast<word_type>(entry) | code_tag;
+
+      internal::record_error( site );
+    }
+
+    /**
+     * @brief constructs an instance denoting an error condition
+     *        met along with the description of such condition
+     *        copied from a {mutable} buffer
+     */
+    template <std::size_t N>
+      explicit
+        error_t( char (&buffer)[N], internal::call_site site ={} )
+          : error_t{ static_cast<char const*>( buffer ), site }
     {}
 
+    /**
+     * @brief constructs an instance denoting an error condition
+     *        met along with the description of such condition
+     *
+     * @note: the description is copied to a payload allocated from
+     *        the error resource of the calling thread -- throwing should
+     *        the resource fail to allocate
+     *
+     * @note: arrays are not taken, telling literals -- referred to by
+     *        address -- from strings apart
+     *
+     * @see: `mry::error_resource()`
+     */
+    template <typename S>
+        requires std::convertible_to<S, std::string>
+              && ( ! std::is_array_v< std::remove_reference_t<S> > )
+      explicit
+        error_t( S &&e, internal::call_site site ={} )
+          : word_{ adopt( describe( std::forward<S>(e) ) ) }
+          , location_{ site }
+          , trace_{ internal::error_backtrace::capture }
+    { internal::record_error( site ); }
+
+    /* @note: gcc may lose track of the discriminant of an `mry::expect`
+     *        across atomics, flagging the copy or move of an error_t it
+     *        never held -- its call site or backtrace -- as uninitialized */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    /**
+     * @brief copy constructs the instance, deep copying any
+     *        dynamic description `o` holds
+     */
+    constexpr error_t( error_t const &o )
+      : location_{ o.location_ }
+      , trace_{ o.trace_ }
+    {
+      if (std::is_constant_evaluated())
+      {
+        if (auto constant =o.constant())
+          constant_ =
+            new internal::constant_payload{ *constant };
+      }
+
+      else
+        word_ =
+          o.is_payload() ? adopt( o.payload()->clone() )
+                         : o.word_;
+    }
+
+    /**
+     * @brief move constructs the instance leaving `o` "empty"
+     */
+    constexpr error_t( error_t &&o ) noexcept
+      : location_{ o.location_ }
+      , trace_{ o.trace_ }
+    {
+      if (std::is_constant_evaluated())
+      {
+        if (auto constant =o.constant())
+        {
+          constant_ = constant;
+          o.word_   = no_error;
+        }
+      }
+
+      else
+        word_ =
+          std::exchange( o.word_, no_error );
+    }
+
+#pragma GCC diagnostic pop
+
+    /**
+     * @brief copy assigns `o`
+     */
+    constexpr
+      auto operator=( error_t const &o )
+        -> error_t&
+    { return *this = error_t{ o }; }
+
+    /**
+     * @brief move assigns `o` leaving it "empty"
+     */
+    constexpr
+      auto operator=( error_t &&o ) noexcept
+        -> error_t&
+    {
+      if (this == &o)
+        return *this;
+
+      if (std::is_constant_evaluated())
+      {
+        delete constant();
+
+        if (auto constant =o.constant())
+        {
+          constant_ = constant;
+          o.word_   = no_error;
+        }
+
+        else
+          word_ = no_error;
+      }
+
+      else
+      {
+        if (is_payload())
+          payload()->release();
+
+        word_ =
+          std::exchange( o.word_, no_error );
+      }
+
+      location_ = o.location_;
+      trace_    = o.trace_;
+      return *this;
+    }
+
+    /**
+     * @brief releases any dynamic description being held
+     */
+    constexpr ~error_t() noexcept
+    {
+      if (std::is_constant_evaluated())
+        delete constant();
+
+      else if (is_payload())
+        payload()->release();
+    }
+
     /**
      * @brief holds_error predicate tests whether the
      *        instance denotes an error condition met
      *        and holds a description of such condition
      */
-    inline
+    constexpr
       auto holds_error() const noexcept
         -> bool
-    { return err_.has_value(); }
+    {
+      if (std::is_constant_evaluated())
+        return constant() != nullptr;
+
+      return word_ > no_error;
+    }
 
     /**
      * @brief {explicit} operator bool is a convenience layer
@@ -73,10 +371,31 @@ class error_t final
      *
      * @see: `holds_error()`
      */
-    inline explicit
+    constexpr explicit
       operator bool() const noexcept
     { return holds_error(); }
 
+    /**
+     * @brief is predicate tests whether the instance denotes the
+     *        error condition met by the error code `e`
+     */
+    template <error_code_enum Enum>
+      constexpr
+        auto is( Enum e ) const noexcept
+          -> bool
+    {
+      if (std::is_constant_evaluated())
+      {
+        auto constant =
+          this->constant();
+
+        return constant && constant->code == internal::code_table<Enum>::entry(e);
+      }
+
+      return word_ == ( reinterpret_cast<word_type>( internal::code_table<Enum>::entry(e) )
+                      | code_tag );
+    }
+
     /**
      * @brief get returns the {weakly typed} description of the error condition
      *
@@ -84,15 +403,146 @@ class error_t final
      *        ensure the `error_t` instance calling `get()`
      *        on does hold an error
      *
+     * @note: `get()` is safe to call concurrently on the same instance,
+     *        a deferred description is rendered once -- described by
+     *        its format string should rendering fail to allocate
+     *
      * @see: `operator bool()`
      * @see: `holds_error()`
      */
-    inline auto get() noexcept
-      -> decltype(auto)
-    { return *err_; }
+    constexpr
+      auto get() const noexcept
+        -> std::string_view
+    {
+      if (std::is_constant_evaluated())
+        return constant()->message;
+
+      if (( word_ & tag_mask ) == literal_tag)
+        return reinterpret_cast<char const*>( word_ >> literal_shift );
+
+      if (( word_ & tag_mask ) == code_tag)
+        return reinterpret_cast<internal::code_entry const*>( word_ & ~tag_mask )
+               ->message;
+
+      return payload()->what();
+    }
+
+    /**
+     * @brief where returns the source location of the expression
+     *        constructing the instance
+     *
+     * @note: the location is held only when `MRY_ERROR_LOCATION` is
+     *        defined -- eg. by the `ErrorLocation` CMake option --
+     *        a default constructed `std::source_location` otherwise
+     *
+     * @note: copies and moves keep the location of the original
+     */
+    inline constexpr
+      auto where() const noexcept
+        -> std::source_location
+    { return location_.where(); }
+
+    /**
+     * @brief trace returns the -- raw -- backtrace of the expression
+     *        constructing the instance
+     *
+     * @note: the backtrace is captured only when `MRY_ERROR_BACKTRACE`
+     *        is defined -- eg. by the `ErrorBacktrace` CMake option --
+     *        empty otherwise
+     *
+     * @see: `mry::backtrace::symbolize()`
+     */
+    inline
+      auto trace() const noexcept
+        -> backtrace const&
+    { return trace_.trace(); }
 
   private :
-    std::optional<std::string> err_ ={};
+    /**
+     * @brief adopt returns the tagged representation of `p`
+     */
+    static auto adopt( internal::error_payload *p ) noexcept
+      -> word_type
+    { return reinterpret_cast<word_type>(p) | payload_tag; }
+
+    /**
+     * @brief describe returns the payload describing the error condition
+     *        by `e` -- copied straight from a view of it, if any
+     */
+    template <typename S>
+      static auto describe( S &&e )
+        -> internal::error_payload*
+    {
+      if constexpr (std::is_convertible_v<S, std::string_view>)
+        return internal::message_payload::make( std::string_view{ e } );
+
+      else
+        return internal::message_payload::make( std::string( std::forward<S>(e) ) );
+    }
+
+    /**
+     * @brief is_payload predicate tests whether the instance
+     *        owns a dynamic description
+     */
+    inline
+      auto is_payload() const noexcept
+        -> bool
+    { return ( word_ & tag_mask ) == payload_tag && holds_error(); }
+
+    /**
+     * @brief payload returns the dynamic description being held
+     */
+    inline
+      auto payload() const noexcept
+        -> internal::error_payload*
+    { return reinterpret_cast<internal::error_payload*>( word_ & ~tag_mask ); }
+
+    /**
+     * @brief constant returns the description held within constant
+     *        evaluation -- `nullptr` given the "empty" state
+     */
+    constexpr
+      auto constant() const noexcept
+        -> internal::constant_payload*
+    { return mry::meta::within_lifetime( &word_ ) ? nullptr : constant_; }
+
+    /* @note: the discriminant of a niche tells whether an instance is
+     *        alive within constant evaluation by its members */
+    template <typename, typename>
+      friend struct internal::discriminant;
+
+    /**
+     * @note: `constant_` is held in place of `word_` only within
+     *        constant evaluation describing an error condition -- the
+     *        "empty" state being `no_error` alike at runtime, hence
+     *        also when outliving such evaluation
+     */
+    union
+    {
+      word_type                   word_ =no_error;
+      internal::constant_payload *constant_;
+    };
+
+    [[no_unique_address]]
+    internal::error_location location_ ={};
+
+    [[no_unique_address]]
+    internal::error_backtrace trace_ ={};
 };
 
+/* @note: pointer-sized unless holding its call site or backtrace */
+static_assert( sizeof(error_t)
+            == sizeof(void*)
+             + ( std::is_empty_v<internal::error_location> ? 0 : sizeof(internal::error_location) )
+             + ( std::is_empty_v<internal::error_backtrace> ? 0 : sizeof(internal::error_backtrace) ) );
+
+/**
+ * @brief error_t is trivially relocatable -- its payloads do not refer
+ *        back to it
+ */
+template <>
+  struct is_trivially_relocatable< error_t >
+    : std::true_type
+{};
+
 } // namespace mry
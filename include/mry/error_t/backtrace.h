@@ -0,0 +1,379 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file backtrace.h defines the capture of -- raw -- backtraces of the
+ *       call sites constructing error conditions, symbolized only when
+ *       printed
+ *
+ * `mry::error_t` captures its backtrace when `MRY_ERROR_BACKTRACE` is
+ * defined -- eg. by the `ErrorBacktrace` CMake option -- by either of
+ *
+ *   - `_Unwind_Backtrace` : unwinding by the unwind tables, by default
+ *   - frame pointer walking : when `MRY_ERROR_BACKTRACE_FRAME_POINTERS`
+ *                             is defined, requiring the code being built
+ *                             with `-fno-omit-frame-pointer`
+ *
+ * at most `mry::backtrace_depth` return addresses are captured, into
+ * the inline buffer of `mry::backtrace`, hence capturing neither
+ * allocates nor takes longer than walking as many frames.
+ *
+ * @see: `mry::error_t::trace()`
+ */
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <array>
+#include <span>
+
+#if __has_include(<unwind.h>)
+#  include <unwind.h>
+#endif
+
+#if __has_include(<dlfcn.h>) && __has_include(<cxxabi.h>)
+#  include <cxxabi.h>
+#  include <dlfcn.h>
+#endif
+
+#if defined(MRY_ERROR_BACKTRACE_FRAME_POINTERS) && __has_include(<pthread.h>)
+#  include <pthread.h>
+#endif
+
+#if !defined(MRY_ERROR_BACKTRACE_DEPTH)
+#  define MRY_ERROR_BACKTRACE_DEPTH 8
+#endif
+
+namespace mry {
+
+/**
+ * @brief backtrace_depth denotes the capacity of `mry::backtrace`
+ */
+inline std::size_t constexpr backtrace_depth =
+  MRY_ERROR_BACKTRACE_DEPTH;
+
+namespace internal {
+
+#if defined(MRY_ERROR_BACKTRACE_FRAME_POINTERS) && __has_include(<pthread.h>)
+/**
+ * @brief stack_top returns the upper end of the stack of the calling
+ *        thread -- resolved once per thread
+ */
+inline
+  auto stack_top() noexcept
+    -> std::uintptr_t
+{
+  thread_local auto const top =
+    []
+    {
+      auto attr =
+        pthread_attr_t{};
+      auto base =
+        static_cast<void*>( nullptr );
+      auto size =
+        std::size_t{0};
+
+      if (pthread_getattr_np( pthread_self(), &attr ) != 0)
+        return std::uintptr_t{0};
+
+      pthread_attr_getstack( &attr, &base, &size );
+      pthread_attr_destroy( &attr );
+
+      return reinterpret_cast<std::uintptr_t>(base) + size;
+    }();
+
+  return top;
+}
+
+/**
+ * @brief capture_frames walks the frame pointers of the calling thread
+ *        into `frames`, skipping the innermost `skip` frames
+ *
+ * @note: the walk stops at the first frame pointer not within the stack
+ *        -- or not above its inner one -- hence never faults on frames
+ *        built without frame pointers, only ends early
+ */
+[[gnu::noinline]]
+inline
+  auto capture_frames( std::span<void*> frames, std::size_t skip ) noexcept
+    -> std::size_t
+{
+  auto top =
+    stack_top();
+  auto frame =
+    static_cast<std::uintptr_t*>( __builtin_frame_address(0) );
+  auto n =
+    std::size_t{0};
+
+  while (n < frames.size())
+  {
+    auto address =
+      reinterpret_cast<std::uintptr_t>(frame);
+
+    if (address == 0 || address % alignof(std::uintptr_t) || address + 2 * sizeof(address) > top)
+      break;
+
+    auto next =
+      reinterpret_cast<std::uintptr_t*>( frame[0] );
+
+    if (frame[1] == 0)
+      break;
+
+    if (skip > 0)
+      --skip;
+
+    else
+      frames[n++] = reinterpret_cast<void*>( frame[1] );
+
+    if (reinterpret_cast<std::uintptr_t>(next) <= address)
+      break;
+
+    frame = next;
+  }
+
+  return n;
+}
+#elif __has_include(<unwind.h>)
+/**
+ * @brief capture_frames unwinds the calling thread into `frames`,
+ *        skipping the innermost `skip` frames
+ */
+[[gnu::noinline]]
+inline
+  auto capture_frames( std::span<void*> frames, std::size_t skip ) noexcept
+    -> std::size_t
+{
+  struct walk_type
+  {
+    std::span<void*> frames;
+    std::size_t      skip;
+    std::size_t      n =0;
+  };
+
+  auto walk =
+    walk_type{ frames, skip + 1 };
+
+  _Unwind_Backtrace(
+    []( _Unwind_Context *context, void *state ) -> _Unwind_Reason_Code
+    {
+      auto &walk =
+        *static_cast<walk_type*>(state);
+      auto ip =
+        _Unwind_GetIP( context );
+
+      if (ip == 0)
+        return _URC_END_OF_STACK;
+
+      if (walk.skip > 0)
+        return --walk.skip, _URC_NO_REASON;
+
+      walk.frames[ walk.n++ ] =
+        reinterpret_cast<void*>(ip);
+
+      return walk.n == walk.frames.size() ? _URC_END_OF_STACK
+                                          : _URC_NO_REASON;
+    }
+  , &walk );
+
+  return walk.n;
+}
+#else
+inline
+  auto capture_frames( std::span<void*>, std::size_t ) noexcept
+    -> std::size_t
+{ return 0; }
+#endif
+
+} // namespace internal
+
+/**
+ * @brief backtrace holds the -- raw -- return addresses of at most
+ *        `backtrace_depth` frames, the innermost first
+ */
+class backtrace final
+{
+  public :
+    constexpr backtrace() noexcept
+      =default;
+
+    /**
+     * @brief capture captures the backtrace of its caller
+     */
+    [[gnu::always_inline]]
+    static inline
+      auto capture() noexcept
+        -> backtrace
+    {
+      auto trace =
+        backtrace{};
+
+      trace.size_ =
+        internal::capture_frames( trace.frames_, 0 );
+
+      return trace;
+    }
+
+    /**
+     * @brief frames returns the return addresses captured
+     */
+    inline
+      auto frames() const noexcept
+        -> std::span<void* const>
+    { return { frames_.data(), size_ }; }
+
+    inline
+      auto empty() const noexcept
+        -> bool
+    { return size_ == 0; }
+
+    /**
+     * @brief symbolize returns the backtrace described a frame per line
+     *
+     * ```
+     * #0 0x55d0c0a1b2c3 parse(std::string_view)+0x43 (./service)
+     * ```
+     *
+     * @note: only symbols of the dynamic symbol table are resolved --
+     *        executables should hence be linked by `-rdynamic` -- the
+     *        object and offset printed otherwise suffice `addr2line`
+     */
+    auto symbolize() const
+      -> std::string
+    {
+      auto described =
+        std::string{};
+
+      for (auto i =std::size_t{0}; i < size_; ++i)
+      {
+        char line[64];
+
+        std::snprintf( line, sizeof(line), "#%zu %p", i, frames_[i] );
+        described += line;
+
+#if __has_include(<dlfcn.h>) && __has_include(<cxxabi.h>)
+        auto info =
+          Dl_info{};
+
+        if (::dladdr( frames_[i], &info ) == 0)
+        {
+          described += '\n';
+          continue;
+        }
+
+        if (info.dli_sname)
+        {
+          auto status =
+            0;
+          auto demangled =
+            abi::__cxa_demangle( info.dli_sname, nullptr, nullptr, &status );
+
+          std::snprintf( line, sizeof(line), "+0x%tx"
+                       , static_cast<char*>( frames_[i] ) - static_cast<char*>( info.dli_saddr ) );
+
+          described += ' ';
+          described += status == 0 ? demangled : info.dli_sname;
+          described += line;
+
+          std::free( demangled );
+        }
+
+        else
+        {
+          std::snprintf( line, sizeof(line), " +0x%tx"
+                       , static_cast<char*>( frames_[i] ) - static_cast<char*>( info.dli_fbase ) );
+
+          described += line;
+        }
+
+        if (info.dli_fname)
+          ( described += " (" ).append( info.dli_fname ) += ')';
+#endif
+
+        described += '\n';
+      }
+
+      return described;
+    }
+
+  private :
+    std::array<void*, backtrace_depth> frames_ ={};
+    std::size_t                        size_ =0;
+};
+
+namespace internal {
+
+/**
+ * @brief error_backtrace holds the backtrace of an `mry::error_t` when
+ *        `MRY_ERROR_BACKTRACE` is defined -- nothing otherwise
+ */
+class error_backtrace final
+{
+  public :
+    /**
+     * @brief capture_t tags capturing the backtrace of the caller
+     */
+    struct capture_t final
+    {
+      explicit capture_t() =default;
+    };
+
+    static inline capture_t constexpr capture =
+      capture_t{};
+
+    constexpr error_backtrace() noexcept
+      =default;
+
+#if defined(MRY_ERROR_BACKTRACE)
+    /**
+     * @note: nothing is captured during constant evaluation
+     */
+    [[gnu::always_inline]]
+    constexpr explicit
+      error_backtrace( capture_t ) noexcept
+        : trace_{ std::is_constant_evaluated() ? backtrace{} : backtrace::capture() }
+    {}
+
+    inline
+      auto trace() const noexcept
+        -> backtrace const&
+    { return trace_; }
+
+  private :
+    backtrace trace_;
+#else
+    constexpr explicit error_backtrace( capture_t ) noexcept
+    {}
+
+    inline
+      auto trace() const noexcept
+        -> backtrace const&
+    {
+      static auto constexpr none =
+        backtrace{};
+
+      return none;
+    }
+#endif
+};
+
+} // namespace internal
+} // namespace mry
@@ -0,0 +1,331 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file counters.h defines the {opt-in} counters of the error conditions
+ *       met per call site
+ *
+ * when built with `MRY_ERROR_COUNTERS` defined -- eg. by the `ErrorCounters`
+ * CMake option -- constructing an `mry::error_t`, or a failing
+ * `mry::expect<T, E>` of an error code E, records a hit against the
+ * source location of the expression doing so. otherwise
+ * `internal::call_site` is empty and recording compiles to nothing.
+ *
+ * @see: `mry::error_counts()`
+ */
+#include "mry/error_t/site.h"
+
+#include <source_location>
+#include <type_traits>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <vector>
+#include <array>
+
+namespace mry {
+namespace internal {
+
+/**
+ * @brief error_counters_enabled denotes whether hits are recorded
+ */
+#if defined(MRY_ERROR_COUNTERS)
+inline bool constexpr error_counters_enabled =
+  true;
+#else
+inline bool constexpr error_counters_enabled =
+  false;
+#endif
+
+/**
+ * @brief propagate_t tags constructing a failing `mry::expect<T, E>`
+ *        from an error condition met elsewhere -- not recording a hit
+ */
+struct propagate_t final
+{
+  explicit propagate_t() =default;
+};
+
+inline propagate_t constexpr propagate =
+  propagate_t{};
+
+/**
+ * @brief site_table counts the hits per call site recorded by a
+ *        single thread
+ *
+ * the owner thread is the only writer, publishing the location of a
+ * slot once -- by its file name -- and updating its hits by relaxed
+ * stores, while readers may merge the table at any time without locks
+ *
+ * @note: hits of call sites finding no slot within `max_probes` of
+ *        their hash -- beyond `capacity` distinct call sites at the
+ *        latest -- are counted as `dropped`
+ */
+class site_table final
+{
+  public :
+    static auto constexpr capacity =
+      std::size_t{1024};
+
+    /**
+     * @brief max_probes bounds the slots probed per hit, lest a full
+     *        table scan all of its slots on the failure path
+     */
+    static auto constexpr max_probes =
+      std::size_t{16};
+
+    site_table() noexcept
+      =default;
+
+    site_table( site_table const & )
+      =delete;
+    auto operator=( site_table const & )
+      -> site_table& =delete;
+
+    /**
+     * @brief record records a hit against `where`
+     *
+     * @note: only the owner thread may record
+     */
+    auto record( std::source_location const &where ) noexcept
+      -> void
+    {
+      auto key =
+        where.file_name();
+      auto hash =
+        std::hash<void const*>{}( key ) ^ ( where.line() * 0x9e3779b1u ) ^ where.column();
+
+      for (auto probe =std::size_t{0}; probe < max_probes; ++probe)
+      {
+        auto &slot =
+          slots_[ ( hash + probe ) % capacity ];
+        auto file =
+          slot.file.load( std::memory_order_relaxed );
+
+        if (file == nullptr)
+        {
+          slot.where = where;
+          slot.hits.store( 1, std::memory_order_relaxed );
+          slot.file.store( key, std::memory_order_release );
+
+          return;
+        }
+
+        if (file == key
+         && slot.where.line() == where.line()
+         && slot.where.column() == where.column())
+          return increment( slot.hits );
+      }
+
+      increment( dropped_ );
+    }
+
+    /**
+     * @brief merge_into accumulates the hits of the table into `counts`
+     */
+    auto merge_into( std::vector<std::pair<std::source_location, std::uint64_t>> &counts ) const
+      -> void
+    {
+      for (auto &slot : slots_)
+        if (slot.file.load( std::memory_order_acquire ))
+          counts.emplace_back( slot.where, slot.hits.load( std::memory_order_relaxed ) );
+
+      if (auto dropped =dropped_.load( std::memory_order_relaxed ))
+        counts.emplace_back( std::source_location{}, dropped );
+    }
+
+    /**
+     * @brief claim claims a retired table for the calling thread
+     */
+    auto claim() noexcept
+      -> bool
+    { return retired_.exchange( false, std::memory_order_acquire ); }
+
+    /**
+     * @brief retire releases the table on the exit of its owner thread,
+     *        keeping its hits
+     */
+    auto retire() noexcept
+      -> void
+    { retired_.store( true, std::memory_order_release ); }
+
+    site_table *next =nullptr;
+
+  private :
+    /**
+     * @brief increment increments `hits` by its only writer
+     */
+    static auto increment( std::atomic<std::uint64_t> &hits ) noexcept
+      -> void
+    { hits.store( hits.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed ); }
+
+    struct slot_type
+    {
+      std::atomic<char const*>   file =nullptr;
+      std::source_location       where;
+      std::atomic<std::uint64_t> hits =0;
+    };
+
+    std::array<slot_type, capacity> slots_;
+    std::atomic<std::uint64_t>      dropped_ =0;
+    std::atomic<bool>               retired_ =false;
+};
+
+/**
+ * @brief site_tables denotes the head of the -- push only -- list of
+ *        the tables of all threads ever recording
+ */
+inline constinit auto site_tables =
+  std::atomic<site_table*>{ nullptr };
+
+/**
+ * @brief acquire_site_table claims a table retired by an exited thread
+ *        or pushes a new one
+ */
+inline
+  auto acquire_site_table()
+    -> site_table*
+{
+  for (auto table =site_tables.load( std::memory_order_acquire ); table; table = table->next)
+    if (table->claim())
+      return table;
+
+  auto table =
+    new site_table{};
+
+  table->next =
+    site_tables.load( std::memory_order_relaxed );
+
+  while (!site_tables.compare_exchange_weak( table->next, table
+                                           , std::memory_order_release
+                                           , std::memory_order_relaxed ))
+  {}
+
+  return table;
+}
+
+/**
+ * @brief this_thread_sites returns the table of the calling thread
+ *
+ * @note: tables are never freed, only retired and reused by later
+ *        threads, hence their hits outlive the threads recording them
+ */
+inline
+  auto this_thread_sites()
+    -> site_table&
+{
+  struct owner
+  {
+    site_table *table =
+      acquire_site_table();
+
+    ~owner() noexcept
+    { table->retire(); }
+  };
+
+  thread_local auto sites =
+    owner{};
+
+  return *sites.table;
+}
+
+/**
+ * @brief record_error records a hit against `site` when error counters
+ *        are enabled -- compiling to nothing otherwise
+ *
+ * @note: hits met during constant evaluation are not recorded
+ */
+constexpr
+  auto record_error( [[maybe_unused]] call_site const &site ) noexcept
+    -> void
+{
+#if defined(MRY_ERROR_COUNTERS)
+  if (! std::is_constant_evaluated())
+    this_thread_sites().record( site.where() );
+#endif
+}
+
+} // namespace internal
+
+/**
+ * @brief error_count describes the hits of a call site
+ *
+ * @note: hits beyond the capacity of the per-thread tables are
+ *        counted against a default constructed `std::source_location`
+ */
+struct error_count
+{
+  std::source_location where;
+  std::uint64_t        hits =0;
+};
+
+/**
+ * @brief error_counts returns a snapshot of the hits per call site merged
+ *        over all threads -- the most hit call site first
+ *
+ * @note: the hits are monotonic, hence the difference of two snapshots
+ *        denotes the hits in between
+ */
+inline
+  auto error_counts()
+    -> std::vector<error_count>
+{
+  auto counts =
+    std::vector<std::pair<std::source_location, std::uint64_t>>{};
+
+  for (auto table =internal::site_tables.load( std::memory_order_acquire ); table; table = table->next)
+    table->merge_into( counts );
+
+  auto before =
+    []( std::source_location const &a, std::source_location const &b )
+    {
+      if (auto order =std::strcmp( a.file_name(), b.file_name() ))
+        return order < 0;
+
+      if (a.line() != b.line())
+        return a.line() < b.line();
+
+      return a.column() < b.column();
+    };
+
+  std::ranges::sort( counts, before, &decltype(counts)::value_type::first );
+
+  auto merged =
+    std::vector<error_count>{};
+
+  for (auto &[where, hits] : counts)
+  {
+    if (!merged.empty() && !before( merged.back().where, where ))
+      merged.back().hits += hits;
+
+    else
+      merged.push_back({ where, hits });
+  }
+
+  std::ranges::stable_sort( merged, std::greater{}, &error_count::hits );
+
+  return merged;
+}
+
+} // namespace mry
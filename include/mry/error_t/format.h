@@ -0,0 +1,340 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file format.h defines the deferred payloads an `mry::error_t` may refer
+ *       to -- capturing the arguments of a description, rendering it only
+ *       when read
+ *
+ * @see: `mry::error_t`
+ */
+#include "mry/error_t/resource.h"
+#include "mry/error_t/counters.h"
+#include "mry/error_t/payload.h"
+
+#include <memory_resource>
+#include <system_error>
+#include <string_view>
+#include <type_traits>
+#include <algorithm>
+#include <concepts>
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <mutex>
+#include <new>
+
+namespace mry {
+
+/**
+ * @brief max_format_args denotes the capacity of the arguments captured
+ *        by a deferred description
+ */
+inline std::size_t constexpr max_format_args =
+  6;
+
+namespace internal {
+
+/**
+ * @brief format_chars holds a copy of the char array captured -- up to
+ *        its first NUL -- within the payload capturing it
+ *
+ * @note: string literals and arrays of automatic storage duration bind
+ *        alike, the latter dangling once out of scope should they be
+ *        referred to by their address
+ */
+template <std::size_t N>
+  struct format_chars final
+{
+  format_chars( char const (&chars)[N] ) noexcept
+    : size{ static_cast<std::size_t>( std::find( chars, chars + N, '\0' ) - chars ) }
+  { std::copy_n( chars, size, text ); }
+
+  operator std::string_view() const noexcept
+  { return { text, size }; }
+
+  std::size_t size;
+  char        text[N];
+};
+
+/**
+ * @brief format_arg maps the type of an argument captured to the type
+ *        it is stored as :
+ *
+ *   - arithmetic types are stored by value
+ *   - char arrays -- string literals among them -- are copied into the
+ *     payload
+ *   - `std::string`s are taken ownership of
+ */
+template <typename T>
+  struct format_arg
+{};
+
+template <typename T>
+  requires std::is_arithmetic_v<T>
+  struct format_arg< T >
+{ using type = T; };
+
+template <std::size_t N>
+  struct format_arg< char const (&)[N] >
+{ using type = format_chars<N>; };
+
+template <>
+  struct format_arg< std::string >
+{ using type = std::string; };
+
+template <typename T>
+  using format_arg_t =
+    typename format_arg< std::conditional_t< std::is_array_v<std::remove_reference_t<T>>
+                                           , T
+                                           , std::remove_cvref_t<T> > >::type;
+
+/**
+ * @brief render_arg appends the textual representation of `arg` to `out`
+ */
+template <typename T>
+  auto render_arg( std::pmr::string &out, T const &arg )
+    -> void
+{
+  if constexpr (std::is_same_v<T, char>)
+    out.push_back( arg );
+
+  else if constexpr (std::is_same_v<T, bool>)
+    out.append( arg ? "true" : "false" );
+
+  else if constexpr (std::is_arithmetic_v<T>)
+  {
+    char buffer[32];
+
+    auto [end, ec] =
+      std::to_chars( buffer, buffer + sizeof(buffer), arg );
+
+    out.append( buffer, ec == std::errc{} ? end : buffer );
+  }
+
+  else
+    out.append( std::string_view{ arg } );
+}
+
+/**
+ * @brief render appends `format` to `out` substituting its `{}`
+ *        placeholders by `args` -- in order
+ *
+ * @note: `{{` and `}}` denote literal braces, surplus placeholders
+ *        are rendered verbatim while surplus arguments are ignored
+ */
+template <typename ...Args>
+  auto render( std::pmr::string &out, std::string_view format, Args const &...args )
+    -> void
+{
+  /* advance appends `format` up to its next placeholder consuming it,
+   * yielding whether there was any */
+  auto advance =
+    [&]()
+      -> bool
+    {
+      while (!format.empty())
+      {
+        auto brace =
+          format.find_first_of( "{}" );
+
+        out.append( format.substr( 0, brace ) );
+
+        if (brace == std::string_view::npos)
+          break;
+
+        auto c =
+          format[brace];
+        auto placeholder =
+          format.substr( brace, 2 ) == "{}";
+        auto escaped =
+          !placeholder && format.substr( brace + 1, 1 ) == std::string_view{ &c, 1 };
+
+        format.remove_prefix( brace + ( placeholder || escaped ? 2 : 1 ) );
+
+        if (placeholder)
+          return true;
+
+        out.push_back( c );
+      }
+
+      format = {};
+      return false;
+    };
+
+  ( ( advance() ? render_arg( out, args ) : void() ), ... );
+
+  while (advance())
+    out.append( "{}" );
+}
+
+/**
+ * @brief format_payload describes an error condition by a format string
+ *        and its captured arguments -- the description is rendered on
+ *        the first `what()` and cached
+ *
+ * @note: rendering happens once, concurrent first reads of the same
+ *        payload wait for the one rendering it
+ */
+template <typename ...Args>
+  struct format_payload final
+    : error_payload
+{
+  static_assert( sizeof...(Args) <= max_format_args
+               , "deferred descriptions capture at most `max_format_args` arguments" );
+
+  /**
+   * @brief make allocates a payload capturing `format` and `args`
+   */
+  template <typename ...Ts>
+    static
+      auto make( std::string_view format, Ts &&...args )
+        -> format_payload*
+  {
+    auto [storage, resource] =
+      allocate_payload( sizeof(format_payload), alignof(format_payload) );
+
+    return ::new (storage) format_payload{ resource, format, std::forward<Ts>(args)... };
+  }
+
+  auto clone() const
+    -> error_payload* override
+  {
+    return std::apply( [this]( auto const &...args )
+                       { return make( format_, args... ); }
+                     , args_ );
+  }
+
+  /**
+   * @note: should rendering fail to allocate, the format string itself
+   *        describes the error condition
+   *
+   * @note: the rendering never throws out of `std::call_once`, libstdc++
+   *        leaving the flag locked should it do so
+   */
+  auto what() const noexcept
+    -> std::string_view override
+  {
+    std::call_once( once_, [this]() noexcept
+                           {
+                             try
+                             {
+                               /* @note: reserving for the common case of short arguments
+                                *        spares the reallocations of appending */
+                               rendered_.reserve( format_.size() + sizeof...(Args) * 16 );
+
+                               std::apply( [this]( auto const &...args )
+                                           { render( rendered_, format_, args... ); }
+                                         , args_ );
+                             }
+
+                             catch (...)
+                             { unrendered_ = true; }
+                           } );
+
+    if (unrendered_)
+      return format_;
+
+    return rendered_;
+  }
+
+  auto release() noexcept
+    -> void override
+  {
+    auto resource =
+      resource_;
+
+    this->~format_payload();
+
+    deallocate_payload( this, sizeof(format_payload), alignof(format_payload), resource );
+  }
+
+  private :
+    template <typename ...Ts>
+      format_payload( std::pmr::memory_resource *resource
+                    , std::string_view format
+                    , Ts &&...args )
+        : resource_{ resource }
+        , format_{ format }
+        , args_{ std::forward<Ts>(args)... }
+        , rendered_{ resource ? resource : std::pmr::new_delete_resource() }
+    {}
+
+    ~format_payload() noexcept
+      =default;
+
+    std::pmr::memory_resource *resource_;
+    std::string_view           format_;
+    std::tuple<Args...>        args_;
+    mutable std::pmr::string   rendered_;
+    mutable std::once_flag     once_;
+    mutable bool               unrendered_ =false;
+};
+
+/**
+ * @brief literal_string refers to a string literal -- or any array of
+ *        static storage duration -- describing an error condition
+ *
+ * @note: constructed only in constant evaluation, hence arrays of
+ *        automatic storage duration -- dangling once out of scope --
+ *        are rejected at compile time
+ */
+struct literal_string final
+{
+  template <std::size_t N>
+    consteval literal_string( char const (&literal)[N] ) noexcept
+      : text{ literal }
+  {}
+
+  char const *text;
+};
+
+/**
+ * @brief format_string refers to the format string of a deferred
+ *        description along with the call site constructing it
+ *
+ * @see: `literal_string`
+ */
+struct format_string final
+{
+  template <std::size_t N>
+    consteval format_string( char const (&format)[N], call_site where ={} ) noexcept
+      : text{ format }
+      , site{ where }
+  {}
+
+  std::string_view text;
+  call_site        site;
+};
+
+} // namespace internal
+
+/**
+ * @brief format_argument concept describes the arguments a deferred
+ *        description may capture
+ *
+ * @see: `internal::format_arg`
+ */
+template <typename T>
+  concept format_argument =
+    requires { typename internal::format_arg_t<T>; };
+
+} // namespace mry
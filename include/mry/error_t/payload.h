@@ -0,0 +1,171 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file payload.h defines the lazily allocated, dynamic payloads an
+ *       `mry::error_t` may refer to
+ *
+ * @see: `mry::error_t`
+ */
+#include "mry/error_t/resource.h"
+#include "mry/error_code.h"
+
+#include <string_view>
+#include <cstring>
+#include <cstddef>
+#include <new>
+
+namespace mry::internal {
+
+/**
+ * @brief error_payload describes the {dynamically allocated} description
+ *        of an error condition which could not be referred to statically
+ *
+ * payloads are allocated from the error resource of the thread
+ * constructing them.
+ *
+ * @note: instances are always allocated with at least `alignof(error_payload)`
+ *        alignment leaving the low bits of their addresses available for
+ *        tagging by `mry::error_t`
+ *
+ * @see: `mry::error_resource()`
+ */
+struct error_payload
+{
+  /**
+   * @brief clone returns a deep copy of the payload
+   */
+  virtual auto clone() const
+    -> error_payload* =0;
+
+  /**
+   * @brief what returns the {weakly typed} description of the error condition
+   */
+  virtual auto what() const noexcept
+    -> std::string_view =0;
+
+  /**
+   * @brief release destroys the payload deallocating its storage
+   */
+  virtual auto release() noexcept
+    -> void =0;
+
+  protected :
+    ~error_payload() noexcept
+      =default;
+};
+
+static_assert( alignof(error_payload) >= 8
+             , "error_t requires 3 low bits of payload addresses for tagging" );
+
+/**
+ * @brief message_payload describes an error condition by a dynamically
+ *        constructed message -- stored inline, following the payload
+ */
+struct message_payload final
+  : error_payload
+{
+  /**
+   * @brief make allocates a payload describing the error condition by
+   *        a copy of `m`
+   */
+  static
+    auto make( std::string_view m )
+      -> message_payload*
+  {
+    auto [storage, resource] =
+      allocate_payload( bytes( m.size() ), alignof(message_payload) );
+    auto payload =
+      ::new (storage) message_payload{ resource, m.size() };
+
+    std::memcpy( payload->text(), m.data(), m.size() );
+    payload->text()[ m.size() ] = '\0';
+
+    return payload;
+  }
+
+  auto clone() const
+    -> error_payload* override
+  { return make( what() ); }
+
+  auto what() const noexcept
+    -> std::string_view override
+  { return { text(), size_ }; }
+
+  auto release() noexcept
+    -> void override
+  {
+    auto resource =
+      resource_;
+    auto allocated =
+      bytes( size_ );
+
+    this->~message_payload();
+
+    deallocate_payload( this, allocated, alignof(message_payload), resource );
+  }
+
+  private :
+    message_payload( std::pmr::memory_resource *resource, std::size_t s ) noexcept
+      : resource_{ resource }
+      , size_{ s }
+    {}
+
+    ~message_payload() noexcept
+      =default;
+
+    /**
+     * @brief bytes returns the size of the storage of a payload
+     *        describing a message of `size` characters
+     */
+    static constexpr
+      auto bytes( std::size_t size ) noexcept
+        -> std::size_t
+    { return sizeof(message_payload) + size + 1; }
+
+    inline
+      auto text() noexcept
+        -> char*
+    { return reinterpret_cast<char*>( this + 1 ); }
+
+    inline
+      auto text() const noexcept
+        -> char const*
+    { return reinterpret_cast<char const*>( this + 1 ); }
+
+    std::pmr::memory_resource *resource_;
+    std::size_t                size_;
+};
+
+/**
+ * @brief constant_payload describes an error condition met during
+ *        constant evaluation -- where addresses cannot be tagged
+ *
+ * constant payloads are allocated by `new` within the evaluation,
+ * hence an `mry::error_t` referring to one cannot outlive it : the
+ * result of a constant expression shall not refer to such allocations
+ */
+struct constant_payload final
+{
+  std::string_view  message;
+  code_entry const *code;
+};
+
+} // namespace mry::internal
@@ -0,0 +1,205 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file resource.h defines the memory resources the dynamic payloads of
+ *       `mry::error_t` are allocated from
+ *
+ * @see: `mry::error_resource()`
+ * @see: `mry::set_error_resource()`
+ */
+#include <memory_resource>
+#include <cstddef>
+#include <utility>
+#include <new>
+
+namespace mry {
+namespace internal {
+
+/**
+ * @brief error_resource_slot returns the error resource of the calling
+ *        thread -- null denoting the global `operator new`
+ */
+inline
+  auto error_resource_slot() noexcept
+    -> std::pmr::memory_resource*&
+{
+  thread_local constinit std::pmr::memory_resource *resource =nullptr;
+
+  return resource;
+}
+
+/**
+ * @brief allocate_payload allocates `size` bytes aligned to `alignment`
+ *        from the error resource of the calling thread, returning the
+ *        storage along with the resource to deallocate it by
+ */
+inline
+  auto allocate_payload( std::size_t size, std::size_t alignment )
+    -> std::pair< void*, std::pmr::memory_resource* >
+{
+  auto resource =
+    error_resource_slot();
+
+  if (resource == nullptr)
+    return { ::operator new( size, std::align_val_t{ alignment } ), nullptr };
+
+  return { resource->allocate( size, alignment ), resource };
+}
+
+/**
+ * @brief deallocate_payload deallocates `storage` allocated by
+ *        `allocate_payload`
+ */
+inline
+  auto deallocate_payload( void *storage
+                         , std::size_t size
+                         , std::size_t alignment
+                         , std::pmr::memory_resource *resource ) noexcept
+    -> void
+{
+  if (resource == nullptr)
+    return ::operator delete( storage, size, std::align_val_t{ alignment } );
+
+  resource->deallocate( storage, size, alignment );
+}
+
+} // namespace internal
+
+/**
+ * @brief error_resource returns the memory resource the dynamic payloads
+ *        of `mry::error_t`s constructed by the calling thread are
+ *        allocated from
+ */
+inline
+  auto error_resource() noexcept
+    -> std::pmr::memory_resource*
+{
+  auto resource =
+    internal::error_resource_slot();
+
+  return resource ? resource
+                  : std::pmr::new_delete_resource();
+}
+
+/**
+ * @brief set_error_resource sets the memory resource the dynamic payloads
+ *        of `mry::error_t`s constructed by the calling thread are
+ *        allocated from, returning the former one
+ *
+ * @note: it is the responsibility of the caller to ensure `resource`
+ *        outlives any payloads allocated from it
+ */
+inline
+  auto set_error_resource( std::pmr::memory_resource *resource ) noexcept
+    -> std::pmr::memory_resource*
+{
+  auto former =
+    std::exchange( internal::error_resource_slot()
+                 , resource == std::pmr::new_delete_resource() ? nullptr
+                                                               : resource );
+
+  return former ? former
+                : std::pmr::new_delete_resource();
+}
+
+/**
+ * @brief basic_error_arena installs a -- request scoped -- `Resource` as
+ *        the error resource of the calling thread for its lifetime
+ *
+ * ```cpp
+ * auto arena =
+ *   mry::error_arena{};
+ *
+ * for (auto &request : requests)
+ * {
+ *   handle( request );
+ *   arena.release();
+ * }
+ * ```
+ *
+ * @note: it is the responsibility of the caller to ensure no payloads
+ *        allocated from the arena outlive it or its `release()`
+ */
+template <typename Resource>
+  class basic_error_arena final
+{
+  public :
+    /**
+     * @brief constructs `Resource` from `args` installing it
+     */
+    template <typename ...Args>
+      explicit
+        basic_error_arena( Args &&...args )
+          : resource_{ std::forward<Args>(args)... }
+          , former_{ set_error_resource( &resource_ ) }
+    {}
+
+    basic_error_arena( basic_error_arena const & )
+      =delete;
+    auto operator=( basic_error_arena const & )
+      -> basic_error_arena& =delete;
+
+    /**
+     * @brief restores the former error resource
+     */
+    ~basic_error_arena() noexcept
+    { set_error_resource( former_ ); }
+
+    /**
+     * @brief release releases all payloads allocated from the arena
+     *        in bulk
+     */
+    inline
+      auto release() noexcept
+        -> void
+    { resource_.release(); }
+
+    /**
+     * @brief resource returns the underlying memory resource
+     */
+    inline
+      auto resource() noexcept
+        -> Resource&
+    { return resource_; }
+
+  private :
+    Resource                   resource_;
+    std::pmr::memory_resource *former_;
+};
+
+/**
+ * @brief error_arena is a monotonic -- bump allocating -- arena
+ */
+using error_arena =
+  basic_error_arena< std::pmr::monotonic_buffer_resource >;
+
+/**
+ * @brief error_pool is a pooling arena reusing the storage of
+ *        released payloads
+ *
+ * @note: payloads free themselves into the pool they came from, so
+ *        the pool is synchronized letting errors be released on any
+ *        thread while the installing one keeps allocating
+ */
+using error_pool =
+  basic_error_arena< std::pmr::synchronized_pool_resource >;
+
+} // namespace mry
@@ -0,0 +1,105 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file site.h defines the capture of the call sites constructing error
+ *       conditions
+ *
+ * capturing is enabled by either of
+ *
+ *   - `MRY_ERROR_COUNTERS` : counting the hits per call site
+ *                            -- see `mry::error_counts()`
+ *   - `MRY_ERROR_LOCATION` : holding the call site in `mry::error_t`
+ *                            -- see `mry::error_t::where()`
+ */
+#include <source_location>
+
+namespace mry::internal {
+
+/**
+ * @brief call_site captures the source location of the expression
+ *        constructing an error condition -- when capturing is enabled
+ *
+ * @note: taken as a defaulted trailing argument, the location captured
+ *        is that of the caller
+ */
+class call_site final
+{
+  public :
+#if defined(MRY_ERROR_COUNTERS) || defined(MRY_ERROR_LOCATION)
+    constexpr call_site( std::source_location where =std::source_location::current() ) noexcept
+      : where_{ where }
+    {}
+
+    inline constexpr
+      auto where() const noexcept
+        -> std::source_location
+    { return where_; }
+
+  private :
+    std::source_location where_;
+#else
+    constexpr call_site() noexcept
+      =default;
+
+    inline constexpr
+      auto where() const noexcept
+        -> std::source_location
+    { return {}; }
+#endif
+};
+
+/**
+ * @brief error_location holds the call site of an `mry::error_t` when
+ *        `MRY_ERROR_LOCATION` is defined -- nothing otherwise
+ *
+ * @note: `std::source_location` refers to its {static} data by a single
+ *        pointer, hence holding it costs a word and no allocation
+ */
+class error_location final
+{
+  public :
+    constexpr error_location() noexcept
+      =default;
+
+#if defined(MRY_ERROR_LOCATION)
+    constexpr explicit error_location( call_site site ) noexcept
+      : where_{ site.where() }
+    {}
+
+    inline constexpr
+      auto where() const noexcept
+        -> std::source_location
+    { return where_; }
+
+  private :
+    std::source_location where_;
+#else
+    constexpr explicit error_location( call_site ) noexcept
+    {}
+
+    inline constexpr
+      auto where() const noexcept
+        -> std::source_location
+    { return {}; }
+#endif
+};
+
+} // namespace mry::internal
@@ -0,0 +1,299 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file executor.h defines a work-stealing executor of jobs whose results
+ *       are carried by `mry::expect<T, E>` -- rather than raised
+ *
+ * ```cpp
+ * auto pool =
+ *   mry::executor{};
+ *
+ * auto parsed =
+ *   pool.submit( [=]{ return my_atoi( line ); } )
+ *       .then( []( int v ){ return v * 2; } );
+ * ```
+ *
+ * @see: `mry::executor`
+ * @see: `mry::future<T, E>`
+ */
+#include "mry/executor/future.h"
+#include "mry/executor/job.h"
+#include "mry/expect.h"
+
+#include <condition_variable>
+#include <type_traits>
+#include <stop_token>
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+namespace mry {
+
+/**
+ * @brief executor runs jobs on a fixed set of worker threads, each
+ *        owning a deque of jobs :
+ *
+ *   - jobs submitted by a worker are pushed to and popped from the back
+ *     of its own deque -- {LIFO}, favouring locality
+ *   - jobs submitted by other threads are distributed round-robin
+ *   - idle workers steal from the front of the deques of others
+ *
+ * @note: jobs still queued on destruction are run before the workers join
+ */
+class executor final
+{
+    /**
+     * @brief worker describes the deque of jobs owned by a worker thread
+     */
+    struct worker
+    {
+      std::mutex                              mutex;
+      std::deque< std::unique_ptr<internal::job> > jobs;
+    };
+
+    /**
+     * @brief current describes the executor and index of the worker the
+     *        calling thread runs -- if any
+     */
+    struct current
+    {
+      executor    *owner =nullptr;
+      std::size_t  index =0;
+    };
+
+  public :
+    /**
+     * @brief constructs the executor running `threads` workers
+     */
+    explicit
+      executor( std::size_t threads =std::max( 1u, std::thread::hardware_concurrency() ) )
+    {
+      threads =
+        std::max( std::size_t{1}, threads );
+
+      workers_.reserve( threads );
+
+      for (auto i =std::size_t{0}; i < threads; ++i)
+        workers_.push_back( std::make_unique<worker>() );
+
+      threads_.reserve( threads );
+
+      for (auto i =std::size_t{0}; i < threads; ++i)
+        threads_.emplace_back( [this, i]( std::stop_token stop ){ run( i, stop ); } );
+    }
+
+    executor( executor const & )
+      =delete;
+    auto operator=( executor const & )
+      -> executor& =delete;
+
+    /**
+     * @brief stops the workers once no jobs remain queued
+     *
+     * @note: stopping a `std::jthread` wakes it up from waiting on
+     *        `wake_` by its stop token
+     */
+    ~executor() noexcept
+    { threads_.clear(); }
+
+    /**
+     * @brief threads returns the number of worker threads
+     */
+    inline
+      auto threads() const noexcept
+        -> std::size_t
+    { return workers_.size(); }
+
+    /**
+     * @brief submit schedules the invocation of `f`, returning the
+     *        future of its result
+     *
+     * `f` may return either a plain T -- `void` included -- or an
+     * `mry::expect<T, E>`, the former never denoting an error condition.
+     *
+     * @note: `f` is required not to throw
+     */
+    template <typename F>
+      auto submit( F f )
+        -> internal::future_of_t< std::invoke_result_t<F&> >
+    {
+      using future_type =
+        internal::future_of_t< std::invoke_result_t<F&> >;
+      using state_type =
+        internal::shared_state< typename future_type::success_type
+                              , typename future_type::fail_type >;
+
+      auto state =
+        std::make_shared<state_type>();
+
+      push( internal::make_job( [state, f =std::move(f)]() mutable
+                                {
+                                  if constexpr (std::is_void_v< std::invoke_result_t<F&> >)
+                                  {
+                                    std::invoke( f );
+                                    state->complete( expect<void>{} );
+                                  }
+                                  else
+                                    state->complete( std::invoke( f ) );
+                                } ) );
+
+      return future_type{ std::move(state) };
+    }
+
+  private :
+    inline static
+      auto this_worker() noexcept
+        -> current&
+    {
+      thread_local constinit current self{};
+
+      return self;
+    }
+
+    /**
+     * @brief push queues `j`, waking an idle worker -- if any
+     */
+    auto push( std::unique_ptr<internal::job> j )
+      -> void
+    {
+      auto self =
+        this_worker();
+      auto index =
+        self.owner == this ? self.index
+                           : next_.fetch_add( 1, std::memory_order_relaxed ) % workers_.size();
+
+      /* @note: `queued_` is incremented ahead of queueing so it never
+       *        underflows, `queued_` and `sleeping_` being accessed
+       *        sequentially consistent on both sides either the pusher
+       *        observes the sleeper or the sleeper observes the job */
+      queued_.fetch_add( 1 );
+      {
+        auto lock =
+          std::scoped_lock{ workers_[index]->mutex };
+
+        workers_[index]->jobs.push_back( std::move(j) );
+      }
+
+      if (sleeping_.load() > 0)
+      {
+        {
+          auto lock =
+            std::scoped_lock{ sleep_mutex_ };
+        }
+
+        wake_.notify_one();
+      }
+    }
+
+    /**
+     * @brief pop pops a job from the back of the deque of the worker at
+     *        `index` -- stealing from the front of the others otherwise
+     */
+    auto pop( std::size_t index )
+      -> std::unique_ptr<internal::job>
+    {
+      auto take =
+        [this]( std::size_t i, bool back )
+          -> std::unique_ptr<internal::job>
+        {
+          auto &w =
+            *workers_[i];
+          auto lock =
+            std::scoped_lock{ w.mutex };
+
+          if (w.jobs.empty())
+            return nullptr;
+
+          auto j =
+            std::move( back ? w.jobs.back() : w.jobs.front() );
+
+          back ? w.jobs.pop_back()
+               : w.jobs.pop_front();
+
+          queued_.fetch_sub( 1 );
+
+          return j;
+        };
+
+      if (auto j =take( index, true ))
+        return j;
+
+      for (auto k =std::size_t{1}; k < workers_.size(); ++k)
+        if (auto j =take( ( index + k ) % workers_.size(), false ))
+          return j;
+
+      return nullptr;
+    }
+
+    /**
+     * @brief run runs the worker at `index` until stopped with no jobs
+     *        remaining
+     */
+    auto run( std::size_t index, std::stop_token stop )
+      -> void
+    {
+      this_worker() =
+        current{ this, index };
+
+      for (;;)
+      {
+        if (auto j =pop( index ))
+        {
+          j->run();
+          continue;
+        }
+
+        auto lock =
+          std::unique_lock{ sleep_mutex_ };
+
+        sleeping_.fetch_add( 1 );
+
+        auto woken =
+          wake_.wait( lock, stop, [this]{ return queued_.load() > 0; } );
+
+        sleeping_.fetch_sub( 1 );
+
+        if (!woken && queued_.load() == 0)
+          return;
+      }
+    }
+
+    std::vector< std::unique_ptr<worker> > workers_;
+
+    std::atomic<std::size_t>     next_ =0;
+    std::atomic<std::size_t>     queued_ =0;
+    std::atomic<std::size_t>     sleeping_ =0;
+    std::mutex                   sleep_mutex_;
+    std::condition_variable_any  wake_;
+
+    /* @note: declared last, hence the workers are joined before any
+     *        member they touch is destroyed -- also when constructing
+     *        them throws part-way */
+    std::vector< std::jthread > threads_;
+};
+
+} // namespace mry
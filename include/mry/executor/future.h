@@ -0,0 +1,280 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file future.h defines the handles to the eventual results of jobs
+ *       scheduled by an `mry::executor` -- carrying `mry::expect<T, E>`
+ *       rather than `std::exception_ptr`
+ *
+ * @see: `mry::future<T, E>`
+ */
+#include "mry/executor/job.h"
+#include "mry/expect.h"
+
+#include <type_traits>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <atomic>
+#include <memory>
+
+namespace mry {
+
+template <typename T, typename E>
+  class future;
+
+namespace internal {
+
+/**
+ * @brief shared_state describes the eventual result shared by the job
+ *        completing it and the `future<T, E>` referring to it
+ *
+ * at most a single continuation may be chained, which is run by the
+ * thread completing the result -- or by the thread chaining it when
+ * the result is already completed.
+ */
+template <typename T, typename E>
+  class shared_state final
+{
+    enum class status_type : unsigned char
+    {
+      pending,
+      chained,
+      completed
+    };
+
+  public :
+    /**
+     * @brief complete completes the state by `r`, running the chained
+     *        continuation -- if any -- inline
+     */
+    auto complete( expect<T, E> &&r ) noexcept
+      -> void
+    {
+      result_.emplace( std::move(r) );
+
+      if (status_.exchange( status_type::completed, std::memory_order_acq_rel )
+          == status_type::chained)
+        continuation_->run();
+
+      status_.notify_all();
+    }
+
+    /**
+     * @brief chain chains the continuation `j` -- running it inline
+     *        when the state is already completed
+     */
+    auto chain( std::unique_ptr<job> j ) noexcept
+      -> void
+    {
+      continuation_ =
+        std::move(j);
+
+      auto expected =
+        status_type::pending;
+
+      if (!status_.compare_exchange_strong( expected
+                                          , status_type::chained
+                                          , std::memory_order_acq_rel ))
+        continuation_->run();
+    }
+
+    inline
+      auto ready() const noexcept
+        -> bool
+    { return status_.load( std::memory_order_acquire ) == status_type::completed; }
+
+    /**
+     * @brief wait blocks the calling thread until the state is completed
+     */
+    auto wait() const noexcept
+      -> void
+    {
+      for (auto s =status_.load( std::memory_order_acquire ); s != status_type::completed
+          ; s = status_.load( std::memory_order_acquire ))
+        status_.wait( s, std::memory_order_acquire );
+    }
+
+    /**
+     * @brief result returns the completed result
+     *
+     * @note: it is the responsibility of the caller to ensure the
+     *        state is completed
+     */
+    inline
+      auto result() noexcept
+        -> expect<T, E>&
+    { return *result_; }
+
+  private :
+    std::atomic<status_type>     status_ =status_type::pending;
+    std::optional<expect<T, E>>  result_;
+    std::unique_ptr<job>         continuation_;
+};
+
+/**
+ * @brief future_of maps the result R of a job submitted to the
+ *        `future<T, E>` referring to it -- plain results meaning no
+ *        error conditions described by `mry::error_t`
+ *
+ * @note: continuations chained by `future<T, E>::then()` keep the E of
+ *        the future instead
+ */
+template <typename R>
+  struct future_of
+{ using type = future< R, error_t >; };
+
+template <typename T, typename E>
+  struct future_of< expect<T, E> >
+{ using type = future< T, E >; };
+
+template <typename R>
+  using future_of_t =
+    typename future_of< std::remove_cvref_t<R> >::type;
+
+} // namespace internal
+
+/**
+ * @brief future<T, E> is a handle to the eventual `mry::expect<T, E>`
+ *        yielded by a job scheduled by an `mry::executor`
+ *
+ * error conditions travel as plain values of E, no exceptions are
+ * raised, captured or rethrown.
+ *
+ * @note: futures are single consumer -- `get()` and `then()` consume
+ *        the result
+ *
+ * @see: `mry::executor::submit()`
+ */
+template <typename T, typename E =error_t>
+  class future final
+{
+    using state_type =
+      internal::shared_state<T, E>;
+
+  public :
+    using success_type =
+      T;
+    using fail_type =
+      E;
+
+    future() noexcept
+      =default;
+
+    explicit
+      future( std::shared_ptr<state_type> state ) noexcept
+        : state_{ std::move(state) }
+    {}
+
+    /**
+     * @brief valid predicate tests whether the instance refers to
+     *        an eventual result
+     */
+    inline
+      auto valid() const noexcept
+        -> bool
+    { return state_ != nullptr; }
+
+    /**
+     * @brief ready predicate tests whether the eventual result is
+     *        completed
+     */
+    inline
+      auto ready() const noexcept
+        -> bool
+    { return state_->ready(); }
+
+    /**
+     * @brief wait blocks the calling thread until the result is completed
+     *
+     * @note: blocking a thread of an `mry::executor` on a future of
+     *        the same executor may deadlock, chain by `then()` instead
+     */
+    inline
+      auto wait() const noexcept
+        -> void
+    { state_->wait(); }
+
+    /**
+     * @brief get returns the completed result -- blocking the calling
+     *        thread until completed
+     *
+     * @see: `wait()`
+     */
+    inline
+      auto get()
+        -> expect<T, E>
+    {
+      wait();
+
+      return std::move( std::exchange( state_, nullptr )->result() );
+    }
+
+    /**
+     * @brief then returns the future of invoking `f` with the expected
+     *        result type T -- propagating the error conditions met
+     *
+     * `f` may return either a plain U or an `mry::expect<U, E>`, just as
+     * `mry::expect<T, E>::transform()` or `and_then()` respectively --
+     * invoked with no arguments given T is `void`. A plain U yields a
+     * `future<U, E>`, keeping the error conditions of the instance.
+     *
+     * @note: `f` runs inline, either on the thread completing the result
+     *        or on the calling one when already completed
+     */
+    template <typename F>
+      auto then( F f )
+    {
+      using result_type =
+        internal::success_result_t< expect<T, E>, F& >;
+      using future_type =
+        internal::future_of_t< std::conditional_t< internal::is_expect_v<result_type>
+                                                 , result_type
+                                                 , expect< std::remove_cvref_t<result_type>, E > > >;
+      using next_state_type =
+        internal::shared_state< typename future_type::success_type
+                              , typename future_type::fail_type >;
+
+      auto next =
+        std::make_shared<next_state_type>();
+      auto state =
+        std::exchange( state_, nullptr );
+
+      /* @note: the continuation refers to the state owning it by address,
+       *        kept alive by whichever thread runs it -- either the job
+       *        completing the state or the calling one */
+      state->chain( internal::make_job(
+        [state =state.get(), next, f =std::move(f)]() mutable
+        {
+          if constexpr (internal::is_expect_v<result_type>)
+            next->complete( std::move( state->result() ).and_then( f ) );
+
+          else
+            next->complete( std::move( state->result() ).transform( f ) );
+        } ) );
+
+      return future_type{ std::move(next) };
+    }
+
+  private :
+    std::shared_ptr<state_type> state_;
+};
+
+} // namespace mry
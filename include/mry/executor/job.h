@@ -0,0 +1,77 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file job.h defines the type-erased units of work scheduled by an
+ *       `mry::executor`
+ *
+ * @see: `mry::executor`
+ */
+#include <utility>
+#include <memory>
+
+namespace mry::internal {
+
+/**
+ * @brief job describes a {heap allocated} unit of work
+ *
+ * @note: jobs are required not to throw -- errors are meant to be
+ *        carried by the `mry::expect<T, E>` they yield
+ */
+struct job
+{
+  virtual ~job() noexcept
+    =default;
+
+  /**
+   * @brief run performs the unit of work
+   */
+  virtual auto run() noexcept
+    -> void =0;
+};
+
+/**
+ * @brief job_of describes a job performed by invoking F
+ */
+template <typename F>
+  struct job_of final
+    : job
+{
+  explicit
+    job_of( F f ) noexcept( std::is_nothrow_move_constructible_v<F> )
+      : f{ std::move(f) }
+  {}
+
+  auto run() noexcept
+    -> void override
+  { f(); }
+
+  F f;
+};
+
+/**
+ * @brief make_job returns the job performed by invoking `f`
+ */
+template <typename F>
+  auto make_job( F f )
+    -> std::unique_ptr<job>
+{ return std::make_unique< job_of<F> >( std::move(f) ); }
+
+} // namespace mry::internal
@@ -26,32 +26,90 @@
  * #see: `mry::expect<T>`
  */
 #include "mry/expect/variant.h"
+#include "mry/expect/stored.h"
+#include "mry/expect/errors.h"
+#include "mry/expect/niche.h"
+#include "mry/expect/coroutine.h"
+#include "mry/expect/exception.h"
+#include "mry/relocate.h"
 #include "mry/error_t.h"
 
+#include <type_traits>
+#include <functional>
+#include <utility>
+
 namespace mry {
 
+template <typename T, typename E, typename ...Es>
+  class expect;
+
+namespace internal {
+
+/**
+ * @brief is_expect trait tests whether T is an `mry::expect<U, G>`
+ */
+template <typename T>
+  struct is_expect
+    : std::false_type
+{};
+
+template <typename T, typename ...E>
+  struct is_expect< expect<T, E...> >
+    : std::true_type
+{};
+
+template <typename T>
+  inline auto constexpr is_expect_v =
+    is_expect<T>::value;
+
+} // namespace internal
+
 /**
  * @brief expect<T> is a {strongly typed} variant of the expected result
  *        type T and an unexpected potential error condition met
  *        during the computation of such result type T
  *
+ * the error condition is described by `mry::error_t` unless stated
+ * otherwise by E -- eg. by an error code enumeration -- or by any one
+ * of `E, Es...` held as `mry::errors<E, Es...>` given several.
+ *
  * @note: expect<T> is a {strongly typed} alternative to raising exceptions
  *        in a context when an operation would have a valid result otherwise
+ *
+ * @note: should T declare a niche expect<T> encodes its error state in
+ *        such, not requiring storage beyond its alternatives
+ *
+ * @note: expect<T> is trivially copyable and destructible whenever both
+ *        T and E are, hence returned in registers by the Itanium ABI
+ *        -- given its size permits
+ *
+ * @see: `mry::niche_traits<T>`
  */
-template <typename T>
+template <typename T, typename E =error_t, typename ...Es>
   class expect final
-    : public internal::variant_storage< T, error_t >
-    , public internal::variant_alternative<T>
-    , public internal::variant_alternative<error_t>
+    : public internal::variant_storage< internal::stored_t< T, internal::errors_t<E, Es...> >, internal::errors_t<E, Es...> >
+    , public internal::variant_alternative< internal::stored_t< T, internal::errors_t<E, Es...> > >
+    , public internal::variant_alternative< internal::errors_t<E, Es...> >
+    , private internal::discriminant< internal::stored_t< T, internal::errors_t<E, Es...> >, internal::errors_t<E, Es...> >
 {
+    using error_type =
+      internal::errors_t<E, Es...>;
+    using stored_type =
+      internal::stored_t<T, error_type>;
     using storage_alternative_type =
       typename expect::variant_storage;
     using success_alternative_type =
-      internal::variant_alternative<T>;
+      internal::variant_alternative<stored_type>;
     using fail_alternative_type =
-      internal::variant_alternative<error_t>;
+      internal::variant_alternative<error_type>;
+    using discriminant_type =
+      internal::discriminant<stored_type, error_type>;
+
+    static_assert( discriminant_type::error_offset % alignof(error_type) == 0
+                && discriminant_type::error_offset + sizeof(error_type)
+                     <= sizeof(storage_alternative_type)
+                 , "niche_traits<T>::error_offset places error_t out of storage" );
 
-    using storage_alternative_type::data;
     using success_alternative_type::get;
     using success_alternative_type::destroy;
     using fail_alternative_type::get;
@@ -61,23 +119,190 @@ template <typename T>
     using success_type =
       T;
     using fail_type =
-      error_t;
+      error_type;
+    using success_param_type =
+      std::conditional_t< std::is_void_v<T>, stored_type, T >;
+    using promise_type =
+      internal::expect_promise<T, E, Es...>;
 
     /**
      * @brief constructs success case
+     *
+     * @note: an expected `T&` refers to `s`, an expected `void` is
+     *        default constructed instead
+     */
+    constexpr expect( success_param_type s ) noexcept
+      : success_alternative_type{ success_data(), internal::store<stored_type>( std::forward<success_param_type>(s) ) }
+    { discriminant_type::mark_success( storage() ); }
+
+    /**
+     * @brief constructs the success case of an expected `void`
      */
-    expect( success_type s ) noexcept
-      : success_alternative_type{ data(), std::move(s) }
+    constexpr expect() noexcept
+      requires std::is_void_v<T>
+      : expect{ stored_type{} }
     {}
 
+    /**
+     * @brief an expected `T&` shall not refer to temporaries
+     */
+    expect( std::remove_reference_t<success_param_type> && )
+      requires std::is_reference_v<T>
+      =delete;
+
     /**
      * @brief constructs fail case
+     *
+     * @note: records a hit against its call site when error counters
+     *        are enabled -- unless E is `mry::error_t`, having recorded
+     *        its own
      */
-    expect( fail_type f ) noexcept
-      : fail_alternative_type{ data(), std::move(f) }
-      , holds_error_{ true }
+    constexpr expect( fail_type f, internal::call_site site ={} ) noexcept
+      : fail_alternative_type{ fail_data(), std::move(f) }
+    {
+      discriminant_type::mark_error( storage() );
+
+      if constexpr (! std::is_same_v<fail_type, error_t>)
+        internal::record_error( site );
+    }
+
+    /**
+     * @brief constructs fail case of the error condition G -- any one
+     *        of several `E, Es...`
+     */
+    template <internal::one_of<E, Es...> G>
+        requires ( sizeof...(Es) > 0 )
+      constexpr expect( G f, internal::call_site site ={} ) noexcept
+        : expect{ fail_type{ f }, site }
     {}
 
+    /**
+     * @brief constructs fail case propagating the error condition `f`
+     *        met elsewhere -- not recording a hit
+     */
+    constexpr expect( internal::propagate_t, fail_type f ) noexcept
+      : fail_alternative_type{ fail_data(), std::move(f) }
+    { discriminant_type::mark_error( storage() ); }
+
+    /**
+     * @brief {trivially} copy constructs the instance when both
+     *        alternative types are trivially copy constructible
+     */
+    constexpr expect( expect const & ) noexcept
+      requires internal::trivially_copy_constructible<stored_type, error_type>
+      =default;
+
+    /**
+     * @brief copy constructs the alternative type `o` holds
+     */
+    constexpr expect( expect const &o )
+      noexcept( std::is_nothrow_copy_constructible_v<stored_type>
+             && std::is_nothrow_copy_constructible_v<error_type> )
+      requires std::is_copy_constructible_v<stored_type>
+            && std::is_copy_constructible_v<error_type>
+            && ( ! internal::trivially_copy_constructible<stored_type, error_type> )
+      : success_alternative_type{}
+      , fail_alternative_type{}
+    { construct_from( o ); }
+
+    /**
+     * @brief {trivially} move constructs the instance when both
+     *        alternative types are trivially move constructible
+     */
+    constexpr expect( expect && ) noexcept
+      requires internal::trivially_move_constructible<stored_type, error_type>
+      =default;
+
+    /**
+     * @brief move constructs the alternative type `o` holds
+     *
+     * @note: `o` still holds its -- moved-from -- alternative type
+     */
+    constexpr expect( expect &&o )
+      noexcept( std::is_nothrow_move_constructible_v<stored_type>
+             && std::is_nothrow_move_constructible_v<error_type> )
+      requires std::is_move_constructible_v<stored_type>
+            && std::is_move_constructible_v<error_type>
+            && ( ! internal::trivially_move_constructible<stored_type, error_type> )
+      : success_alternative_type{}
+      , fail_alternative_type{}
+    { construct_from( std::move(o) ); }
+
+    /**
+     * @brief {trivially} copy assigns `o` when both alternative types
+     *        are trivially copyable
+     */
+    constexpr auto operator=( expect const & ) noexcept
+      -> expect&
+      requires internal::trivially_copy_assignable<stored_type, error_type>
+      =default;
+
+    /**
+     * @brief copy assigns the alternative type `o` holds
+     *
+     * @note: as of `std::expected` either alternative type is required
+     *        to be nothrow move constructible, leaving the instance
+     *        intact should copying `o` throw
+     */
+    constexpr auto operator=( expect const &o )
+      -> expect&
+      requires std::is_copy_constructible_v<stored_type>
+            && std::is_copy_constructible_v<error_type>
+            && std::is_copy_assignable_v<stored_type>
+            && std::is_copy_assignable_v<error_type>
+            && ( std::is_nothrow_move_constructible_v<stored_type>
+              || std::is_nothrow_move_constructible_v<error_type> )
+            && ( ! internal::trivially_copy_assignable<stored_type, error_type> )
+    {
+      if (holds_error() == o.holds_error())
+        assign_from( o );
+
+      else
+        *this = expect{ o };
+
+      return *this;
+    }
+
+    /**
+     * @brief {trivially} move assigns `o` when both alternative types
+     *        are trivially movable
+     */
+    constexpr auto operator=( expect && ) noexcept
+      -> expect&
+      requires internal::trivially_move_assignable<stored_type, error_type>
+      =default;
+
+    /**
+     * @brief move assigns the alternative type `o` holds
+     *
+     * @see: `operator=( expect const& )`
+     */
+    constexpr auto operator=( expect &&o )
+      noexcept( std::is_nothrow_move_constructible_v<stored_type>
+             && std::is_nothrow_move_constructible_v<error_type>
+             && std::is_nothrow_move_assignable_v<stored_type>
+             && std::is_nothrow_move_assignable_v<error_type> )
+      -> expect&
+      requires std::is_move_constructible_v<stored_type>
+            && std::is_move_constructible_v<error_type>
+            && std::is_move_assignable_v<stored_type>
+            && std::is_move_assignable_v<error_type>
+            && ( std::is_nothrow_move_constructible_v<stored_type>
+              || std::is_nothrow_move_constructible_v<error_type> )
+            && ( ! internal::trivially_move_assignable<stored_type, error_type> )
+    {
+      if (holds_error() == o.holds_error())
+        assign_from( std::move(o) );
+
+      else if (o.holds_error())
+        reinit_from<true>( std::move( o.fail() ) );
+
+      else
+        reinit_from<false>( std::move( o.stored() ) );
+
+      return *this;
+    }
+
     /**
      * @brief success returns the expected result type T
      *
@@ -85,10 +310,20 @@ template <typename T>
      *        the `expect<T>` instance holds the expected
      *        type T
      */
-    inline
+    constexpr
       auto success() noexcept
         -> decltype(auto)
-    { return get( data(), mry::meta::type<success_type> ); }
+    { return internal::unwrap( stored() ); }
+
+    /**
+     * @brief success returns the expected result type T
+     *
+     * @see: `success()`
+     */
+    constexpr
+      auto success() const noexcept
+        -> decltype(auto)
+    { return internal::unwrap( stored() ); }
 
     /**
      * @brief fail returns the description of the error condition
@@ -98,10 +333,21 @@ template <typename T>
      *        the `expect<T>` instance holds the description of
      *        the error description
      */
-    inline
+    constexpr
       auto fail() noexcept
         -> decltype(auto)
-    { return get( data(), mry::meta::type<fail_type> ); }
+    { return get( fail_data(), mry::meta::type<fail_type> ); }
+
+    /**
+     * @brief fail returns the description of the error condition
+     *        occurred
+     *
+     * @see: `fail()`
+     */
+    constexpr
+      auto fail() const noexcept
+        -> decltype(auto)
+    { return get( fail_data(), mry::meta::type<fail_type> ); }
 
     /**
      * @brief holds_error predicate tests whether the
@@ -113,7 +359,7 @@ template <typename T>
     constexpr
       auto holds_error() const noexcept
         -> bool
-    { return holds_error_; }
+    { return discriminant_type::holds_error( storage() ); }
 
     /**
      * @brief {explicit} bool conversion operator is a
@@ -125,29 +371,596 @@ template <typename T>
       explicit operator bool() const noexcept
     { return !holds_error(); }
 
+    /**
+     * @brief and_then invokes `f` with the expected result type T
+     *        returning the `expect<U, E>` it yields -- or the error
+     *        condition held otherwise
+     */
+    template <typename F>
+      constexpr
+        auto and_then( F &&f ) &
+    { return and_then( *this, std::forward<F>(f) ); }
+
+    /**
+     * @see: `and_then( F&& ) &`
+     */
+    template <typename F>
+      constexpr
+        auto and_then( F &&f ) const &
+    { return and_then( *this, std::forward<F>(f) ); }
+
+    /**
+     * @see: `and_then( F&& ) &`
+     */
+    template <typename F>
+      constexpr
+        auto and_then( F &&f ) &&
+    { return and_then( std::move(*this), std::forward<F>(f) ); }
+
+    /**
+     * @brief transform invokes `f` with the expected result type T
+     *        returning the U it yields as `expect<U, E>` -- or the
+     *        error condition held otherwise
+     */
+    template <typename F>
+      constexpr
+        auto transform( F &&f ) &
+    { return transform( *this, std::forward<F>(f) ); }
+
+    /**
+     * @see: `transform( F&& ) &`
+     */
+    template <typename F>
+      constexpr
+        auto transform( F &&f ) const &
+    { return transform( *this, std::forward<F>(f) ); }
+
+    /**
+     * @see: `transform( F&& ) &`
+     */
+    template <typename F>
+      constexpr
+        auto transform( F &&f ) &&
+    { return transform( std::move(*this), std::forward<F>(f) ); }
+
+    /**
+     * @brief or_else invokes `f` with the error condition held
+     *        returning the `expect<T, G>` it yields -- or the expected
+     *        result type T otherwise
+     */
+    template <typename F>
+      constexpr
+        auto or_else( F &&f ) &
+    { return or_else( *this, std::forward<F>(f) ); }
+
+    /**
+     * @see: `or_else( F&& ) &`
+     */
+    template <typename F>
+      constexpr
+        auto or_else( F &&f ) const &
+    { return or_else( *this, std::forward<F>(f) ); }
+
+    /**
+     * @see: `or_else( F&& ) &`
+     */
+    template <typename F>
+      constexpr
+        auto or_else( F &&f ) &&
+    { return or_else( std::move(*this), std::forward<F>(f) ); }
+
+    /**
+     * @brief transform_error invokes `f` with the error condition held
+     *        returning the G it yields as `expect<T, G>` -- or the
+     *        expected result type T otherwise
+     */
+    template <typename F>
+      constexpr
+        auto transform_error( F &&f ) &
+    { return transform_error( *this, std::forward<F>(f) ); }
+
+    /**
+     * @see: `transform_error( F&& ) &`
+     */
+    template <typename F>
+      constexpr
+        auto transform_error( F &&f ) const &
+    { return transform_error( *this, std::forward<F>(f) ); }
+
+    /**
+     * @see: `transform_error( F&& ) &`
+     */
+    template <typename F>
+      constexpr
+        auto transform_error( F &&f ) &&
+    { return transform_error( std::move(*this), std::forward<F>(f) ); }
+
+    /**
+     * @brief value_or returns the expected result type T -- or
+     *        `otherwise` converted to T should an error condition
+     *        be held
+     */
+    template <typename U>
+      constexpr
+        auto value_or( U &&otherwise ) const &
+          -> success_type
+          requires ( ! std::is_void_v<T> )
+    {
+      if (! holds_error())
+        return success();
+
+      return static_cast<success_type>( std::forward<U>(otherwise) );
+    }
+
+    /**
+     * @see: `value_or( U&& ) const &`
+     */
+    template <typename U>
+      constexpr
+        auto value_or( U &&otherwise ) &&
+          -> success_type
+          requires ( ! std::is_void_v<T> )
+    {
+      if (! holds_error())
+        return internal::forward_success( std::move(*this) );
+
+      return static_cast<success_type>( std::forward<U>(otherwise) );
+    }
+
+    /**
+     * @brief value_or_throw returns the expected result type T -- or
+     *        raises `mry::bad_expect_access<E>` holding the error
+     *        condition otherwise
+     *
+     * @note: meant for the boundary of code handling errors by
+     *        exceptions, `mry::catch_into<T, E>` turns the exception
+     *        back into the error condition
+     */
+    constexpr
+      auto value_or_throw() &
+        -> decltype(auto)
+    { return value_or_throw( *this ); }
+
+    /**
+     * @see: `value_or_throw() &`
+     */
+    constexpr
+      auto value_or_throw() const &
+        -> decltype(auto)
+    { return value_or_throw( *this ); }
+
+    /**
+     * @see: `value_or_throw() &`
+     */
+    constexpr
+      auto value_or_throw() &&
+        -> success_type
+    { return value_or_throw( std::move(*this) ); }
+
+    /**
+     * @brief {trivially} destroys the instance when both alternative
+     *        types are trivially destructible
+     */
+    constexpr ~expect() noexcept
+      requires std::is_trivially_destructible_v<stored_type>
+            && std::is_trivially_destructible_v<error_type>
+      =default;
+
     /**
      * @brief destroys the appropriate alternative type being
      *        held
      *
      * @see: `destroy()`
      */
-    ~expect() noexcept
+    constexpr ~expect() noexcept
     { destroy(); }
 
   private :
+    template <typename, typename, typename...>
+      friend class expect;
+    friend promise_type;
+
+    /**
+     * @brief constructs a {pending} instance holding no alternative type
+     *        -- yet -- to be resolved by its coroutine promise
+     *
+     * @note: it is the responsibility of the promise to resolve the
+     *        instance before destroying it
+     *
+     * @see: `resolve( expect&& )`
+     * @see: `resolve_fail( G&& )`
+     */
+    explicit
+      expect( internal::pending_t ) noexcept
+    {}
+
+    /**
+     * @brief resolve resolves the {pending} instance by the alternative
+     *        type `o` holds
+     */
+    inline
+      auto resolve( expect &&o ) noexcept
+        -> void
+    { construct_from( std::move(o) ); }
+
+    /**
+     * @brief resolve_fail resolves the {pending} instance by the error
+     *        condition `f`
+     */
+    template <typename G>
+      inline
+        auto resolve_fail( G &&f )
+          noexcept( std::is_nothrow_constructible_v<fail_type, G&&> )
+            -> void
+    {
+      construct( fail_data(), mry::meta::type<fail_type>, std::forward<G>(f) );
+      discriminant_type::mark_error( storage() );
+    }
+
+    /**
+     * @brief and_then implements `and_then( F&& )` for any value
+     *        category of `self`
+     */
+    template <typename Self, typename F>
+      static constexpr
+        auto and_then( Self &&self, F &&f )
+    {
+      using result_type =
+        std::remove_cvref_t< internal::success_result_t<Self, F> >;
+
+      static_assert( internal::is_expect_v<result_type>
+                  && std::is_same_v< typename result_type::fail_type, fail_type >
+                   , "and_then requires F returning expect<U, E>" );
+
+      if (! self.holds_error())
+        return internal::invoke_success( std::forward<Self>(self), std::forward<F>(f) );
+
+      return result_type{ internal::propagate, mry::meta::forward_like<Self>( self.fail() ) };
+    }
+
+    /**
+     * @brief transform implements `transform( F&& )` for any value
+     *        category of `self`
+     */
+    template <typename Self, typename F>
+      static constexpr
+        auto transform( Self &&self, F &&f )
+    {
+      using result_type =
+        expect< std::remove_cvref_t< internal::success_result_t<Self, F> >
+              , E, Es... >;
+
+      if (! self.holds_error())
+      {
+        if constexpr (std::is_void_v< typename result_type::success_type >)
+        {
+          internal::invoke_success( std::forward<Self>(self), std::forward<F>(f) );
+          return result_type{};
+        }
+
+        else
+          return result_type{ internal::invoke_success( std::forward<Self>(self), std::forward<F>(f) ) };
+      }
+
+      return result_type{ internal::propagate, mry::meta::forward_like<Self>( self.fail() ) };
+    }
+
+    /**
+     * @brief or_else implements `or_else( F&& )` for any value
+     *        category of `self`
+     */
+    template <typename Self, typename F>
+      static constexpr
+        auto or_else( Self &&self, F &&f )
+    {
+      using result_type =
+        std::remove_cvref_t<
+          std::invoke_result_t< F, decltype( mry::meta::forward_like<Self>( self.fail() ) ) > >;
+
+      static_assert( internal::is_expect_v<result_type>
+                  && std::is_same_v< typename result_type::success_type, success_type >
+                   , "or_else requires F returning expect<T, G>" );
+
+      if (self.holds_error())
+        return std::invoke( std::forward<F>(f)
+                          , mry::meta::forward_like<Self>( self.fail() ) );
+
+      return success_of<result_type>( std::forward<Self>(self) );
+    }
+
+    /**
+     * @brief transform_error implements `transform_error( F&& )` for
+     *        any value category of `self`
+     */
+    template <typename Self, typename F>
+      static constexpr
+        auto transform_error( Self &&self, F &&f )
+    {
+      using result_type =
+        expect< success_type
+              , std::remove_cvref_t<
+                  std::invoke_result_t< F, decltype( mry::meta::forward_like<Self>( self.fail() ) ) > > >;
+
+      if (self.holds_error())
+        return result_type{ std::invoke( std::forward<F>(f)
+                                       , mry::meta::forward_like<Self>( self.fail() ) ) };
+
+      return success_of<result_type>( std::forward<Self>(self) );
+    }
+
+    /**
+     * @brief value_or_throw implements `value_or_throw()` for any value
+     *        category of `self`
+     */
+    template <typename Self>
+      static constexpr
+        auto value_or_throw( Self &&self )
+          -> decltype(auto)
+    {
+      if (self.holds_error())
+        throw bad_expect_access<fail_type>{ mry::meta::forward_like<Self>( self.fail() ) };
+
+      return internal::forward_success( std::forward<Self>(self) );
+    }
+
+    using success_alternative_type::construct;
+    using fail_alternative_type::construct;
+
+    /**
+     * @brief construct_from constructs the alternative type `o` holds
+     *        -- copying or moving it as of the value category of `o`
+     *
+     * @note: it is the responsibility of the caller to ensure the
+     *        instance holds no alternative type {yet}
+     */
+    template <typename Other>
+      constexpr
+        auto construct_from( Other &&o )
+          -> void
+    {
+      auto const error =
+        o.holds_error();
+
+      if (! error)
+        construct( success_data(), mry::meta::type<stored_type>
+                 , mry::meta::forward_like<Other>( o.stored() ) );
+
+      else
+        construct( fail_data(), mry::meta::type<fail_type>
+                 , mry::meta::forward_like<Other>( o.fail() ) );
+
+      discriminant_type::mark( storage(), error );
+    }
+
+    /**
+     * @brief assign_from assigns the alternative type `o` holds
+     *        -- copying or moving it as of the value category of `o`
+     *
+     * @note: it is the responsibility of the caller to ensure the
+     *        instance holds the same alternative type as `o`
+     */
+    template <typename Other>
+      constexpr
+        auto assign_from( Other &&o )
+          -> void
+    {
+      if (! o.holds_error())
+        stored() =
+          mry::meta::forward_like<Other>( o.stored() );
+
+      else
+        fail() =
+          mry::meta::forward_like<Other>( o.fail() );
+    }
+
+    /**
+     * @brief reinit_from replaces the alternative type being held by the
+     *        other one -- the error condition given `Error` --
+     *        constructed from `arg`, leaving the instance intact should
+     *        such construction throw
+     *
+     * @note: as of `std::expected`, the new alternative is constructed
+     *        aside unless doing so in-place cannot throw, while the one
+     *        held is moved aside and restored otherwise
+     */
+    template <bool Error, typename Arg>
+      constexpr
+        auto reinit_from( Arg &&arg )
+          -> void
+    {
+      using new_type =
+        std::conditional_t< Error, error_type, stored_type >;
+      using old_type =
+        std::conditional_t< Error, stored_type, error_type >;
+
+      if constexpr (std::is_nothrow_constructible_v<new_type, Arg>)
+      {
+        destroy();
+        emplace<Error>( std::forward<Arg>(arg) );
+      }
+
+      else if constexpr (std::is_nothrow_move_constructible_v<new_type>)
+      {
+        auto aside =
+          new_type( std::forward<Arg>(arg) );
+
+        destroy();
+        emplace<Error>( std::move(aside) );
+      }
+
+      else
+      {
+        auto aside =
+          [this]() -> old_type
+          {
+            if constexpr (Error)
+              return std::move( stored() );
+            else
+              return std::move( fail() );
+          }();
+
+        destroy();
+
+        try
+        { emplace<Error>( std::forward<Arg>(arg) ); }
+
+        catch (...)
+        {
+          emplace<!Error>( std::move(aside) );
+          throw;
+        }
+      }
+    }
+
+    /**
+     * @brief emplace constructs the alternative type -- the error
+     *        condition given `Error` -- from `arg`
+     *
+     * @note: it is the responsibility of the caller to ensure the
+     *        instance holds no alternative type
+     */
+    template <bool Error, typename Arg>
+      constexpr
+        auto emplace( Arg &&arg )
+          -> void
+    {
+      if constexpr (Error)
+      {
+        construct( fail_data(), mry::meta::type<fail_type>, std::forward<Arg>(arg) );
+        discriminant_type::mark_error( storage() );
+      }
+
+      else
+      {
+        construct( success_data(), mry::meta::type<stored_type>, std::forward<Arg>(arg) );
+        discriminant_type::mark_success( storage() );
+      }
+    }
+
     /**
      * @brief destroy invokes the destructor the appropriate alternative
      *        type being held
      */
-    auto destroy() noexcept
-      -> void
+    constexpr
+      auto destroy() noexcept
+        -> void
     {
-      if (! holds_error_)
-        destroy( success() );
+      if (! holds_error())
+        destroy( stored() );
       else
         destroy( fail() );
     }
-    bool holds_error_ =false;
+
+    /**
+     * @brief success_of returns the `Result` -- an `expect<T, G>` --
+     *        holding the expected result `self` holds
+     */
+    template <typename Result, typename Self>
+      static constexpr
+        auto success_of( Self &&self )
+          -> Result
+    {
+      if constexpr (std::is_void_v<T>)
+        return Result{};
+
+      else
+        return Result{ internal::forward_success( std::forward<Self>(self) ) };
+    }
+
+    /**
+     * @brief stored returns the alternative stored for the expected
+     *        result type T
+     */
+    constexpr
+      auto stored() noexcept
+        -> stored_type&
+    { return get( success_data(), mry::meta::type<stored_type> ); }
+
+    /**
+     * @brief stored returns the alternative stored for the expected
+     *        result type T
+     */
+    constexpr
+      auto stored() const noexcept
+        -> stored_type const&
+    { return get( success_data(), mry::meta::type<stored_type> ); }
+
+    /**
+     * @brief storage returns the storage of the alternatives -- in which
+     *        the discriminant reads and marks the state held
+     */
+    constexpr
+      auto storage() noexcept
+        -> storage_alternative_type&
+    { return *this; }
+
+    /**
+     * @see: `storage()`
+     */
+    constexpr
+      auto storage() const noexcept
+        -> storage_alternative_type const&
+    { return *this; }
+
+    /**
+     * @brief success_data returns the location of the alternative
+     *        stored for the expected result type T within the storage
+     */
+    constexpr
+      auto success_data() noexcept
+        -> stored_type*
+    { return storage_alternative_type::alternative( mry::meta::type<stored_type> ); }
+
+    /**
+     * @see: `success_data()`
+     */
+    constexpr
+      auto success_data() const noexcept
+        -> stored_type const*
+    { return storage_alternative_type::alternative( mry::meta::type<stored_type> ); }
+
+    /**
+     * @brief fail_data returns the location of the fail alternative
+     *        within the storage
+     *
+     * @note: a fail alternative overlapping the niche of T at an
+     *        offset is placed by address -- hence not within constant
+     *        evaluation
+     */
+    constexpr
+      auto fail_data() noexcept
+        -> error_type*
+    {
+      if constexpr (discriminant_type::error_offset == 0)
+        return storage_alternative_type::alternative( mry::meta::type<error_type> );
+
+      else
+        return reinterpret_cast<error_type*>( storage_alternative_type::data() + discriminant_type::error_offset );
+    }
+
+    /**
+     * @see: `fail_data()`
+     */
+    constexpr
+      auto fail_data() const noexcept
+        -> error_type const*
+    {
+      if constexpr (discriminant_type::error_offset == 0)
+        return storage_alternative_type::alternative( mry::meta::type<error_type> );
+
+      else
+        return reinterpret_cast<error_type const*>( storage_alternative_type::data() + discriminant_type::error_offset );
+    }
 };
 
+/**
+ * @brief expect<T, E, Es...> is trivially relocatable whenever both
+ *        T and its error conditions are
+ */
+template <typename T, typename E, typename ...Es>
+  struct is_trivially_relocatable< expect<T, E, Es...> >
+    : std::bool_constant< is_trivially_relocatable_v< internal::stored_t< T, internal::errors_t<E, Es...> > >
+                       && is_trivially_relocatable_v< internal::errors_t<E, Es...> > >
+{};
+
 } // namespace mry
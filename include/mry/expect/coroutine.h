@@ -0,0 +1,396 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file coroutine.h defines the facilities making `mry::expect<T, E>` a
+ *       coroutine return type -- `co_await` on an `mry::expect<U, G>`
+ *       either yields its U or returns its error condition early
+ *
+ * ```cpp
+ * auto sum( std::string_view a, std::string_view b )
+ *   -> mry::expect<int>
+ * { co_return co_await my_atoi(a) + co_await my_atoi(b); }
+ * ```
+ *
+ * @see: `mry::internal::expect_promise<T, E>`
+ */
+#include "mry/expect/stored.h"
+#include "mry/meta.h"
+
+#include <type_traits>
+#include <coroutine>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <new>
+
+/**
+ * @brief MRY_EXPECT_COROUTINES_DEFER_RETURN denotes whether the compiler
+ *        delays converting the return object of a coroutine until the
+ *        coroutine first returns -- gcc, msvc and clang as of 17
+ *        {CWG2563} do, given its type differs from the return type
+ */
+#if defined(__clang__)
+#  define MRY_EXPECT_COROUTINES_DEFER_RETURN ( __clang_major__ >= 17 )
+#elif defined(__GNUC__) || defined(_MSC_VER)
+#  define MRY_EXPECT_COROUTINES_DEFER_RETURN 1
+#else
+#  define MRY_EXPECT_COROUTINES_DEFER_RETURN 0
+#endif
+
+namespace mry {
+
+template <typename T, typename E, typename ...Es>
+  class expect;
+
+namespace internal {
+
+/**
+ * @brief frame_stack describes the {thread local} storage coroutine
+ *        frames of `mry::expect<T, E>` are allocated from
+ *
+ * such coroutines never suspend but to return early, their frames are
+ * hence released in the reverse order of their allocation -- a stack
+ * suffices.
+ *
+ * @note: the buffer is allocated on the first frame of the thread and
+ *        released as the thread exits -- frames not fitting the
+ *        remaining capacity are allocated by the global `operator new`
+ */
+struct frame_stack final
+{
+  static auto constexpr capacity =
+    std::size_t{ 16 * 1024 };
+  static auto constexpr alignment =
+    alignof(std::max_align_t);
+
+  /**
+   * @brief allocate allocates `size` bytes on top of the stack
+   */
+  inline
+    auto allocate( std::size_t size )
+      -> void*
+  {
+    size =
+      ( size + alignment - 1 ) & ~( alignment - 1 );
+
+    if (capacity - top < size)
+      return ::operator new( size );
+
+    if (buffer == nullptr)
+      reserve();
+
+    auto frame =
+      &buffer[top];
+
+    top += size;
+
+    return frame;
+  }
+
+  /**
+   * @brief deallocate releases `frame` of `size` bytes -- the top of
+   *        the stack
+   */
+  inline
+    auto deallocate( void *frame, std::size_t size ) noexcept
+      -> void
+  {
+    auto byte =
+      static_cast<std::byte*>(frame);
+
+    if (buffer == nullptr || byte < &buffer[0] || byte >= &buffer[capacity])
+      return ::operator delete( frame );
+
+    size =
+      ( size + alignment - 1 ) & ~( alignment - 1 );
+
+    assert( byte + size == &buffer[top]
+         && "coroutine frames of mry::expect released out of order" );
+
+    top =
+      static_cast<std::size_t>( byte - &buffer[0] );
+  }
+
+  /**
+   * @brief reserve allocates the buffer of the calling thread
+   *
+   * @note: frames allocated once the thread released the buffer -- eg.
+   *        by the destructors of other thread locals -- are allocated by
+   *        the global `operator new`
+   */
+  auto reserve()
+    -> void
+  {
+    struct release final
+    {
+      ~release() noexcept
+      {
+        ::operator delete( stack->buffer );
+
+        stack->buffer = nullptr;
+        stack->top    = capacity;
+      }
+
+      frame_stack *stack;
+    };
+
+    static_assert( alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ );
+
+    buffer =
+      static_cast<std::byte*>( ::operator new( capacity ) );
+
+    thread_local auto const released =
+      release{ this };
+  }
+
+  std::byte   *buffer;
+  std::size_t  top;
+};
+
+/**
+ * @brief frames returns the frame stack of the calling thread
+ */
+inline
+  auto frames() noexcept
+    -> frame_stack&
+{
+  thread_local constinit frame_stack stack ={ nullptr, 0 };
+
+  return stack;
+}
+
+/**
+ * @brief expect_awaiter describes awaiting `Expect` -- an `mry::expect<U, G>`
+ *        of any value category -- within a coroutine returning
+ *        `mry::expect<T, E>`
+ */
+template <typename Expect, typename Promise>
+  struct expect_awaiter final
+{
+  /**
+   * @brief await_ready continues the coroutine unless an error
+   *        condition is held
+   */
+  inline
+    auto await_ready() const noexcept
+      -> bool
+  { return ! awaited.holds_error(); }
+
+  /**
+   * @brief await_suspend returns the error condition held from the
+   *        coroutine -- suspending it for good
+   *
+   * @note: the error condition is moved out of rvalues only, lvalues
+   *        awaited are left intact -- their error condition copied, a
+   *        copy throwing being rethrown from the coroutine
+   */
+  inline
+    auto await_suspend( std::coroutine_handle<Promise> coroutine )
+      noexcept( noexcept( coroutine.promise().fail( mry::meta::forward_like<Expect>( awaited.fail() ) ) ) )
+        -> void
+  { coroutine.promise().fail( mry::meta::forward_like<Expect>( awaited.fail() ) ); }
+
+  /**
+   * @brief await_resume yields the expected result type U
+   */
+  inline
+    auto await_resume()
+      -> typename std::remove_cvref_t<Expect>::success_type
+  { return internal::forward_success( static_cast<Expect&&>(awaited) ); }
+
+  std::remove_reference_t<Expect> &awaited;
+};
+
+/**
+ * @brief pending_t tag type denotes constructing an `mry::expect<T, E>`
+ *        holding no alternative type -- yet
+ */
+struct pending_t final
+{};
+
+template <typename T, typename ...E>
+  struct expect_promise;
+
+/**
+ * @brief expect_return describes the object returned by a coroutine
+ *        returning `mry::expect<T, E>` -- converted to such when the
+ *        coroutine returns to its caller
+ *
+ * should the coroutine throw, the exception propagates to its caller --
+ * the coroutine not having returned yet, it is destroyed as the exception
+ * leaves its initial invocation and the object returned is never converted.
+ *
+ * @note: the conversion relies on being delayed until the coroutine
+ *        first returns -- as of CWG2563 -- trivially copyable results
+ *        returned in registers could not be resolved in-place otherwise,
+ *        see `MRY_EXPECT_COROUTINES_DEFER_RETURN` for the compilers
+ *        guaranteed to do so
+ */
+template <typename T, typename ...E>
+  struct expect_return final
+{
+  using promise_type =
+    expect_promise<T, E...>;
+
+  /**
+   * @brief converts to the result the coroutine resolved, destroying
+   *        the coroutine
+   */
+  inline
+    operator expect<T, E...>() && noexcept
+  {
+    assert( coroutine.promise().resolved
+         && "the return object of an mry::expect coroutine converted eagerly" );
+
+    auto result =
+      std::move( coroutine.promise().result );
+
+    coroutine.destroy();
+
+    return result;
+  }
+
+  std::coroutine_handle<promise_type> coroutine;
+};
+
+/**
+ * @brief expect_promise describes the promise of coroutines returning
+ *        `mry::expect<T, E>`
+ *
+ * the coroutine runs eagerly and suspends only once it resolved its
+ * result -- by returning a value or an error condition awaited
+ */
+template <typename T, typename ...E>
+  struct expect_promise final
+{
+  using result_type =
+    expect<T, E...>;
+
+  static_assert( MRY_EXPECT_COROUTINES_DEFER_RETURN
+               , "coroutines returning mry::expect<T> require the conversion of their return object delayed" );
+
+  expect_promise() noexcept
+    : result{ pending_t{} }
+  {}
+
+  /**
+   * @brief destroys the result unless left pending -- the coroutine
+   *        having thrown
+   */
+  ~expect_promise() noexcept
+  {
+    if (resolved)
+      result.~result_type();
+  }
+
+  /**
+   * @brief allocates the coroutine frame on the `frame_stack`
+   */
+  static
+    auto operator new( std::size_t size )
+      -> void*
+  { return frames().allocate( size ); }
+
+  /**
+   * @brief releases the coroutine frame
+   */
+  static
+    auto operator delete( void *frame, std::size_t size ) noexcept
+      -> void
+  { frames().deallocate( frame, size ); }
+
+  /**
+   * @brief get_return_object returns the object converted to the
+   *        result once resolved
+   */
+  inline
+    auto get_return_object() noexcept
+      -> expect_return<T, E...>
+  { return { std::coroutine_handle<expect_promise>::from_promise(*this) }; }
+
+  inline
+    auto initial_suspend() const noexcept
+      -> std::suspend_never
+  { return {}; }
+
+  inline
+    auto final_suspend() const noexcept
+      -> std::suspend_always
+  { return {}; }
+
+  /**
+   * @brief return_value resolves the result by `r`
+   *
+   * @note: coroutines returning `mry::expect<void, E>` succeed by
+   *        `co_return {};`
+   */
+  inline
+    auto return_value( result_type r ) noexcept
+      -> void
+  {
+    result.resolve( std::move(r) );
+    resolved = true;
+  }
+
+  /**
+   * @brief fail resolves the result by the error condition `f`
+   */
+  template <typename G>
+    inline
+      auto fail( G &&f )
+        noexcept( std::is_nothrow_constructible_v< typename result_type::fail_type, G&& > )
+          -> void
+  {
+    result.resolve_fail( std::forward<G>(f) );
+    resolved = true;
+  }
+
+  /**
+   * @brief await_transform awaits `e` -- an `mry::expect<U, G>` whose
+   *        error condition is convertible to E
+   */
+  template <typename Expect>
+      requires std::is_constructible_v< typename result_type::fail_type, typename std::remove_cvref_t<Expect>::fail_type >
+    inline
+      auto await_transform( Expect &&e ) noexcept
+        -> expect_awaiter<Expect, expect_promise>
+  { return { e }; }
+
+  /**
+   * @brief unhandled_exception rethrows the exception escaping the
+   *        coroutine to its caller
+   *
+   * @see: `expect_return<T, E>`
+   */
+  inline
+    auto unhandled_exception() const
+      -> void
+  { throw; }
+
+  union
+  {
+    result_type result;
+  };
+  bool resolved =false;
+};
+
+} // namespace internal
+} // namespace mry
@@ -0,0 +1,353 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file errors.h defines `mry::errors<Es...>` -- the error condition of
+ *       `mry::expect<T, E1, E2, ...>` holding any one of several user
+ *       defined error types
+ *
+ * the alternatives are told apart by a byte following their storage,
+ * the values of which past the last alternative are a niche telling
+ * `mry::expect` succeeded -- given the expected result fits before it
+ *
+ * @see: `mry::internal::discriminant< T, errors<Es...> >`
+ */
+#include "mry/expect/variant.h"
+#include "mry/expect/niche.h"
+#include "mry/meta.h"
+
+#include <type_traits>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <memory>
+#include <tuple>
+
+namespace mry {
+namespace internal {
+
+/**
+ * @brief one_of concept describes G being any of the types `Types...`
+ */
+template <typename G, typename ...Types>
+  concept one_of =
+    ( std::is_same_v<G, Types> || ... );
+
+} // namespace internal
+
+/**
+ * @brief errors<Es...> holds any one of the error conditions Es --
+ *        trivially copyable error code enumerations or plain structs
+ *
+ * @note: `visit` dispatches by a table indexed by the alternative held,
+ *        instead of a chain of comparisons
+ */
+template <typename ...Es>
+  class errors final
+{
+    static_assert( sizeof...(Es) > 1 && sizeof...(Es) < 255
+                 , "errors<Es...> requires 2 to 254 alternatives" );
+    static_assert( ( std::is_trivially_copyable_v<Es> && ... )
+                 , "errors<Es...> requires trivially copyable alternatives" );
+
+  public :
+    using index_type =
+      std::uint8_t;
+
+    /**
+     * @brief npos is never the index of an alternative -- denoting
+     *        none held
+     */
+    static auto constexpr npos =
+      index_type{ sizeof...(Es) };
+
+    /**
+     * @brief index_offset is the offset of the index following the
+     *        storage of the alternatives
+     */
+    static auto constexpr index_offset =
+      sizeof( internal::variant_storage<Es...> );
+
+    /**
+     * @brief index_of is the index of the alternative G
+     */
+    template <internal::one_of<Es...> G>
+      static auto constexpr index_of =
+        []{
+          auto index =
+            index_type{0};
+
+          ( ( std::is_same_v<G, Es> ? false : ( ++index, true ) ) && ... );
+
+          return index;
+        }();
+
+    /**
+     * @brief constructs the alternative G holding `e`
+     */
+    template <internal::one_of<Es...> G>
+      constexpr errors( G e ) noexcept
+        : index_{ index_of<G> }
+    { std::construct_at( storage_.alternative( mry::meta::type<G> ), e ); }
+
+    /**
+     * @brief constructs the alternative `o` holds -- any of `Gs...`
+     *        being one of Es
+     */
+    template <typename ...Gs>
+        requires ( internal::one_of<Gs, Es...> && ... )
+              && ( ! std::is_same_v< errors<Gs...>, errors > )
+      errors( errors<Gs...> const &o ) noexcept
+        : errors{ o.visit( []( auto e ) { return errors{ e }; } ) }
+    {}
+
+    /**
+     * @brief index returns the index of the alternative held
+     */
+    constexpr
+      auto index() const noexcept
+        -> std::size_t
+    { return index_; }
+
+    /**
+     * @brief holds predicate tests whether the alternative G is held
+     */
+    template <internal::one_of<Es...> G>
+      constexpr
+        auto holds() const noexcept
+          -> bool
+    { return index_ == index_of<G>; }
+
+    /**
+     * @brief get returns the alternative G
+     *
+     * @note: it is the responsibility of the caller to ensure the
+     *        alternative G is held
+     */
+    template <internal::one_of<Es...> G>
+      constexpr
+        auto get() noexcept
+          -> G&
+    { return *storage_.alternative( mry::meta::type<G> ); }
+
+    /**
+     * @see: `get()`
+     */
+    template <internal::one_of<Es...> G>
+      constexpr
+        auto get() const noexcept
+          -> G const&
+    { return *storage_.alternative( mry::meta::type<G> ); }
+
+    /**
+     * @brief get_if returns the alternative G if held -- or `nullptr`
+     *        otherwise
+     */
+    template <internal::one_of<Es...> G>
+      constexpr
+        auto get_if() noexcept
+          -> G*
+    { return holds<G>() ? &get<G>() : nullptr; }
+
+    /**
+     * @see: `get_if()`
+     */
+    template <internal::one_of<Es...> G>
+      constexpr
+        auto get_if() const noexcept
+          -> G const*
+    { return holds<G>() ? &get<G>() : nullptr; }
+
+    /**
+     * @brief visit invokes `f` with the alternative held -- `f` shall
+     *        yield the same type for any of the alternatives
+     */
+    template <typename F>
+      auto visit( F &&f ) &
+        -> decltype(auto)
+    { return visit( *this, std::forward<F>(f) ); }
+
+    /**
+     * @see: `visit( F&& ) &`
+     */
+    template <typename F>
+      auto visit( F &&f ) const &
+        -> decltype(auto)
+    { return visit( *this, std::forward<F>(f) ); }
+
+    /**
+     * @see: `visit( F&& ) &`
+     */
+    template <typename F>
+      auto visit( F &&f ) &&
+        -> decltype(auto)
+    { return visit( std::move(*this), std::forward<F>(f) ); }
+
+  private :
+    /**
+     * @brief visit_result_t denotes the type `f` yields invoked with
+     *        the alternative G of `self`
+     */
+    template <typename G, typename Self, typename F>
+      using visit_result_t =
+        std::invoke_result_t< F, decltype( mry::meta::forward_like<Self>( std::declval<Self&>().template get<G>() ) ) >;
+
+    /**
+     * @brief visit implements `visit( F&& )` for any value category
+     *        of `self`
+     */
+    template <typename Self, typename F>
+      static
+        auto visit( Self &&self, F &&f )
+          -> decltype(auto)
+    {
+      using result_type =
+        visit_result_t< std::tuple_element_t< 0, std::tuple<Es...> >, Self, F >;
+      using thunk_type =
+        auto (*)( Self&&, F&& ) -> result_type;
+
+      static_assert( ( std::is_same_v< visit_result_t<Es, Self, F>, result_type > && ... )
+                   , "visit requires F yielding the same type for each alternative" );
+
+      static thunk_type constexpr table[] ={ &visit_alternative< Es, result_type, Self, F >... };
+
+      return table[ self.index_ ]( std::forward<Self>(self), std::forward<F>(f) );
+    }
+
+    /**
+     * @brief visit_alternative invokes `f` with the alternative G of
+     *        `self` -- an entry of the `visit` table
+     */
+    template <typename G, typename R, typename Self, typename F>
+      static
+        auto visit_alternative( Self &&self, F &&f )
+          -> R
+    { return std::invoke( std::forward<F>(f), mry::meta::forward_like<Self>( self.template get<G>() ) ); }
+
+    template <typename, typename>
+      friend struct internal::discriminant;
+
+    internal::variant_storage<Es...> storage_;
+    index_type                       index_;
+};
+
+namespace internal {
+
+/**
+ * @brief errors_of maps the error conditions of `mry::expect<T, E, Es...>`
+ *        to its fail type -- E itself unless several given
+ */
+template <typename E, typename ...Es>
+  struct errors_of
+{ using type = errors<E, Es...>; };
+
+template <typename E>
+  struct errors_of<E>
+{ using type = E; };
+
+template <typename E, typename ...Es>
+  using errors_t =
+    typename errors_of<E, Es...>::type;
+
+/**
+ * @brief is_errors trait tests whether T is an `mry::errors<Es...>`
+ */
+template <typename T>
+  struct is_errors
+    : std::false_type
+{};
+
+template <typename ...Es>
+  struct is_errors< errors<Es...> >
+    : std::true_type
+{};
+
+template <typename T>
+  inline auto constexpr is_errors_v =
+    is_errors<T>::value;
+
+/**
+ * @brief discriminant of `mry::errors<Es...>` -- the success state is
+ *        encoded in the index of the errors by `npos`, given T fits
+ *        before such
+ *
+ * @note: within constant evaluation the index byte of an alternative not
+ *        alive may not be read nor written, the state is hence told by
+ *        whether the errors are alive -- leaving the byte unmarked
+ */
+template <typename T, typename ...Es>
+    requires ( sizeof(T) <= errors<Es...>::index_offset )
+          && ( ! disjoint_alternatives< T, errors<Es...> > )
+  struct discriminant< T, errors<Es...> >
+{
+  using storage_type =
+    variant_storage< T, errors<Es...> >;
+
+  static auto constexpr error_offset =
+    std::size_t{0};
+
+  constexpr
+    auto holds_error( storage_type const &storage ) const noexcept
+      -> bool
+  {
+    if (std::is_constant_evaluated())
+      return alive( storage.alternative( mry::meta::type< errors<Es...> > ) );
+
+    return static_cast<typename errors<Es...>::index_type>( storage.data()[ errors<Es...>::index_offset ] )
+        != errors<Es...>::npos;
+  }
+
+  constexpr
+    auto mark_error( storage_type & ) noexcept
+      -> void
+  {}
+
+  constexpr
+    auto mark_success( storage_type &storage ) noexcept
+      -> void
+  {
+    if (! std::is_constant_evaluated())
+      storage.data()[ errors<Es...>::index_offset ] = static_cast<char>( errors<Es...>::npos );
+  }
+
+  constexpr
+    auto mark( storage_type &storage, bool error ) noexcept
+      -> void
+  {
+    if (! error)
+      mark_success( storage );
+  }
+
+  private :
+    /**
+     * @brief alive predicate tests whether `e` is within its lifetime
+     *        -- only within constant evaluation
+     *
+     * @see: `mry::meta::within_lifetime()`
+     */
+    static constexpr
+      auto alive( errors<Es...> const *e ) noexcept
+        -> bool
+    { return mry::meta::within_lifetime( &e->index_ ); }
+};
+
+} // namespace internal
+} // namespace mry
@@ -0,0 +1,331 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file exception.h defines the adapters converting between exceptions
+ *       and `mry::expect<T, E>` at the boundary of code raising them
+ *
+ * ```cpp
+ * auto port =
+ *   mry::catch_into<int>( [&]{ return std::stoi( text ); }
+ *                       , mry::catching<std::invalid_argument>( "not a number" )
+ *                       , mry::catching<std::out_of_range>( "out of range" ) );
+ * ```
+ *
+ * @see: `mry::catch_into<T, E>( F&&, Mappings... )`
+ * @see: `mry::expect<T, E>::value_or_throw()`
+ */
+#include "mry/expect/errors.h"
+#include "mry/error_code.h"
+#include "mry/error_t.h"
+
+#include <source_location>
+#include <type_traits>
+#include <string_view>
+#include <functional>
+#include <stdexcept>
+#include <cstddef>
+#include <utility>
+#include <string>
+#include <tuple>
+
+namespace mry {
+
+template <typename T, typename E, typename ...Es>
+  class expect;
+
+namespace internal {
+
+/**
+ * @brief describe returns the description of the error condition `e`
+ *        -- a generic one unless E is `mry::error_t`, an error code
+ *        enumeration or `mry::errors<Es...>` of such
+ */
+template <typename E>
+  auto describe( E const &e )
+    -> std::string_view
+{
+  if constexpr (std::is_same_v<E, error_t>)
+    return e.get();
+
+  else if constexpr (error_code_enum<E>)
+    return code_table<E>::entry(e)->message;
+
+  else if constexpr (is_errors_v<E>)
+    return e.visit( []( auto const &g ) { return describe(g); } );
+
+  else
+    return "mry::bad_expect_access";
+}
+
+} // namespace internal
+
+/**
+ * @brief bad_expect_access<E> is the exception raised by
+ *        `mry::expect<T, E>::value_or_throw()` holding the error
+ *        condition E met
+ *
+ * @note: `what()` is a copy of the description of the error condition,
+ *        made on raising the exception
+ *
+ * @see: `mry::catch_into<T, E>( F&&, Mappings... )` turning it back
+ *       into the error condition E
+ */
+template <typename E>
+  class bad_expect_access final
+    : public std::runtime_error
+{
+  public :
+    explicit
+      bad_expect_access( E e )
+        : std::runtime_error{ std::string{ internal::describe(e) } }
+        , error_{ std::move(e) }
+    {}
+
+    /**
+     * @brief error returns the error condition met
+     */
+    auto error() const & noexcept
+      -> E const&
+    { return error_; }
+
+    /**
+     * @see: `error() const &`
+     */
+    auto error() && noexcept
+      -> E&&
+    { return std::move(error_); }
+
+  private :
+    E error_;
+};
+
+/**
+ * @brief exception_mapping describes mapping the exceptions of type X
+ *        caught by `mry::catch_into<T, E>` to error conditions -- by
+ *        invoking `map` with the exception, or by `map` itself
+ *
+ * @see: `mry::catching<X>( M&& )`
+ */
+template <typename X, typename M>
+  struct exception_mapping final
+{
+  using exception_type =
+    X;
+
+  M                  map;
+  internal::call_site site;
+
+  /**
+   * @brief fail returns the failing `Result` -- an `expect<T, E>` --
+   *        holding the error condition `x` maps to
+   */
+  template <typename Result>
+    auto fail( X const &x ) const
+      -> Result
+  {
+    using fail_type =
+      typename Result::fail_type;
+
+    if constexpr (std::is_invocable_v<M const&, X const&>)
+      return Result{ error_of<fail_type>( std::invoke( map, x ) ), site };
+
+    else
+      return Result{ error_of<fail_type>( map ), site };
+  }
+
+  private :
+    /**
+     * @brief error_of constructs the error condition G of `e` -- an
+     *        `mry::error_t` recording the site of the mapping
+     */
+    template <typename G, typename V>
+      auto error_of( V &&e ) const
+        -> G
+    {
+      if constexpr (std::is_same_v< std::remove_cvref_t<V>, internal::literal_string >
+                 && ! std::is_constructible_v<G, V&&>
+                 && ! std::is_constructible_v<G, V&&, internal::call_site>)
+        return error_of<G>( e.text );
+
+      else if constexpr (std::is_constructible_v<G, V&&, internal::call_site>)
+        return G{ std::forward<V>(e), site };
+
+      else
+        return G{ std::forward<V>(e) };
+    }
+};
+
+namespace internal {
+
+/**
+ * @brief is_exception_mapping trait tests whether T is an
+ *        `mry::exception_mapping<X, M>`
+ */
+template <typename T>
+  struct is_exception_mapping
+    : std::false_type
+{};
+
+template <typename X, typename M>
+  struct is_exception_mapping< exception_mapping<X, M> >
+    : std::true_type
+{};
+
+template <typename T>
+  inline auto constexpr is_exception_mapping_v =
+    is_exception_mapping<T>::value;
+
+/**
+ * @brief invoke_into returns the `Result` -- an `expect<T, E>` --
+ *        holding the expected result `f` yields
+ */
+template <typename Result, typename F>
+  auto invoke_into( F &f )
+    -> Result
+{
+  if constexpr (std::is_void_v< typename Result::success_type >)
+  {
+    std::invoke(f);
+    return Result{};
+  }
+
+  else
+    return Result{ std::invoke(f) };
+}
+
+/**
+ * @brief invoke_catching invokes `f` nested in a try block per mapping,
+ *        the first I of `mappings` -- the first one innermost, hence
+ *        attempted first
+ *
+ * @note: the innermost try block turns `mry::bad_expect_access<E>` back
+ *        into the error condition E it holds
+ */
+template <typename Result, std::size_t I, typename F, typename Mappings>
+  auto invoke_catching( F &f, Mappings const &mappings )
+    -> Result
+{
+  if constexpr (I == 0)
+  {
+    try { return invoke_into<Result>(f); }
+    catch( bad_expect_access< typename Result::fail_type > &x )
+    { return Result{ propagate, std::move(x).error() }; }
+  }
+
+  else
+  {
+    using mapping_type =
+      std::tuple_element_t<I - 1, Mappings>;
+
+    try { return invoke_catching<Result, I - 1>( f, mappings ); }
+    catch( typename mapping_type::exception_type const &x )
+    { return std::get<I - 1>(mappings).template fail<Result>(x); }
+  }
+}
+
+} // namespace internal
+
+/**
+ * @brief catching returns the mapping of the exceptions of type X to the
+ *        error condition `m` -- or to the one `m` yields invoked with
+ *        the exception caught
+ *
+ * @note: error conditions mapped to are attributed to `site`, the call
+ *        site of `catching` -- when error counters are enabled
+ *
+ * @see: `mry::catch_into<T, E>( F&&, Mappings... )`
+ */
+template <typename X, typename M>
+    requires ( ! std::is_array_v< std::remove_reference_t<M> > )
+  auto catching( M &&m, internal::call_site site ={} )
+    -> exception_mapping< X, std::decay_t<M> >
+{ return { std::forward<M>(m), site }; }
+
+/**
+ * @brief catching returns the mapping of the exceptions of type X to the
+ *        error condition described by the string literal `m` -- referred
+ *        to by its address
+ *
+ * @see: `catching<X>( M&&, internal::call_site )`
+ */
+template <typename X>
+  auto catching( internal::literal_string m, internal::call_site site ={} )
+    -> exception_mapping< X, internal::literal_string >
+{ return { m, site }; }
+
+/**
+ * @brief catch_into invokes `f` returning the expected result T it
+ *        yields -- or the error condition E the exception it raises
+ *        maps to by the first of `mappings` catching it
+ *
+ * ```cpp
+ * auto config =
+ *   mry::catch_into<json, parse_errc>( [&]{ return json::parse( text ); }
+ *                                    , mry::catching<json::parse_error>( parse_errc::syntax )
+ *                                    , mry::catching<std::bad_alloc>( parse_errc::exhausted ) );
+ * ```
+ *
+ * @note: exceptions not mapped propagate, except for the
+ *        `mry::bad_expect_access<E>` raised by `value_or_throw()`,
+ *        turned back into the error condition E it holds
+ *
+ * @note: mappings shall not throw, an exception they raise would be
+ *        caught by the mappings following them
+ *
+ * @note: the cost of the boundary is that of a try block -- nothing
+ *        on success by table based unwinding -- and of unwinding to
+ *        it on failure
+ */
+template <typename T, typename E =error_t, typename F, typename ...Mappings>
+    requires ( sizeof...(Mappings) > 0 )
+          && ( internal::is_exception_mapping_v<Mappings> && ... )
+  auto catch_into( F &&f, Mappings ...mappings )
+    -> expect<T, E>
+{
+  return internal::invoke_catching< expect<T, E>, sizeof...(Mappings) >
+    ( f, std::tuple<Mappings...>{ std::move(mappings)... } );
+}
+
+/**
+ * @brief catch_into invokes `f` returning the expected result T it
+ *        yields -- or the `mry::error_t` described by `what()` of the
+ *        `std::exception` it raises
+ *
+ * @note: given an error condition E other than `mry::error_t` only the
+ *        `mry::bad_expect_access<E>` raised by `value_or_throw()` is
+ *        caught, any other exception propagates
+ *
+ * @see: `catch_into<T, E>( F&&, Mappings... )`
+ */
+template <typename T, typename E =error_t, typename F>
+  auto catch_into( F &&f, internal::call_site site ={} )
+    -> expect<T, E>
+{
+  if constexpr (std::is_same_v<E, error_t>)
+    return catch_into<T, E>( f, catching<std::exception>( []( std::exception const &x )
+                                                            { return std::string{ x.what() }; }
+                                                        , site ) );
+
+  else
+    return internal::invoke_catching< expect<T, E>, 0 >( f, std::tuple<>{} );
+}
+
+} // namespace mry
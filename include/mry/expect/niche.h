@@ -0,0 +1,327 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file niche.h defines the customization point by which types declare
+ *       bit patterns they never use -- niches -- letting `mry::expect<T>`
+ *       encode its error state in those instead of a separate discriminant
+ *
+ * @see: `mry::niche_traits<T>`
+ */
+#include "mry/expect/variant.h"
+#include "mry/meta.h"
+
+#include <type_traits>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <memory>
+
+namespace mry {
+
+class error_t;
+
+/**
+ * @brief niche_traits is the customization point describing the unused
+ *        bit patterns of T
+ *
+ * specializations declaring a niche shall define
+ *
+ *   - `available` : `true`
+ *   - `error_offset` : the offset of the `mry::error_t` within the storage
+ *                      of `mry::expect<T>` in its fail state
+ *   - `holds_niche( char const *storage ) noexcept -> bool` : tests whether
+ *                      `storage` holds the niche -- ie. not a valid T
+ *   - `set_niche( char *storage ) noexcept -> void` : marks `storage`
+ *                      holding an `mry::error_t` at `error_offset` as such
+ *
+ * @note: the lowest bit of the {first} word of any `mry::error_t` is
+ *        always set, hence types whose valid values never set that bit
+ *        -- eg. pointers to aligned objects -- need not mark anything
+ *        at all, the `mry::error_t` is its own niche
+ *
+ * @see: `mry::internal::alignment_niche<T>`
+ */
+template <typename T>
+  struct niche_traits
+{ static auto constexpr available = false; };
+
+namespace internal {
+
+/**
+ * @brief alignment_niche describes the niche of T whose first word never
+ *        sets its lowest bit -- the alignment bit of pointers to objects
+ *        aligned to at least 2 bytes
+ *
+ * the fail state is hence held by the `mry::error_t` overlapping
+ * such word
+ */
+template <typename T>
+  struct alignment_niche
+{
+  static_assert( sizeof(T) == sizeof(std::uintptr_t) );
+
+  static auto constexpr available =
+    true;
+  static auto constexpr error_offset =
+    std::size_t{0};
+
+  static inline
+    auto holds_niche( char const *storage ) noexcept
+      -> bool
+  {
+    auto word =
+      std::uintptr_t{};
+
+    std::memcpy( &word, storage, sizeof(word) );
+
+    return ( word & 1 ) != 0;
+  }
+
+  static inline
+    auto set_niche( char * ) noexcept
+      -> void
+  {}
+};
+
+/**
+ * @brief complete concept describes types complete where tested
+ */
+template <typename T>
+  concept complete =
+    requires { sizeof(T); };
+
+/**
+ * @brief aligned_pointee returns whether T is complete and aligned to
+ *        at least 2 bytes
+ */
+template <typename T>
+  consteval
+    auto aligned_pointee() noexcept
+      -> bool
+{
+  if constexpr (complete<T>)
+    return alignof(T) >= 2;
+
+  else
+    return false;
+}
+
+/**
+ * @brief pointee_niche describes the niche of P referring to objects of
+ *        type T -- the alignment niche, available given T is complete
+ *        and aligned to at least 2 bytes
+ *
+ * @note: pointers to incomplete types -- eg. opaque handles -- fall back
+ *        to a separate flag, their alignment being unknown; such T shall
+ *        be incomplete wherever `mry::expect<P>` is used, or complete
+ *        wherever so, lest its layout differ across translation units
+ */
+template <typename P, typename T>
+  struct pointee_niche
+    : alignment_niche<P>
+{
+  static auto constexpr available =
+    aligned_pointee<T>();
+};
+
+} // namespace internal
+
+/**
+ * @brief niche_traits of pointers to objects
+ */
+template <typename T>
+    requires std::is_object_v<T>
+          && ( !std::is_unbounded_array_v<T> )
+  struct niche_traits<T*>
+    : internal::pointee_niche<T*, T>
+{};
+
+/**
+ * @brief niche_traits of owning pointers to objects
+ */
+template <typename T>
+    requires std::is_object_v<T>
+          && ( !std::is_unbounded_array_v<T> )
+  struct niche_traits< std::unique_ptr<T> >
+    : internal::pointee_niche< std::unique_ptr<T>, T >
+{};
+
+namespace internal {
+
+/**
+ * @brief discriminant describes how `mry::expect<T, E>` tells its
+ *        alternatives apart -- by a separate flag unless T declares a
+ *        niche and E is `mry::error_t`
+ */
+template <typename T, typename E>
+  struct discriminant
+{
+  using storage_type =
+    variant_storage<T, E>;
+
+  static auto constexpr error_offset =
+    std::size_t{0};
+
+  constexpr
+    auto holds_error( storage_type const & ) const noexcept
+      -> bool
+  { return holds_error_; }
+
+  constexpr
+    auto mark_error( storage_type & ) noexcept
+      -> void
+  { holds_error_ = true; }
+
+  constexpr
+    auto mark_success( storage_type & ) noexcept
+      -> void
+  { holds_error_ = false; }
+
+  /**
+   * @brief mark marks the state `error` denotes -- as read from the
+   *        instance copied or moved
+   *
+   * @note: storing the flag read rather than a constant lets gcc tell
+   *        the source of a relocation keeps its state, otherwise
+   *        flagging -Wfree-nonheap-object falsely on destroying it
+   */
+  constexpr
+    auto mark( storage_type &, bool error ) noexcept
+      -> void
+  { holds_error_ = error; }
+
+  bool holds_error_ =false;
+};
+
+/**
+ * @brief discriminant of alternatives laid out side by side -- the flag
+ *        is held by the storage itself
+ *
+ * @see: `mry::internal::disjoint_alternatives<T, E>`
+ */
+template <typename T, typename E>
+    requires disjoint_alternatives<T, E>
+  struct discriminant<T, E>
+{
+  using storage_type =
+    variant_storage<T, E>;
+
+  static auto constexpr error_offset =
+    std::size_t{0};
+
+  constexpr
+    auto holds_error( storage_type const &storage ) const noexcept
+      -> bool
+  { return storage.failed(); }
+
+  constexpr
+    auto mark_error( storage_type &storage ) noexcept
+      -> void
+  { storage.failed() = true; }
+
+  constexpr
+    auto mark_success( storage_type &storage ) noexcept
+      -> void
+  { storage.failed() = false; }
+
+  constexpr
+    auto mark( storage_type &storage, bool error ) noexcept
+      -> void
+  { storage.failed() = error; }
+};
+
+/**
+ * @brief discriminant of T declaring a niche -- the error state is
+ *        encoded in the storage itself
+ *
+ * @note: falls back to a separate flag should the `mry::error_t` at
+ *        `error_offset` not fit the storage -- eg. grown by holding its
+ *        call site
+ *
+ * @note: within constant evaluation the bits of T may not be read
+ *        through the `mry::error_t` overlapping it, the state is hence
+ *        told by whether the `mry::error_t` is alive -- leaving the niche
+ *        unmarked -- given it is placed at the start of the storage, T
+ *        declaring the niche at an offset is not usable within such
+ */
+template <typename T, typename E>
+    requires niche_traits<T>::available
+          && std::is_same_v< E, error_t >
+          && ( niche_traits<T>::error_offset + sizeof(E)
+                 <= ( sizeof(T) < sizeof(E) ? sizeof(E) : sizeof(T) ) )
+  struct discriminant<T, E>
+{
+  using storage_type =
+    variant_storage<T, E>;
+
+  static auto constexpr error_offset =
+    niche_traits<T>::error_offset;
+
+  constexpr
+    auto holds_error( storage_type const &storage ) const noexcept
+      -> bool
+  {
+    if constexpr (error_offset == 0)
+      if (std::is_constant_evaluated())
+        return alive( storage.alternative( mry::meta::type<E> ) );
+
+    return niche_traits<T>::holds_niche( storage.data() );
+  }
+
+  constexpr
+    auto mark_error( storage_type &storage ) noexcept
+      -> void
+  {
+    if (! std::is_constant_evaluated())
+      niche_traits<T>::set_niche( storage.data() );
+  }
+
+  constexpr
+    auto mark_success( storage_type & ) noexcept
+      -> void
+  {}
+
+  constexpr
+    auto mark( storage_type &storage, bool error ) noexcept
+      -> void
+  {
+    if (error)
+      mark_error( storage );
+  }
+
+  private :
+    /**
+     * @brief alive predicate tests whether `e` is within its lifetime
+     *        -- only within constant evaluation
+     *
+     * @see: `mry::meta::within_lifetime()`
+     */
+    static constexpr
+      auto alive( E const *e ) noexcept
+        -> bool
+    {
+      return mry::meta::within_lifetime( &e->word_ )
+          || mry::meta::within_lifetime( &e->constant_ );
+    }
+};
+
+} // namespace internal
+} // namespace mry
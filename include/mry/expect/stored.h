@@ -0,0 +1,214 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file stored.h defines the alternatives `mry::expect<T, E>` stores in
+ *       place of the expected result types not being objects -- `void`
+ *       and references
+ *
+ *   - `void` : is stored as `internal::unit<E>`, holding nothing -- but
+ *              a null word given E is `mry::error_t`, letting the error
+ *              be its own niche
+ *   - `T&`   : is stored as `internal::reference<T>`, a pointer to its
+ *              referent -- the alignment bit of which is a niche
+ *
+ * @see: `mry::internal::stored_t<T, E>`
+ */
+#include "mry/expect/niche.h"
+#include "mry/meta.h"
+
+#include <type_traits>
+#include <functional>
+#include <cstdint>
+#include <utility>
+#include <memory>
+
+namespace mry::internal {
+
+/**
+ * @brief unit is the alternative stored for an expected `void`
+ */
+template <typename E>
+  struct unit final
+{};
+
+/**
+ * @brief unit is a null word -- never setting its lowest bit -- for
+ *        an `mry::error_t` error condition to overlap
+ */
+template <>
+  struct unit< error_t > final
+{
+  std::uintptr_t word =0;
+};
+
+/**
+ * @brief reference is the alternative stored for an expected `T&`
+ */
+template <typename T>
+  struct reference final
+{
+  T *pointer;
+};
+
+/**
+ * @brief stored maps the expected result type T to the alternative
+ *        type `mry::expect<T, E>` stores
+ */
+template <typename T, typename E>
+  struct stored
+{ using type = T; };
+
+template <typename E>
+  struct stored< void, E >
+{ using type = unit<E>; };
+
+template <typename T, typename E>
+  struct stored< T&, E >
+{ using type = reference<T>; };
+
+template <typename T, typename E>
+  using stored_t =
+    typename stored<T, E>::type;
+
+/**
+ * @brief unwrap returns the expected result an alternative stored
+ *        refers to -- the alternative itself unless mapped by `stored`
+ */
+template <typename T>
+  constexpr
+    auto unwrap( T &s ) noexcept
+      -> T&
+{ return s; }
+
+template <typename T>
+  constexpr
+    auto unwrap( reference<T> &s ) noexcept
+      -> T&
+{ return *s.pointer; }
+
+template <typename T>
+  constexpr
+    auto unwrap( reference<T> const &s ) noexcept
+      -> T&
+{ return *s.pointer; }
+
+template <typename E>
+  constexpr
+    auto unwrap( unit<E> & ) noexcept
+      -> void
+{}
+
+template <typename E>
+  constexpr
+    auto unwrap( unit<E> const & ) noexcept
+      -> void
+{}
+
+/**
+ * @brief store returns the alternative stored for the expected result
+ *        `s` -- moved unless mapped by `stored`
+ */
+template <typename Stored, typename T>
+  constexpr
+    auto store( T &&s ) noexcept
+      -> decltype(auto)
+{
+  if constexpr (std::is_same_v< Stored, std::remove_cvref_t<T> >)
+    return std::move(s);
+
+  else
+    return Stored{ std::addressof(s) };
+}
+
+/**
+ * @brief forward_success forwards the expected result `self` -- an
+ *        `mry::expect<T, E>` -- holds as of its value category
+ *
+ * @note: referents are never moved from, `self` merely refers to them
+ */
+template <typename Self>
+  constexpr
+    auto forward_success( Self &&self ) noexcept
+      -> decltype(auto)
+{
+  using success_type =
+    typename std::remove_cvref_t<Self>::success_type;
+
+  if constexpr (std::is_void_v<success_type>)
+    return;
+
+  else if constexpr (std::is_reference_v<success_type>)
+    return self.success();
+
+  else
+    return mry::meta::forward_like<Self>( self.success() );
+}
+
+/**
+ * @brief invoke_success invokes `f` with the expected result `self`
+ *        holds -- with no arguments given an expected `void`
+ */
+template <typename Self, typename F>
+  constexpr
+    auto invoke_success( Self &&self, F &&f )
+      -> decltype(auto)
+{
+  using success_type =
+    typename std::remove_cvref_t<Self>::success_type;
+
+  if constexpr (std::is_void_v<success_type>)
+    return std::invoke( std::forward<F>(f) );
+
+  else
+    return std::invoke( std::forward<F>(f), forward_success( std::forward<Self>(self) ) );
+}
+
+/**
+ * @brief success_result_t denotes the type `f` yields invoked by
+ *        `invoke_success`
+ */
+template <typename Self, typename F>
+  using success_result_t =
+    decltype( invoke_success( std::declval<Self>(), std::declval<F>() ) );
+
+} // namespace mry::internal
+
+namespace mry {
+
+/**
+ * @brief niche_traits of the expected `void` of `mry::expect<void>`
+ */
+template <>
+  struct niche_traits< internal::unit<error_t> >
+    : internal::alignment_niche< internal::unit<error_t> >
+{};
+
+/**
+ * @brief niche_traits of references to objects
+ */
+template <typename T>
+    requires std::is_object_v<T>
+          && ( !std::is_unbounded_array_v<T> )
+  struct niche_traits< internal::reference<T> >
+    : internal::pointee_niche< internal::reference<T>, T >
+{};
+
+} // namespace mry
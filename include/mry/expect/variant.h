@@ -26,39 +26,132 @@
 
 #include <type_traits>
 #include <algorithm>
+#include <utility>
 #include <memory>
 
 namespace mry::internal {
 
+/**
+ * @brief variant_union is the union of its variadic `Types...` pack
+ *        argument -- holding none of them unless constructed in-place
+ *
+ * @note: its special members are trivial whenever those of all the
+ *        `Types...` are, not getting in the way of the triviality of
+ *        the variants built on it
+ */
+template <typename ...Types>
+  union variant_union;
+
+template <>
+  union variant_union<>
+{};
+
+template <typename Head, typename ...Tail>
+  union variant_union< Head, Tail... >
+{
+  static auto constexpr trivially_default_constructible =
+    std::is_trivially_default_constructible_v<Head>
+ && ( std::is_trivially_default_constructible_v<Tail> && ... );
+  static auto constexpr trivially_destructible =
+    std::is_trivially_destructible_v<Head>
+ && ( std::is_trivially_destructible_v<Tail> && ... );
+
+  /**
+   * @brief default constructs the union holding no alternative
+   */
+  constexpr variant_union() noexcept
+    requires trivially_default_constructible
+    =default;
+
+  /**
+   * @see: `variant_union()`
+   */
+  constexpr variant_union() noexcept
+    requires ( ! trivially_default_constructible )
+  {}
+
+  /**
+   * @brief destroys the union -- but no alternative it may hold
+   */
+  constexpr ~variant_union() noexcept
+    requires trivially_destructible
+    =default;
+
+  /**
+   * @see: `~variant_union()`
+   */
+  constexpr ~variant_union() noexcept
+    requires ( ! trivially_destructible )
+  {}
+
+  /**
+   * @brief alternative returns the location of the alternative T
+   *        -- the first of such type
+   */
+  template <typename T>
+    constexpr
+      auto alternative( mry::meta::type_tag<T> tag ) noexcept
+        -> T*
+  {
+    if constexpr (std::is_same_v<T, Head>)
+      return std::addressof(head);
+
+    else
+      return tail.alternative( tag );
+  }
+
+  /**
+   * @see: `alternative( mry::meta::type_tag<T> )`
+   */
+  template <typename T>
+    constexpr
+      auto alternative( mry::meta::type_tag<T> tag ) const noexcept
+        -> T const*
+  {
+    if constexpr (std::is_same_v<T, Head>)
+      return std::addressof(head);
+
+    else
+      return tail.alternative( tag );
+  }
+
+  Head                   head;
+  variant_union<Tail...> tail;
+};
+
 /**
  * @brief variant_storage defines the layout and alignment of
  *        storage capable of holding any of the types in its
  *        variadic `Types...` pack argument
  *
  * `variant_storage` also provde access to such {uninitialized}
- * storage to its subclasses
+ * storage to its subclasses -- both as raw bytes and by the location
+ * of each alternative
+ *
+ * @note: the alternatives are members of a union -- rather than being
+ *        placed in a buffer by address -- for constant evaluation to
+ *        track which of them is held
  */
 template <typename ...Types>
   class variant_storage
 {
     static auto constexpr storage_size =
       std::max({ sizeof(Types)... });
-    static auto constexpr store_alignment =
-      std::max({ alignof(Types)... });
 
     /**
      * @brief store defines the storage capable of holding
      *        any of the types in the variadic type
-     *        argument pack to `variant_storage`
+     *        argument pack to `variant_storage` -- its first
+     *        member being the raw bytes of such
      */
-    struct alignas(store_alignment) store final
-    {
-      char buffer[storage_size];
-    };
+    using store =
+      variant_union< char[storage_size], Types... >;
 
   public :
     using pointer =
       char*;
+    using const_pointer =
+      char const*;
 
     /**
      * @brief default constructs the uninitialized storage
@@ -70,9 +163,148 @@ template <typename ...Types>
      * @brief data returns a raw untyped pointer to the
      *        beginning of the storage region
      */
-    inline auto data() noexcept
-      -> pointer
-    { return &store_.buffer[0]; }
+    constexpr
+      auto data() noexcept
+        -> pointer
+    { return &store_.head[0]; }
+
+    /**
+     * @brief data returns a raw untyped pointer to the
+     *        beginning of the storage region
+     */
+    constexpr
+      auto data() const noexcept
+        -> const_pointer
+    { return &store_.head[0]; }
+
+    /**
+     * @brief alternative returns the location of the alternative T
+     *        within the storage
+     */
+    template <typename T>
+      constexpr
+        auto alternative( mry::meta::type_tag<T> tag ) noexcept
+          -> T*
+    { return store_.tail.alternative( tag ); }
+
+    /**
+     * @see: `alternative( mry::meta::type_tag<T> )`
+     */
+    template <typename T>
+      constexpr
+        auto alternative( mry::meta::type_tag<T> tag ) const noexcept
+          -> T const*
+    { return store_.tail.alternative( tag ); }
+
+  private :
+    store store_;
+};
+
+/**
+ * @brief disjoint_alternatives predicate tests whether the alternatives
+ *        `T, E` are laid out side by side rather than overlapping --
+ *        given T is a floating point type and doing so takes no storage
+ *        beyond that of overlapping them along with a flag telling them
+ *        apart
+ *
+ * @note: the Itanium ABI classifies the word of a union overlapping a
+ *        floating point T by an integral E as INTEGER -- returning it in
+ *        a general purpose register -- side by side the word of T is
+ *        classified SSE instead, as is `double` on its own
+ */
+template <typename ...Types>
+  inline auto constexpr disjoint_alternatives =
+    false;
+
+template <typename T, typename E>
+  inline auto constexpr disjoint_alternatives< T, E > =
+    std::is_floating_point_v<T>
+ && std::is_trivially_copyable_v<T>
+ && std::is_trivially_copyable_v<E>
+ && std::is_trivially_default_constructible_v<T>
+ && std::is_trivially_default_constructible_v<E>
+ && sizeof(T) % alignof(E) == 0
+ && ( sizeof(T) + sizeof(E) + std::max( alignof(T), alignof(E) ) ) / std::max( alignof(T), alignof(E) )
+      <= ( std::max( sizeof(T), sizeof(E) ) + std::max( alignof(T), alignof(E) ) ) / std::max( alignof(T), alignof(E) );
+
+/**
+ * @brief variant_storage of alternatives laid out side by side, along
+ *        with the flag telling those apart
+ *
+ * @note: the flag is held by the storage -- rather than following it
+ *        in the tail padding of the storage -- gcc otherwise copies the
+ *        instance through memory rather than in registers
+ *
+ * @see: `disjoint_alternatives<T, E>`
+ */
+template <typename T, typename E>
+    requires disjoint_alternatives<T, E>
+  class variant_storage< T, E >
+{
+    /**
+     * @brief store defines the alternatives and the flag as members
+     *        of a plain struct
+     */
+    struct store
+    {
+      T    success;
+      E    fail;
+      bool failed;
+    };
+
+  public :
+    /**
+     * @brief default constructs the uninitialized storage
+     */
+    constexpr variant_storage() noexcept
+      =default;
+
+    /**
+     * @brief alternative returns the location of the alternative U
+     *        within the storage
+     */
+    template <typename U>
+      constexpr
+        auto alternative( mry::meta::type_tag<U> ) noexcept
+          -> U*
+    {
+      if constexpr (std::is_same_v<U, T>)
+        return std::addressof(store_.success);
+
+      else
+        return std::addressof(store_.fail);
+    }
+
+    /**
+     * @see: `alternative( mry::meta::type_tag<U> )`
+     */
+    template <typename U>
+      constexpr
+        auto alternative( mry::meta::type_tag<U> ) const noexcept
+          -> U const*
+    {
+      if constexpr (std::is_same_v<U, T>)
+        return std::addressof(store_.success);
+
+      else
+        return std::addressof(store_.fail);
+    }
+
+    /**
+     * @brief failed returns the flag telling whether E is held
+     */
+    constexpr
+      auto failed() noexcept
+        -> bool&
+    { return store_.failed; }
+
+    /**
+     * @see: `failed()`
+     */
+    constexpr
+      auto failed() const noexcept
+        -> bool
+    { return store_.failed; }
 
   private :
     store store_;
@@ -87,6 +319,8 @@ template <typename T>
 {
   using reference =
     std::add_lvalue_reference_t<T>;
+  using const_reference =
+    std::add_lvalue_reference_t< std::add_const_t<T> >;
 
   /**
    * @brief default constructs an uninitialized alternative
@@ -95,32 +329,92 @@ template <typename T>
     =default;
 
   /**
-   * @brief in-place move constructs an alternative on the storage
-   *        denoted by `storage`
+   * @brief in-place move constructs an alternative at the location
+   *        `at` within the storage
+   */
+  constexpr
+    variant_alternative( T *at, T &&o ) noexcept
+  { std::construct_at( at, std::move(o) ); }
+
+  /**
+   * @brief construct constructs an alternative in-place at the location
+   *        `at` within the storage from `args`
    */
-  inline
-    variant_alternative( char *storage, T &&o ) noexcept
-  { std::construct_at( reinterpret_cast<T*>(storage), std::move(o) ); }
+  template <typename ...Args>
+    constexpr
+      auto construct( T *at, mry::meta::type_tag<T>, Args &&...args )
+        noexcept( std::is_nothrow_constructible_v<T, Args...> )
+          -> void
+  { std::construct_at( at, std::forward<Args>(args)... ); }
 
   /**
    * @brief destroys the alternative at its location
    */
-  auto destroy( T &o ) noexcept
-    -> void
+  constexpr
+    auto destroy( T &o ) noexcept
+      -> void
   { std::destroy_at( &o ); }
 
   /**
    * @brief get returns the reference of the {expected}
-   *        alternative type T at the designated `storage` location
+   *        alternative type T at the location `at`
    *
    * @note: it is the responsibility of the caller to ensure
-   *        `storage` does refer to a storage holding an initialized
-   *        instance of type T
+   *        `at` does refer to an initialized instance of type T
    */
-  inline
-    auto get( char *storage, mry::meta::type_tag<T> ) noexcept
+  constexpr
+    auto get( T *at, mry::meta::type_tag<T> ) noexcept
       -> reference
-  { return *reinterpret_cast<T*>(storage); }
+  { return *at; }
+
+  /**
+   * @brief get returns the const reference of the {expected}
+   *        alternative type T at the location `at`
+   *
+   * @see: `get( T*, mry::meta::type_tag<T> )`
+   */
+  constexpr
+    auto get( T const *at, mry::meta::type_tag<T> ) const noexcept
+      -> const_reference
+  { return *at; }
 };
 
+/**
+ * @brief trivially_copy_constructible concept describes alternative types
+ *        all of which are trivially copy constructible
+ */
+template <typename ...Types>
+  concept trivially_copy_constructible =
+    ( std::is_trivially_copy_constructible_v<Types> && ... );
+
+/**
+ * @brief trivially_move_constructible concept describes alternative types
+ *        all of which are trivially move constructible
+ */
+template <typename ...Types>
+  concept trivially_move_constructible =
+    ( std::is_trivially_move_constructible_v<Types> && ... );
+
+/**
+ * @brief trivially_copy_assignable concept describes alternative types
+ *        all of which are trivially copy constructible, assignable and
+ *        destructible
+ */
+template <typename ...Types>
+  concept trivially_copy_assignable =
+    ( ( std::is_trivially_copy_constructible_v<Types>
+     && std::is_trivially_copy_assignable_v<Types>
+     && std::is_trivially_destructible_v<Types> ) && ... );
+
+/**
+ * @brief trivially_move_assignable concept describes alternative types
+ *        all of which are trivially move constructible, assignable and
+ *        destructible
+ */
+template <typename ...Types>
+  concept trivially_move_assignable =
+    ( ( std::is_trivially_move_constructible_v<Types>
+     && std::is_trivially_move_assignable_v<Types>
+     && std::is_trivially_destructible_v<Types> ) && ... );
+
 } // namespace mry::internal
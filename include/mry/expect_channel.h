@@ -0,0 +1,602 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file expect_channel.h defines lock-free, bounded channels passing
+ *       `mry::expect<T, E>` results between threads
+ *
+ * @see: `mry::expect_channel<T, E, Mode>`
+ */
+#include "mry/expect.h"
+
+#include <type_traits>
+#include <algorithm>
+#include <optional>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <atomic>
+#include <memory>
+#include <bit>
+#include <new>
+
+namespace mry {
+
+/**
+ * @brief spsc denotes channels of a single producer and a single consumer
+ */
+struct spsc
+{};
+
+/**
+ * @brief mpmc denotes channels of multiple producers and multiple consumers
+ */
+struct mpmc
+{};
+
+namespace internal {
+
+/**
+ * @brief cache_line denotes the alignment separating the indices written
+ *        by producers from those written by consumers
+ *
+ * @note: `std::hardware_destructive_interference_size` is avoided as its
+ *        value is not ABI stable
+ */
+inline std::size_t constexpr cache_line =
+  64;
+
+/**
+ * @brief channel_slot describes the {uninitialized} storage of a value
+ *        in a channel, tagged by the alternative it holds
+ *
+ * a slot stores the alternatives of `expect<T, E>` unpacked -- an error
+ * condition is stored as its E handle alone, neither writing nor reading
+ * the storage of T nor the discriminant {or niche} `expect<T, E>` would
+ * encode it by.
+ *
+ * @note: every slot reserves the larger of T and E along with its tag,
+ *        as any slot of the ring may come to hold a T
+ *
+ * @note: moving into and out of a slot is required not to throw -- a
+ *        batch claimed by a single atomic operation could not be handed
+ *        back in part otherwise
+ */
+template <typename T, typename E>
+  struct channel_slot
+{
+  using value_type =
+    expect<T, E>;
+  using stored_type =
+    internal::stored_t<T, E>;
+
+  static_assert( std::is_nothrow_move_constructible_v<stored_type>
+              && std::is_nothrow_move_constructible_v<E>
+               , "expect_channel<T, E> requires nothrow move constructible T and E" );
+
+  alignas(stored_type) alignas(E)
+    std::byte storage[ std::max( sizeof(stored_type), sizeof(E) ) ];
+  bool        failed;
+
+  /**
+   * @brief construct moves the alternative `v` holds into the slot
+   */
+  inline
+    auto construct( value_type &&v ) noexcept
+      -> void
+  {
+    if (v.holds_error())
+      ::new (static_cast<void*>(storage)) E( std::move( v.fail() ) );
+
+    else if constexpr (std::is_void_v<T>)
+      ::new (static_cast<void*>(storage)) stored_type{};
+
+    else
+      ::new (static_cast<void*>(storage)) stored_type( internal::store<stored_type>( v.success() ) );
+
+    failed = v.holds_error();
+  }
+
+  /**
+   * @brief take moves the value out of the slot destroying it
+   */
+  inline
+    auto take() noexcept
+      -> value_type
+  {
+    if (failed)
+    {
+      auto &fail =
+        *std::launder( reinterpret_cast<E*>(storage) );
+      auto taken =
+        value_type{ internal::propagate, std::move(fail) };
+
+      fail.~E();
+
+      return taken;
+    }
+
+    auto &stored =
+      *std::launder( reinterpret_cast<stored_type*>(storage) );
+    auto taken =
+      [&]() -> value_type
+      {
+        if constexpr (std::is_void_v<T>)
+          return value_type{};
+
+        else if constexpr (std::is_reference_v<T>)
+          return value_type{ internal::unwrap(stored) };
+
+        else
+          return value_type{ std::move(stored) };
+      }();
+
+    stored.~stored_type();
+
+    return taken;
+  }
+};
+
+/**
+ * @brief channel_capacity returns `capacity` rounded up to a power of 2
+ */
+inline
+  auto channel_capacity( std::size_t capacity ) noexcept
+    -> std::size_t
+{ return std::bit_ceil( std::max( capacity, std::size_t{2} ) ); }
+
+} // namespace internal
+
+/**
+ * @brief expect_channel<T, E, Mode> is a lock-free, bounded ring buffer
+ *        of `mry::expect<T, E>` results
+ *
+ *   - `mry::spsc` channels synchronize a single producer and a single
+ *     consumer by a pair of indices
+ *   - `mry::mpmc` channels synchronize by a sequence per slot, claiming
+ *     slots by CAS on the shared indices
+ *
+ * `push_n()` and `pop_n()` move batches of values, claiming the slots of
+ * a batch by a single atomic operation on the shared index.
+ *
+ * @note: a failure is passed as its E handle alone, see
+ *        `internal::channel_slot<T, E>`
+ *
+ * @note: the capacity is rounded up to a power of 2
+ */
+template <typename T, typename E =error_t, typename Mode =mpmc>
+  class expect_channel;
+
+/**
+ * @brief expect_channel<T, E, spsc> is the single producer, single
+ *        consumer channel
+ *
+ * @see: `expect_channel<T, E, Mode>`
+ */
+template <typename T, typename E>
+  class expect_channel< T, E, spsc > final
+{
+    using slot_type =
+      internal::channel_slot<T, E>;
+
+  public :
+    using value_type =
+      expect<T, E>;
+
+    explicit
+      expect_channel( std::size_t capacity )
+        : mask_{ internal::channel_capacity( capacity ) - 1 }
+        , slots_{ std::make_unique<slot_type[]>( mask_ + 1 ) }
+    {}
+
+    expect_channel( expect_channel const & )
+      =delete;
+    auto operator=( expect_channel const & )
+      -> expect_channel& =delete;
+
+    /**
+     * @brief destroys the values left in the channel
+     */
+    ~expect_channel() noexcept
+    {
+      for (auto i =head_.load(); i != tail_.load(); ++i)
+        slots_[ i & mask_ ].take();
+    }
+
+    inline
+      auto capacity() const noexcept
+        -> std::size_t
+    { return mask_ + 1; }
+
+    /**
+     * @brief try_push moves `v` into the channel unless full
+     */
+    inline
+      auto try_push( value_type &&v )
+        -> bool
+    { return push_n( &v, 1 ) == 1; }
+
+    /**
+     * @brief try_pop moves the oldest value out of the channel unless empty
+     */
+    inline
+      auto try_pop()
+        -> std::optional<value_type>
+    {
+      auto popped =
+        std::optional<value_type>{};
+
+      consume_n( 1, [&]( value_type &&v ){ popped.emplace( std::move(v) ); } );
+
+      return popped;
+    }
+
+    /**
+     * @brief push_n moves at most `n` values from `first` into the channel,
+     *        returning the number of values moved
+     *
+     * @note: called by the producer only
+     */
+    template <std::input_iterator It>
+      auto push_n( It first, std::size_t n )
+        -> std::size_t
+    {
+      auto tail =
+        tail_.load( std::memory_order_relaxed );
+
+      if (capacity() - ( tail - head_cache_ ) < n)
+        head_cache_ =
+          head_.load( std::memory_order_acquire );
+
+      auto pushed =
+        std::min( n, capacity() - ( tail - head_cache_ ) );
+      auto i =
+        std::size_t{0};
+
+      try
+      {
+        for (; i < pushed; ++i, ++first)
+          slots_[ ( tail + i ) & mask_ ].construct( std::move(*first) );
+      }
+
+      catch (...)
+      {
+        /* @note: the values constructed before the throwing one are
+         *        published nonetheless */
+        tail_.store( tail + i, std::memory_order_release );
+        throw;
+      }
+
+      tail_.store( tail + pushed, std::memory_order_release );
+
+      return pushed;
+    }
+
+    /**
+     * @brief pop_n moves at most `n` values out of the channel into `out`,
+     *        returning the number of values moved
+     *
+     * @note: called by the consumer only
+     */
+    template <std::output_iterator<value_type> It>
+      auto pop_n( It out, std::size_t n )
+        -> std::size_t
+    { return consume_n( n, [&]( value_type &&v ){ *out++ = std::move(v); } ); }
+
+  private :
+    template <typename Sink>
+      auto consume_n( std::size_t n, Sink &&sink )
+        -> std::size_t
+    {
+      auto head =
+        head_.load( std::memory_order_relaxed );
+
+      if (tail_cache_ - head < n)
+        tail_cache_ =
+          tail_.load( std::memory_order_acquire );
+
+      auto popped =
+        std::min( n, tail_cache_ - head );
+      auto i =
+        std::size_t{0};
+
+      try
+      {
+        for (; i < popped; ++i)
+          sink( slots_[ ( head + i ) & mask_ ].take() );
+      }
+
+      catch (...)
+      {
+        /* @note: the value passed to the throwing sink is lost, those
+         *        past it remain in the channel */
+        head_.store( head + i + 1, std::memory_order_release );
+        throw;
+      }
+
+      head_.store( head + popped, std::memory_order_release );
+
+      return popped;
+    }
+
+    std::size_t                  mask_;
+    std::unique_ptr<slot_type[]> slots_;
+
+    /* @note: the indices and the caches of the opposite indices are
+     *        grouped by the thread writing them */
+    alignas(internal::cache_line) std::atomic<std::size_t> tail_ =0;
+    std::size_t                                            head_cache_ =0;
+
+    alignas(internal::cache_line) std::atomic<std::size_t> head_ =0;
+    std::size_t                                            tail_cache_ =0;
+};
+
+/**
+ * @brief expect_channel<T, E, mpmc> is the multiple producer, multiple
+ *        consumer channel
+ *
+ * each slot carries a sequence denoting whether it is free or full for
+ * the lap of the index referring to it -- a batch of consecutive slots
+ * available is claimed by a single CAS.
+ *
+ * should moving a value in or out of the channel throw, the cells claimed
+ * by the batch are released nonetheless -- those left unfilled are passed
+ * over by consumers, hence `try_pop()` may come back empty of a channel
+ * holding values past such a cell.
+ *
+ * @see: `expect_channel<T, E, Mode>`
+ */
+template <typename T, typename E>
+  class expect_channel< T, E, mpmc > final
+{
+    struct cell
+    {
+      std::atomic<std::size_t>                 sequence;
+      bool                                     filled;
+      internal::channel_slot<T, E>             slot;
+    };
+
+  public :
+    using value_type =
+      expect<T, E>;
+
+    explicit
+      expect_channel( std::size_t capacity )
+        : mask_{ internal::channel_capacity( capacity ) - 1 }
+        , cells_{ std::make_unique<cell[]>( mask_ + 1 ) }
+    {
+      for (auto i =std::size_t{0}; i <= mask_; ++i)
+        cells_[i].sequence.store( i, std::memory_order_relaxed );
+    }
+
+    expect_channel( expect_channel const & )
+      =delete;
+    auto operator=( expect_channel const & )
+      -> expect_channel& =delete;
+
+    /**
+     * @brief destroys the values left in the channel
+     */
+    ~expect_channel() noexcept
+    {
+      for (auto i =dequeue_.load(); i != enqueue_.load(); ++i)
+        if (cells_[ i & mask_ ].filled)
+          cells_[ i & mask_ ].slot.take();
+    }
+
+    inline
+      auto capacity() const noexcept
+        -> std::size_t
+    { return mask_ + 1; }
+
+    /**
+     * @brief try_push moves `v` into the channel unless full
+     */
+    inline
+      auto try_push( value_type &&v )
+        -> bool
+    { return push_n( &v, 1 ) == 1; }
+
+    /**
+     * @brief try_pop moves the oldest value out of the channel unless empty
+     */
+    inline
+      auto try_pop()
+        -> std::optional<value_type>
+    {
+      auto popped =
+        std::optional<value_type>{};
+
+      consume_n( 1, [&]( value_type &&v ){ popped.emplace( std::move(v) ); } );
+
+      return popped;
+    }
+
+    /**
+     * @brief push_n moves at most `n` values from `first` into the channel,
+     *        returning the number of values moved
+     */
+    template <std::input_iterator It>
+      auto push_n( It first, std::size_t n )
+        -> std::size_t
+    {
+      auto [pos, claimed] =
+        claim( enqueue_, n, 0 );
+      auto i =
+        std::size_t{0};
+
+      try
+      {
+        for (; i < claimed; ++i, ++first)
+        {
+          auto &c =
+            cells_[ ( pos + i ) & mask_ ];
+
+          c.slot.construct( std::move(*first) );
+          c.filled = true;
+          c.sequence.store( pos + i + 1, std::memory_order_release );
+        }
+      }
+
+      catch (...)
+      {
+        /* @note: the cells claimed are released unfilled, lest consumers
+         *        wait on them for good */
+        for (; i < claimed; ++i)
+        {
+          auto &c =
+            cells_[ ( pos + i ) & mask_ ];
+
+          c.filled = false;
+          c.sequence.store( pos + i + 1, std::memory_order_release );
+        }
+
+        throw;
+      }
+
+      return claimed;
+    }
+
+    /**
+     * @brief pop_n moves at most `n` values out of the channel into `out`,
+     *        returning the number of values moved
+     */
+    template <std::output_iterator<value_type> It>
+      auto pop_n( It out, std::size_t n )
+        -> std::size_t
+    { return consume_n( n, [&]( value_type &&v ){ *out++ = std::move(v); } ); }
+
+  private :
+    /**
+     * @brief claim claims at most `n` consecutive cells at `index` whose
+     *        sequence is `offset` past their position, returning the
+     *        first position claimed along with the number of cells
+     *
+     * @note: cells verified available remain so until claimed, as no
+     *        other thread may claim positions past `index`
+     */
+    auto claim( std::atomic<std::size_t> &index, std::size_t n, std::size_t offset ) noexcept
+      -> std::pair<std::size_t, std::size_t>
+    {
+      auto pos =
+        index.load( std::memory_order_relaxed );
+
+      /* @note: with no cell asked for, no cell is found available and the
+       *        lag of a free cell never turns negative */
+      if (n == 0)
+        return { pos, 0 };
+
+      for (;;)
+      {
+        auto available =
+          std::size_t{0};
+
+        while (available < n
+            && cells_[ ( pos + available ) & mask_ ].sequence.load( std::memory_order_acquire )
+               == pos + available + offset)
+          ++available;
+
+        if (available == 0)
+        {
+          auto lag =
+            static_cast<std::intptr_t>( cells_[ pos & mask_ ].sequence.load( std::memory_order_acquire )
+                                      - ( pos + offset ) );
+
+          /* @note: the cell is yet to be released by the opposite side
+           *        -- the channel is full or empty respectively */
+          if (lag < 0)
+            return { pos, 0 };
+
+          pos =
+            index.load( std::memory_order_relaxed );
+
+          continue;
+        }
+
+        if (index.compare_exchange_weak( pos, pos + available, std::memory_order_relaxed ))
+          return { pos, available };
+      }
+    }
+
+    template <typename Sink>
+      auto consume_n( std::size_t n, Sink &&sink )
+        -> std::size_t
+    {
+      auto [pos, claimed] =
+        claim( dequeue_, n, 1 );
+      auto consumed =
+        std::size_t{0};
+      auto i =
+        std::size_t{0};
+
+      auto release =
+        [&]( cell &c ) noexcept
+        { c.sequence.store( pos + i + mask_ + 1, std::memory_order_release ); };
+
+      try
+      {
+        for (; i < claimed; ++i)
+        {
+          auto &c =
+            cells_[ ( pos + i ) & mask_ ];
+
+          if (c.filled)
+          {
+            ++consumed;
+            sink( c.slot.take() );
+          }
+
+          release( c );
+        }
+      }
+
+      catch (...)
+      {
+        /* @note: the value passed to the throwing sink is lost, and so
+         *        are those claimed past it -- their cells are released
+         *        nonetheless, lest the channel be wedged */
+        release( cells_[ ( pos + i ) & mask_ ] );
+
+        for (++i; i < claimed; ++i)
+        {
+          auto &c =
+            cells_[ ( pos + i ) & mask_ ];
+
+          if (c.filled)
+            c.slot.take();
+
+          release( c );
+        }
+
+        throw;
+      }
+
+      return consumed;
+    }
+
+    std::size_t             mask_;
+    std::unique_ptr<cell[]> cells_;
+
+    alignas(internal::cache_line) std::atomic<std::size_t> enqueue_ =0;
+    alignas(internal::cache_line) std::atomic<std::size_t> dequeue_ =0;
+};
+
+} // namespace mry
@@ -0,0 +1,454 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file expect_vector.h defines a {structure of arrays} batch container
+ *       of `mry::expect<T>`s
+ *
+ * @see: `mry::expect_vector<T>`
+ */
+#include "mry/expect.h"
+
+#include <type_traits>
+#include <algorithm>
+#include <concepts>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <ranges>
+#include <vector>
+#include <span>
+#include <bit>
+
+namespace mry {
+
+/**
+ * @brief expect_vector<T> is a batch container of `mry::expect<T, E>`s
+ *        decomposed into a {structure of arrays} :
+ *
+ *   - the results of T stored contiguously, indexed by position
+ *   - the descriptions of E stored sparsely, side-indexed by position
+ *   - the states packed into a bitmap, a set bit denoting an error
+ *
+ * hence scanning for errors touches a bit per element, processing
+ * 64 elements per word -- rather than every cache line of the batch.
+ *
+ * @note: the results at positions holding an error are unspecified
+ *        {value-initialized} instances of T
+ *
+ * @note: T shall not be `bool`, the results of which `std::vector<bool>`
+ *        would pack into proxies rather than `bool&`s
+ *
+ * @see: `mry::expect<T, E>`
+ */
+template <typename T, typename E =error_t>
+  requires std::default_initializable<T>
+  class expect_vector final
+{
+    static_assert( ! std::same_as<T, bool>
+                 , "expect_vector<bool> is not supported, hold an `enum class : bool` instead" );
+
+    using word_type =
+      std::uint64_t;
+
+    static std::size_t constexpr word_bits =
+      64;
+
+  public :
+    using value_type =
+      expect<T, E>;
+    using success_type =
+      T;
+    using fail_type =
+      E;
+    using size_type =
+      std::size_t;
+
+    /**
+     * @brief error_entry describes an error condition met at `index`
+     */
+    struct error_entry
+    {
+      size_type index;
+      fail_type error;
+    };
+
+    class success_iterator;
+
+    /**
+     * @brief constructs an empty batch
+     */
+    expect_vector() noexcept
+      =default;
+
+    /**
+     * @brief size returns the number of elements in the batch
+     */
+    inline
+      auto size() const noexcept
+        -> size_type
+    { return values_.size(); }
+
+    inline
+      auto empty() const noexcept
+        -> bool
+    { return values_.empty(); }
+
+    /**
+     * @brief reserve reserves storage for `n` elements -- expecting
+     *        errors to be sparse
+     */
+    inline
+      auto reserve( size_type n )
+        -> void
+    {
+      values_.reserve( n );
+      bitmap_.reserve( words( n ) );
+    }
+
+    /**
+     * @brief clear erases all elements of the batch
+     */
+    inline
+      auto clear() noexcept
+        -> void
+    {
+      values_.clear();
+      bitmap_.clear();
+      errors_.clear();
+    }
+
+    /**
+     * @brief push_success appends the result `s`
+     */
+    inline
+      auto push_success( success_type s )
+        -> void
+    {
+      grow();
+      values_.push_back( std::move(s) );
+    }
+
+    /**
+     * @brief push_fail appends the description of the error condition `f`
+     */
+    inline
+      auto push_fail( fail_type f )
+        -> void
+    {
+      grow();
+      values_.emplace_back();
+
+      try
+      { errors_.push_back( error_entry{ values_.size() - 1, std::move(f) } ); }
+
+      catch (...)
+      {
+        values_.pop_back();
+        throw;
+      }
+
+      mark( errors_.back().index );
+    }
+
+    /**
+     * @brief push_back appends the alternative `e` holds
+     */
+    inline
+      auto push_back( value_type e )
+        -> void
+    {
+      if (e.holds_error())
+        return push_fail( std::move( e.fail() ) );
+
+      push_success( std::move( e.success() ) );
+    }
+
+    /**
+     * @brief holds_error predicate tests whether the element at `i`
+     *        denotes an error condition met
+     */
+    inline
+      auto holds_error( size_type i ) const noexcept
+        -> bool
+    { return ( bitmap_[ i / word_bits ] >> ( i % word_bits ) ) & 1; }
+
+    /**
+     * @brief success returns the result at `i`
+     *
+     * @note: it is the responsibility of the caller to ensure the
+     *        element at `i` holds the expected type T
+     */
+    inline
+      auto success( size_type i ) noexcept
+        -> success_type&
+    { return values_[i]; }
+
+    inline
+      auto success( size_type i ) const noexcept
+        -> success_type const&
+    { return values_[i]; }
+
+    /**
+     * @brief fail returns the description of the error condition
+     *        met at `i` -- in logarithmic time
+     *
+     * @note: it is the responsibility of the caller to ensure the
+     *        element at `i` holds an error
+     */
+    inline
+      auto fail( size_type i ) const noexcept
+        -> fail_type const&
+    {
+      return std::ranges::lower_bound( errors_, i, {}, &error_entry::index )
+             ->error;
+    }
+
+    /**
+     * @brief errors returns the errors of the batch -- ordered by position
+     */
+    inline
+      auto errors() const noexcept
+        -> std::span<error_entry const>
+    { return errors_; }
+
+    /**
+     * @brief count_errors returns the number of elements denoting an
+     *        error condition met
+     */
+    inline
+      auto count_errors() const noexcept
+        -> size_type
+    {
+      auto count =
+        size_type{0};
+
+      for (auto word : bitmap_)
+        count += std::popcount( word );
+
+      return count;
+    }
+
+    /**
+     * @brief first_error returns the position of the first element
+     *        denoting an error condition met -- or `size()` if none
+     */
+    inline
+      auto first_error() const noexcept
+        -> size_type
+    {
+      auto word =
+        std::ranges::find_if( bitmap_, []( word_type w ){ return w != 0; } );
+
+      if (word == bitmap_.end())
+        return size();
+
+      return static_cast<size_type>( word - bitmap_.begin() ) * word_bits
+           + std::countr_zero( *word );
+    }
+
+    /**
+     * @brief partition {stably} reorders the elements such that all
+     *        results precede all errors, returning the number of results
+     */
+    auto partition()
+      -> size_type
+    {
+      auto results =
+        size_type{0};
+      auto range =
+        successes();
+
+      for (auto s =range.begin(); s != range.end(); ++s, ++results)
+        if (s.index() != results)
+          values_[results] = std::move( values_[ s.index() ] );
+
+      for (auto i =results; i < size(); ++i)
+        values_[i] = success_type{};
+
+      for (auto k =size_type{0}; k < errors_.size(); ++k)
+        errors_[k].index = results + k;
+
+      std::ranges::fill( bitmap_, word_type{0} );
+
+      for (auto i =results; i < size(); ++i)
+        mark( i );
+
+      return results;
+    }
+
+    /**
+     * @brief successes returns the range of the results of the batch
+     *        -- skipping the errors by words of the bitmap
+     */
+    inline
+      auto successes() const noexcept
+        -> std::ranges::subrange<success_iterator>
+    { return { success_iterator{ this, next_success(0) }
+             , success_iterator{ this, size() } }; }
+
+  private :
+    static constexpr
+      auto words( size_type n ) noexcept
+        -> size_type
+    { return ( n + word_bits - 1 ) / word_bits; }
+
+    /**
+     * @brief grow extends the bitmap to address one more element
+     */
+    inline
+      auto grow()
+        -> void
+    {
+      if (size() % word_bits == 0)
+        bitmap_.push_back( 0 );
+    }
+
+    inline
+      auto mark( size_type i ) noexcept
+        -> void
+    { bitmap_[ i / word_bits ] |= word_type{1} << ( i % word_bits ); }
+
+    /**
+     * @brief results_from returns the bits of the results within the
+     *        word of `i` at or after `i` -- masking those past `size()`
+     */
+    inline
+      auto results_from( size_type i ) const noexcept
+        -> word_type
+    {
+      if (i >= size())
+        return 0;
+
+      auto results =
+        ~bitmap_[ i / word_bits ] & ( ~word_type{0} << ( i % word_bits ) );
+
+      if (i / word_bits == ( size() - 1 ) / word_bits && size() % word_bits)
+        results &= ~( ~word_type{0} << ( size() % word_bits ) );
+
+      return results;
+    }
+
+    /**
+     * @brief next_success returns the position of the first result
+     *        at or after `i` -- or `size()` if none
+     */
+    inline
+      auto next_success( size_type i ) const noexcept
+        -> size_type
+    {
+      for (; i < size(); i = ( i / word_bits + 1 ) * word_bits)
+        if (auto results =results_from( i ))
+          return ( i / word_bits ) * word_bits + std::countr_zero( results );
+
+      return size();
+    }
+
+    std::vector<success_type> values_;
+    std::vector<word_type>    bitmap_;
+    std::vector<error_entry>  errors_;
+};
+
+/**
+ * @brief success_iterator iterates over the results of an
+ *        `expect_vector<T>`
+ */
+template <typename T, typename E>
+  requires std::default_initializable<T>
+  class expect_vector<T, E>::success_iterator final
+{
+  public :
+    using value_type =
+      T;
+    using difference_type =
+      std::ptrdiff_t;
+    using iterator_concept =
+      std::forward_iterator_tag;
+
+    success_iterator() noexcept
+      =default;
+
+    success_iterator( expect_vector const *v, size_type i ) noexcept
+      : vector_{ v }
+      , index_{ i }
+      , results_{ v->results_from(i) }
+    {}
+
+    inline
+      auto operator*() const noexcept
+        -> T const&
+    { return vector_->values_[ index_ ]; }
+
+    inline
+      auto operator++() noexcept
+        -> success_iterator&
+    {
+      /* @note: the results of the current word are consumed bit by bit,
+       *        the bitmap being scanned only once they are exhausted */
+      results_ &= results_ - 1;
+
+      if (results_ != 0)
+        index_ =
+          ( index_ / word_bits ) * word_bits + std::countr_zero( results_ );
+
+      else
+      {
+        index_ =
+          vector_->next_success( ( index_ / word_bits + 1 ) * word_bits );
+        results_ =
+          vector_->results_from( index_ );
+      }
+
+      return *this;
+    }
+
+    inline
+      auto operator++(int) noexcept
+        -> success_iterator
+    {
+      auto former =
+        *this;
+
+      ++*this;
+
+      return former;
+    }
+
+    /**
+     * @brief index returns the position of the result referred to
+     */
+    inline
+      auto index() const noexcept
+        -> size_type
+    { return index_; }
+
+    inline
+      auto operator==( success_iterator const &o ) const noexcept
+        -> bool
+    { return index_ == o.index_; }
+
+  private :
+    expect_vector const *vector_ =nullptr;
+    size_type            index_ =0;
+    word_type            results_ =0;
+};
+
+} // namespace mry
@@ -22,6 +22,30 @@
  * @file meta.h defines convenience facilities for expressing types in
  *       templated {meta} contexts
  */
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief MRY_META_WITHIN_LIFETIME denotes whether `within_lifetime()` is
+ *        usable within constant evaluation -- as are `mry::error_t` and
+ *        the niches of `mry::expect<T>` given so
+ *
+ * @note: C++20 offers no test of the active member of a union but a flag
+ *        tracking it -- the very storage a niche spares -- alternatives
+ *        told apart by a flag are usable on any compiler
+ */
+#if defined(__cpp_lib_is_within_lifetime)
+#  define MRY_META_WITHIN_LIFETIME 1
+#elif defined(__has_builtin)
+#  if __has_builtin(__builtin_is_within_lifetime) || ( defined(__GNUC__) && !defined(__clang__) )
+#    define MRY_META_WITHIN_LIFETIME 1
+#  else
+#    define MRY_META_WITHIN_LIFETIME 0
+#  endif
+#else
+#  define MRY_META_WITHIN_LIFETIME 0
+#endif
+
 namespace mry::meta {
 
 /**
@@ -41,4 +65,68 @@ template <typename T>
   inline auto constexpr type =
     type_tag<T>{};
 
+/**
+ * @brief forward_like forwards `o` -- a member of an instance of type
+ *        `Like` -- as of the value category of such instance
+ *
+ * @note: forwarding an lvalue `Like` yields `o` as is, anything else
+ *        yields `o` moved
+ */
+template <typename Like, typename T>
+  constexpr
+    auto forward_like( T &o ) noexcept
+      -> decltype(auto)
+{
+  if constexpr (std::is_lvalue_reference_v<Like>)
+    return (o);
+
+  else
+    return std::move(o);
+}
+
+/**
+ * @brief no_lifetime_test stands for the lifetime test of compilers
+ *        providing none -- not being usable within constant evaluation
+ */
+inline
+  auto no_lifetime_test( void const * ) noexcept
+    -> bool
+{ return false; }
+
+/**
+ * @brief within_lifetime predicate tests whether `o` -- a scalar member
+ *        of a union -- is within its lifetime, ie. is the member active
+ *
+ * C++20 offers no such test, hence it is made by `std::is_within_lifetime`
+ * given the library provides it, by `__builtin_is_within_lifetime` given
+ * the compiler does, and by gcc otherwise relying on `__builtin_constant_p`
+ * folding the read of a member not within its lifetime to "not constant"
+ * -- the member is compared to a value initialized one, as a pointer to
+ *    an allocation within the evaluation is "not constant" itself
+ *
+ * @note: only to be called within constant evaluation -- compilers
+ *        providing none of the above fail such evaluation, see
+ *        `MRY_META_WITHIN_LIFETIME`
+ */
+template <typename T>
+    requires std::is_scalar_v<T>
+  constexpr
+    auto within_lifetime( T const *o ) noexcept
+      -> bool
+{
+#if defined(__cpp_lib_is_within_lifetime)
+  return std::is_within_lifetime( o );
+#elif defined(__has_builtin)
+# if __has_builtin(__builtin_is_within_lifetime)
+  return __builtin_is_within_lifetime( o );
+# elif defined(__GNUC__) && !defined(__clang__)
+  return __builtin_constant_p( *o == T{} );
+# else
+  return no_lifetime_test( o );
+# endif
+#else
+  return no_lifetime_test( o );
+#endif
+}
+
 } // namespace mry::meta
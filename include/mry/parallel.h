@@ -0,0 +1,511 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file parallel.h defines parallel algorithms over ranges of fallible
+ *       operations -- short-circuiting on errors
+ *
+ * @see: `mry::parallel_collect()`
+ * @see: `mry::parallel_transform_reduce()`
+ */
+#include "mry/executor.h"
+#include "mry/expect.h"
+
+#include <type_traits>
+#include <functional>
+#include <algorithm>
+#include <optional>
+#include <iterator>
+#include <cstddef>
+#include <utility>
+#include <atomic>
+#include <memory>
+#include <ranges>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+namespace mry {
+
+/**
+ * @brief parallel_policy describes how the work of parallel algorithms
+ *        is split : into chunks of `grain` elements processed by at
+ *        most `threads` threads -- the calling one included, the others
+ *        running as jobs of `pool`
+ *
+ * @note: given no `pool`, the jobs run on an executor shared by the
+ *        parallel algorithms of the process -- created on first use
+ */
+struct parallel_policy
+{
+  std::size_t threads =
+    std::max( 1u, std::thread::hardware_concurrency() );
+  std::size_t grain =
+    4096;
+  executor   *pool =
+    nullptr;
+};
+
+namespace internal {
+
+/**
+ * @brief parallel_executor returns the executor shared by the parallel
+ *        algorithms given no `parallel_policy::pool`
+ */
+inline
+  auto parallel_executor()
+    -> executor&
+{
+  static auto pool =
+    executor{};
+
+  return pool;
+}
+
+/**
+ * @brief chunk_state describes the chunks handed out by `run_chunks()`,
+ *        shared with the jobs helping to process them
+ *
+ * @note: jobs running once the calling thread closed the state -- eg.
+ *        queued behind workers blocked on the very same algorithm --
+ *        return at once, the calling thread only waiting on the jobs
+ *        already helping
+ */
+struct chunk_state
+{
+  std::atomic<std::size_t> next =0;
+  std::atomic<std::size_t> helping =0;
+  std::atomic<bool>        closed =false;
+};
+
+/**
+ * @brief parallel_result_t describes the `expect<T, E>` returned by
+ *        invoking F on the elements of R
+ */
+template <typename F, typename R>
+  using parallel_result_t =
+    std::invoke_result_t< F&, std::ranges::range_reference_t<R> >;
+
+template <typename F, typename R>
+  concept parallel_invocable =
+    std::ranges::random_access_range<R>
+    && std::ranges::sized_range<R>
+    && std::invocable< F&, std::ranges::range_reference_t<R> >
+    && is_expect_v< parallel_result_t<F, R> >;
+
+/**
+ * @brief chunk_count returns the number of chunks of `grain` elements
+ *        `size` elements are split into
+ *
+ * @note: computed so as not to wrap given any `grain`
+ */
+constexpr
+  auto chunk_count( std::size_t size, std::size_t grain ) noexcept
+    -> std::size_t
+{ return size / grain + ( size % grain != 0 ); }
+
+/**
+ * @brief chunk_end returns the position one past the last element of
+ *        chunk `c` of `chunk_count( size, grain )`
+ */
+constexpr
+  auto chunk_end( std::size_t c, std::size_t size, std::size_t grain ) noexcept
+    -> std::size_t
+{ return c * grain + std::min( grain, size - c * grain ); }
+
+/**
+ * @brief run_chunks invokes `chunk` on each index in `[0, chunks)` across
+ *        at most `policy.threads` threads, chunks being handed out in
+ *        order
+ *
+ * @note: the calling thread participates and returns once all
+ *        chunks are processed -- or, should `chunk` throw on it, once
+ *        the chunks being processed by others are
+ */
+template <typename Chunk>
+  auto run_chunks( std::size_t chunks, parallel_policy const &policy, Chunk &chunk )
+    -> void
+{
+  auto state =
+    std::make_shared<chunk_state>();
+
+  auto work =
+    [&chunk, chunks, &next =state->next]
+    {
+      for (auto c =next++; c < chunks; c = next++)
+        chunk( c );
+    };
+
+  auto join =
+    [&state]
+    {
+      state->closed.store( true );
+
+      for (auto h =state->helping.load(); h != 0; h = state->helping.load())
+        state->helping.wait( h );
+    };
+
+  auto helpers =
+    std::min( policy.threads, chunks );
+
+  try
+  {
+    if (helpers > 1)
+    {
+      auto &pool =
+        policy.pool ? *policy.pool
+                    : parallel_executor();
+
+      helpers =
+        std::min( helpers - 1, pool.threads() );
+
+      /* @note: `helping` and `closed` being accessed sequentially
+       *        consistent on both sides, either a job observes the state
+       *        closed or the calling thread observes the job helping */
+      for (auto h =std::size_t{0}; h < helpers; ++h)
+        pool.submit( [state, &work]
+                     {
+                       state->helping.fetch_add( 1 );
+
+                       if (!state->closed.load())
+                         work();
+
+                       state->helping.fetch_sub( 1 );
+                       state->helping.notify_all();
+                     } );
+    }
+
+    work();
+  }
+
+  catch (...)
+  {
+    /* @note: the jobs refer to `work` on this stack, hence are waited
+     *        for before rethrowing -- the chunks not yet handed out
+     *        being skipped */
+    state->next.store( chunks );
+    join();
+    throw;
+  }
+
+  join();
+}
+
+/**
+ * @brief first_error records the error met at the lowest position
+ *        across the workers of a parallel algorithm, its position
+ *        cancelling any work beyond it cooperatively
+ */
+template <typename E>
+  class first_error final
+{
+  public :
+    explicit
+      first_error( std::size_t size ) noexcept
+        : at_{ size }
+    {}
+
+    /**
+     * @brief cancelled predicate tests whether the work at `i` is
+     *        made obsolete by an error met before it
+     */
+    inline
+      auto cancelled( std::size_t i ) const noexcept
+        -> bool
+    { return i > at_.load( std::memory_order_relaxed ); }
+
+    /**
+     * @brief record records the error `e` met at `i`
+     */
+    auto record( std::size_t i, E &&e )
+      -> void
+    {
+      auto lock =
+        std::scoped_lock{ mutex_ };
+
+      if (error_ && i >= at_.load( std::memory_order_relaxed ))
+        return;
+
+      error_.emplace( std::move(e) );
+      at_.store( i, std::memory_order_relaxed );
+    }
+
+    /**
+     * @brief get returns the error met at the lowest position -- if any
+     *
+     * @note: it is the responsibility of the caller to ensure all
+     *        workers have finished
+     */
+    inline
+      auto get() noexcept
+        -> std::optional<E>&
+    { return error_; }
+
+  private :
+    std::atomic<std::size_t> at_;
+    std::mutex               mutex_;
+    std::optional<E>         error_;
+};
+
+/**
+ * @brief concat returns the concatenation of `chunks`
+ */
+template <typename T>
+  auto concat( std::vector<std::vector<T>> &&chunks )
+    -> std::vector<T>
+{
+  auto size =
+    std::size_t{0};
+
+  for (auto const &chunk : chunks)
+    size += chunk.size();
+
+  auto all =
+    std::vector<T>{};
+
+  all.reserve( size );
+
+  for (auto &chunk : chunks)
+    std::ranges::move( chunk, std::back_inserter( all ) );
+
+  return all;
+}
+
+} // namespace internal
+
+/**
+ * @brief parallel_collect returns the results of invoking `f` on the
+ *        elements of `range` -- in order -- or the error met at the
+ *        lowest position
+ *
+ * once an error is met the chunks beyond it are cancelled cooperatively,
+ * while the ones before it still run to completion -- hence the error
+ * returned does not depend on the scheduling of the workers.
+ *
+ * ```cpp
+ * auto parsed =
+ *   mry::parallel_collect( lines, parse );
+ * ```
+ *
+ * @note: `f` is invoked concurrently, it is required not to throw
+ */
+template <typename R, typename F>
+  requires internal::parallel_invocable<F, R>
+  auto parallel_collect( R &&range, F f, parallel_policy policy ={} )
+    -> expect< std::vector< typename internal::parallel_result_t<F, R>::success_type >
+             , typename internal::parallel_result_t<F, R>::fail_type >
+{
+  using result_type =
+    internal::parallel_result_t<F, R>;
+  using success_type =
+    typename result_type::success_type;
+  using fail_type =
+    typename result_type::fail_type;
+
+  auto size =
+    static_cast<std::size_t>( std::ranges::size(range) );
+  auto grain =
+    std::max( std::size_t{1}, policy.grain );
+  auto chunks =
+    internal::chunk_count( size, grain );
+
+  auto collected =
+    std::vector< std::vector<success_type> >( chunks );
+  auto error =
+    internal::first_error<fail_type>{ size };
+
+  auto chunk =
+    [&]( std::size_t c )
+    {
+      auto first =
+        std::ranges::begin( range );
+      auto last =
+        internal::chunk_end( c, size, grain );
+
+      collected[c].reserve( last - c * grain );
+
+      for (auto i =c * grain; i < last; ++i)
+      {
+        if (error.cancelled( i ))
+          return;
+
+        auto result =
+          std::invoke( f, first[i] );
+
+        if (result.holds_error())
+          return error.record( i, std::move( result.fail() ) );
+
+        collected[c].push_back( std::move( result.success() ) );
+      }
+    };
+
+  internal::run_chunks( chunks, policy, chunk );
+
+  if (error.get())
+    return { internal::propagate, std::move( *error.get() ) };
+
+  return internal::concat( std::move(collected) );
+}
+
+/**
+ * @brief parallel_collect_all returns the results of invoking `f` on the
+ *        elements of `range` -- in order -- or all errors met, ordered
+ *        by position
+ *
+ * @note: `f` is invoked concurrently, it is required not to throw
+ */
+template <typename R, typename F>
+  requires internal::parallel_invocable<F, R>
+  auto parallel_collect_all( R &&range, F f, parallel_policy policy ={} )
+    -> expect< std::vector< typename internal::parallel_result_t<F, R>::success_type >
+             , std::vector< typename internal::parallel_result_t<F, R>::fail_type > >
+{
+  using result_type =
+    internal::parallel_result_t<F, R>;
+  using success_type =
+    typename result_type::success_type;
+  using fail_type =
+    typename result_type::fail_type;
+
+  auto size =
+    static_cast<std::size_t>( std::ranges::size(range) );
+  auto grain =
+    std::max( std::size_t{1}, policy.grain );
+  auto chunks =
+    internal::chunk_count( size, grain );
+
+  auto collected =
+    std::vector< std::vector<success_type> >( chunks );
+  auto errors =
+    std::vector< std::vector<fail_type> >( chunks );
+
+  auto chunk =
+    [&]( std::size_t c )
+    {
+      auto first =
+        std::ranges::begin( range );
+      auto last =
+        internal::chunk_end( c, size, grain );
+
+      for (auto i =c * grain; i < last; ++i)
+      {
+        auto result =
+          std::invoke( f, first[i] );
+
+        if (result.holds_error())
+          errors[c].push_back( std::move( result.fail() ) );
+
+        /* @note: results are of no use once an error is met */
+        else if (errors[c].empty())
+          collected[c].push_back( std::move( result.success() ) );
+      }
+    };
+
+  internal::run_chunks( chunks, policy, chunk );
+
+  auto all =
+    internal::concat( std::move(errors) );
+
+  if (!all.empty())
+    return all;
+
+  return internal::concat( std::move(collected) );
+}
+
+/**
+ * @brief parallel_transform_reduce returns the reduction of `init` and
+ *        the results of invoking `transform` on the elements of `range`
+ *        by `reduce` -- or the error met at the lowest position
+ *
+ * @note: `reduce` is required to be associative -- not commutative,
+ *        the partial reductions of chunks are reduced in order
+ *
+ * @see: `parallel_collect()`
+ */
+template <typename R, typename T, typename Reduce, typename F>
+  requires internal::parallel_invocable<F, R>
+  auto parallel_transform_reduce( R &&range
+                                , T init
+                                , Reduce reduce
+                                , F transform
+                                , parallel_policy policy ={} )
+    -> expect< T, typename internal::parallel_result_t<F, R>::fail_type >
+{
+  using result_type =
+    internal::parallel_result_t<F, R>;
+  using fail_type =
+    typename result_type::fail_type;
+
+  auto size =
+    static_cast<std::size_t>( std::ranges::size(range) );
+  auto grain =
+    std::max( std::size_t{1}, policy.grain );
+  auto chunks =
+    internal::chunk_count( size, grain );
+
+  auto partials =
+    std::vector< std::optional<T> >( chunks );
+  auto error =
+    internal::first_error<fail_type>{ size };
+
+  auto chunk =
+    [&]( std::size_t c )
+    {
+      auto first =
+        std::ranges::begin( range );
+      auto last =
+        internal::chunk_end( c, size, grain );
+      auto &partial =
+        partials[c];
+
+      for (auto i =c * grain; i < last; ++i)
+      {
+        if (error.cancelled( i ))
+          return;
+
+        auto result =
+          std::invoke( transform, first[i] );
+
+        if (result.holds_error())
+          return error.record( i, std::move( result.fail() ) );
+
+        if (partial)
+          partial =
+            std::invoke( reduce, std::move(*partial), std::move( result.success() ) );
+
+        else
+          partial.emplace( std::move( result.success() ) );
+      }
+    };
+
+  internal::run_chunks( chunks, policy, chunk );
+
+  if (error.get())
+    return { internal::propagate, std::move( *error.get() ) };
+
+  for (auto &partial : partials)
+    if (partial)
+      init =
+        std::invoke( reduce, std::move(init), std::move(*partial) );
+
+  return init;
+}
+
+} // namespace mry
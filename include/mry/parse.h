@@ -0,0 +1,446 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file parse.h defines parsers of integers and floating point numbers
+ *       from text -- validating digits by SIMD instructions and
+ *       reporting error conditions by `mry::parse_errc`, never allocating
+ *
+ * ```cpp
+ * auto port =
+ *   mry::parse<std::uint16_t>( "8080" );
+ *
+ * auto file =
+ *   mry::mapped_file::open( "samples.txt" );
+ * auto samples =
+ *   mry::parse_many<double>( file.success().text() );
+ * ```
+ *
+ * @see: `mry::parse<T>( std::string_view )`
+ * @see: `mry::parse_many<T>( std::string_view )`
+ */
+#include "mry/parse/mapped_file.h"
+#include "mry/parse/simd.h"
+#include "mry/expect_vector.h"
+#include "mry/error_code.h"
+#include "mry/expect.h"
+
+#include <system_error>
+#include <string_view>
+#include <type_traits>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <array>
+#include <bit>
+
+namespace mry {
+
+/**
+ * @brief parse_errc describes the error conditions parsing may meet
+ */
+enum class parse_errc : std::uint8_t
+{
+  empty,
+  invalid_char,
+  overflow
+};
+
+template <>
+  struct error_category< parse_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "parse" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "empty", "invalid char", "value out of range" });
+};
+
+/**
+ * @brief parsable concept describes the types `mry::parse<T>` parses :
+ *        integers but `bool`, `float` and `double`
+ */
+template <typename T>
+  concept parsable =
+    ( std::integral<T> && ! std::same_as<T, bool> )
+ || std::same_as<T, float>
+ || std::same_as<T, double>;
+
+namespace internal {
+
+/**
+ * @brief from_digits converts the digits in `[first, last)` into T --
+ *        negated given `negative`
+ *
+ * @note: it is the responsibility of the caller to ensure
+ *        `[first, last)` are digits, at least one
+ */
+template <std::integral T>
+  auto from_digits( char const *first
+                  , char const *last
+                  , char const *readable
+                  , bool negative ) noexcept
+    -> expect<T, parse_errc>
+{
+  while (last - first > 1 && *first == '0')
+    ++first;
+
+  auto value =
+    std::uint64_t{};
+
+  if (last - first > std::numeric_limits<std::uint64_t>::digits10 + 1
+   || ! parse_digits( first, last, readable, value ))
+    return parse_errc::overflow;
+
+  auto constexpr max =
+    static_cast<std::uint64_t>( std::numeric_limits<T>::max() );
+
+  if (value > max + ( negative ? 1 : 0 ))
+    return parse_errc::overflow;
+
+  return static_cast<T>( negative ? 0 - value : value );
+}
+
+/**
+ * @brief parse_integer parses the integer T in `[first, last)` --
+ *        optionally preceded by `'-'` given T is signed
+ */
+template <std::integral T>
+  auto parse_integer( char const *first, char const *last, char const *readable ) noexcept
+    -> expect<T, parse_errc>
+{
+  if (first == last)
+    return parse_errc::empty;
+
+  auto negative =
+    std::is_signed_v<T> && *first == '-';
+
+  first += negative;
+
+  if (first == last || digit_prefix( first, last ) != last)
+    return parse_errc::invalid_char;
+
+  return from_digits<T>( first, last, readable, negative );
+}
+
+/**
+ * @brief exact_powers denotes the powers of ten T represents exactly
+ */
+template <std::floating_point T>
+  inline auto constexpr exact_powers =
+    []() constexpr
+      {
+        auto powers =
+          std::array< T, std::is_same_v<T, float> ? 11 : 23 >{};
+
+        powers[0] = 1;
+
+        for (auto i =std::size_t{1}; i < powers.size(); ++i)
+          powers[i] = powers[i - 1] * 10;
+
+        return powers;
+      }();
+
+/**
+ * @brief parse_floating parses the decimal floating point number T in
+ *        `[first, last)` -- `-? digits? (. digits?)? ([eE] [+-]? digits)?`
+ *        having at least one digit in its significand
+ *
+ * @note: significands of up to 19 digits, exactly representable by T,
+ *        scaled by exactly representable powers of ten are converted
+ *        by a single multiplication or division -- correctly rounded
+ *        -- anything else by `std::from_chars`
+ */
+template <std::floating_point T>
+  auto parse_floating( char const *first, char const *last, char const *readable ) noexcept
+    -> expect<T, parse_errc>
+{
+  if (first == last)
+    return parse_errc::empty;
+
+  auto at =
+    first + ( *first == '-' );
+  auto integral_first =
+    at;
+  auto integral_last =
+    at = digit_prefix( at, last );
+  auto fraction_first =
+    at;
+  auto fraction_last =
+    at;
+
+  if (at != last && *at == '.')
+  {
+    fraction_first =
+      at + 1;
+    fraction_last =
+      at = digit_prefix( fraction_first, last );
+  }
+
+  if (integral_first == integral_last && fraction_first == fraction_last)
+    return parse_errc::invalid_char;
+
+  auto exponent =
+    std::int64_t{0};
+
+  if (at != last && ( *at == 'e' || *at == 'E' ))
+  {
+    ++at;
+
+    auto negative =
+      at != last && *at == '-';
+
+    at += at != last && ( *at == '-' || *at == '+' );
+
+    auto digits_last =
+      digit_prefix( at, last );
+
+    if (digits_last == at)
+      return parse_errc::invalid_char;
+
+    for (; at != digits_last; ++at)
+      if (exponent < 100000)
+        exponent = exponent * 10 + ( *at - '0' );
+
+    if (negative)
+      exponent = -exponent;
+  }
+
+  if (at != last)
+    return parse_errc::invalid_char;
+
+  while (integral_first != integral_last && *integral_first == '0')
+    ++integral_first;
+
+  auto integral_digits =
+    integral_last - integral_first;
+  auto fraction_digits =
+    fraction_last - fraction_first;
+
+  if (integral_digits + fraction_digits <= std::numeric_limits<std::uint64_t>::digits10)
+  {
+    auto integral =
+      std::uint64_t{};
+    auto fraction =
+      std::uint64_t{};
+
+    parse_digits( integral_first, integral_last, readable, integral );
+    parse_digits( fraction_first, fraction_last, readable, fraction );
+
+    for (auto i =decltype(fraction_digits){0}; i < fraction_digits; ++i)
+      integral *= 10;
+
+    auto significand =
+      integral + fraction;
+    auto scale =
+      exponent - fraction_digits;
+
+    auto constexpr & powers =
+      exact_powers<T>;
+    auto constexpr exact =
+      std::uint64_t{1} << std::numeric_limits<T>::digits;
+
+    if (significand <= exact
+     && scale > -static_cast<std::int64_t>( powers.size() )
+     && scale <  static_cast<std::int64_t>( powers.size() ))
+    {
+      auto value =
+        scale < 0 ? static_cast<T>( significand ) / powers[ -scale ]
+                  : static_cast<T>( significand ) * powers[ scale ];
+
+      return *first == '-' ? -value : value;
+    }
+  }
+
+  auto value =
+    T{};
+  auto [_, error] =
+    std::from_chars( first, last, value, std::chars_format::general );
+
+  if (error == std::errc::result_out_of_range)
+    return parse_errc::overflow;
+
+  if (error != std::errc{})
+    return parse_errc::invalid_char;
+
+  return value;
+}
+
+/**
+ * @brief parse_token parses the T in `[first, last)`, `readable`
+ *        bounding the chars readable beyond `last`
+ */
+template <parsable T>
+  auto parse_token( char const *first, char const *last, char const *readable ) noexcept
+    -> expect<T, parse_errc>
+{
+  if constexpr (std::is_floating_point_v<T>)
+    return parse_floating<T>( first, last, readable );
+
+  else
+    return parse_integer<T>( first, last, readable );
+}
+
+} // namespace internal
+
+/**
+ * @brief parse parses `text` as a T -- a decimal integer, or a decimal
+ *        floating point number without `inf` or `nan`
+ *
+ * @note: unlike `std::stoi`, neither whitespace nor a leading `'+'` is
+ *        accepted, nor are trailing chars ignored -- just like by
+ *        `std::from_chars` but for the latter
+ */
+template <parsable T>
+  auto parse( std::string_view text ) noexcept
+    -> expect<T, parse_errc>
+{
+  return internal::parse_token<T>( text.data()
+                                 , text.data() + text.size()
+                                 , text.data() + text.size() );
+}
+
+/**
+ * @brief parse_many parses each token of `text` as a T appending the
+ *        results to `out` -- tokens being separated by runs of
+ *        whitespace, control chars or `','`s
+ *
+ * `text` is classified by windows of 64 chars, a separator and a digit
+ * bitmask each, by SIMD instructions. tokens are then found by counting
+ * the trailing zeros of such bitmasks, and integer tokens known to
+ * consist of digits converted without validating them again.
+ *
+ * @note: error conditions are reported per token -- at their position
+ *        in `out` -- parsing carries on past them
+ */
+template <parsable T>
+  auto parse_many( std::string_view text, expect_vector<T, parse_errc> &out )
+    -> void
+{
+  auto const first =
+    text.data();
+  auto const size =
+    text.size();
+  auto const readable =
+    first + size;
+
+  auto above =
+    []( std::size_t bit ) noexcept
+      { return bit < internal::window_width ? ~std::uint64_t{0} << bit : 0; };
+
+  auto emit =
+    [&]( std::size_t from, std::size_t to, bool digits )
+      {
+        if constexpr (std::is_integral_v<T>)
+          if (digits)
+            return out.push_back( internal::from_digits<T>( first + from, first + to, readable, false ) );
+
+        out.push_back( internal::parse_token<T>( first + from, first + to, readable ) );
+      };
+
+  for (auto at =std::size_t{0}; at < size; )
+  {
+    /* @note: the last window is classified from a copy padded by
+     *        separators, hence ending any token at the end of `text` */
+    char padded[ internal::window_width ];
+
+    auto window =
+      first + at;
+
+    if (size - at < internal::window_width)
+    {
+      std::memset( padded, ' ', sizeof(padded) );
+      std::memcpy( padded, window, size - at );
+
+      window = padded;
+    }
+
+    auto classes =
+      internal::classify_window( window );
+
+    for (auto consumed =std::size_t{0};; )
+    {
+      auto starts =
+        ~classes.separators & above( consumed );
+
+      if (starts == 0)
+      {
+        at += internal::window_width;
+        break;
+      }
+
+      auto start =
+        static_cast<std::size_t>( std::countr_zero( starts ) );
+      auto ends =
+        classes.separators & above( start );
+
+      if (ends == 0 && start != 0)
+      {
+        at += start;
+        break;
+      }
+
+      if (ends == 0)
+      {
+        /* @note: tokens spanning whole windows are rare, hence ended
+         *        char by char */
+        auto end =
+          at;
+
+        while (end < size && ! internal::is_separator( first[end] ))
+          ++end;
+
+        emit( at, end, false );
+
+        at = end;
+        break;
+      }
+
+      auto end =
+        static_cast<std::size_t>( std::countr_zero( ends ) );
+      auto span =
+        ( ~std::uint64_t{0} >> ( internal::window_width - ( end - start ) ) ) << start;
+
+      emit( at + start, at + end, ( classes.digits & span ) == span );
+
+      consumed = end;
+    }
+  }
+}
+
+/**
+ * @brief parse_many parses each token of `text` as a T
+ *
+ * @see: `parse_many( std::string_view, expect_vector<T, parse_errc>& )`
+ */
+template <parsable T>
+  auto parse_many( std::string_view text )
+    -> expect_vector<T, parse_errc>
+{
+  auto out =
+    expect_vector<T, parse_errc>{};
+
+  parse_many<T>( text, out );
+
+  return out;
+}
+
+} // namespace mry
@@ -0,0 +1,181 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file mapped_file.h defines read-only, memory-mapped files -- parsed
+ *       in place, without copying them into buffers first
+ *
+ * @see: `mry::mapped_file`
+ * @see: `mry::parse_many<T>( std::string_view )`
+ */
+#include "mry/relocate.h"
+#include "mry/expect.h"
+#include "mry/error_t.h"
+
+#include <system_error>
+#include <string_view>
+#include <type_traits>
+#include <cstddef>
+#include <utility>
+#include <string>
+#include <cerrno>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace mry {
+
+/**
+ * @brief mapped_file maps a file into memory read-only for its lifetime
+ *
+ * ```cpp
+ * auto file =
+ *   mry::mapped_file::open( "samples.txt" );
+ *
+ * if (file)
+ *   auto samples =
+ *     mry::parse_many<double>( file.success().text() );
+ * ```
+ *
+ * @note: the mapping is advised to be read sequentially
+ */
+class mapped_file final
+{
+  public :
+    /**
+     * @brief open maps the file at `path` -- or returns the error
+     *        condition preventing it
+     */
+    static auto open( std::string const &path )
+      -> expect<mapped_file>
+    {
+      auto fd =
+        ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+
+      if (fd < 0)
+        return error_t{ "cannot open {} : {}", path, describe( errno ) };
+
+      using status_type =
+        struct stat;
+
+      auto status =
+        status_type{};
+
+      if (::fstat( fd, &status ) != 0)
+        return error_t{ "cannot stat {} : {}", path, describe( errno, fd ) };
+
+      /* @note: the size of FIFOs, devices and `/proc` files is reported
+       *        0 -- not telling their contents, those are rejected */
+      if (! S_ISREG( status.st_mode ))
+      {
+        ::close(fd);
+        return error_t{ "cannot map {} : not a regular file", path };
+      }
+
+      auto size =
+        static_cast<std::size_t>( status.st_size );
+
+      if (size == 0)
+      {
+        ::close(fd);
+        return mapped_file{ nullptr, 0 };
+      }
+
+      auto data =
+        ::mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+      if (data == MAP_FAILED)
+        return error_t{ "cannot map {} : {}", path, describe( errno, fd ) };
+
+      ::close(fd);
+      ::madvise( data, size, MADV_SEQUENTIAL );
+
+      return mapped_file{ data, size };
+    }
+
+    mapped_file( mapped_file &&o ) noexcept
+      : data_{ std::exchange( o.data_, nullptr ) }
+      , size_{ std::exchange( o.size_, 0 ) }
+    {}
+
+    auto operator=( mapped_file &&o ) noexcept
+      -> mapped_file&
+    {
+      std::swap( data_, o.data_ );
+      std::swap( size_, o.size_ );
+      return *this;
+    }
+
+    /**
+     * @brief unmaps the file
+     */
+    ~mapped_file() noexcept
+    {
+      if (data_)
+        ::munmap( data_, size_ );
+    }
+
+    /**
+     * @brief text returns the contents of the file
+     */
+    inline
+      auto text() const noexcept
+        -> std::string_view
+    { return { static_cast<char const*>( data_ ), size_ }; }
+
+    inline
+      auto size() const noexcept
+        -> std::size_t
+    { return size_; }
+
+  private :
+    mapped_file( void *data, std::size_t size ) noexcept
+      : data_{ data }
+      , size_{ size }
+    {}
+
+    /**
+     * @brief describe describes `error` -- closing `fd` given one
+     */
+    static auto describe( int error, int fd =-1 )
+      -> std::string
+    {
+      if (fd >= 0)
+        ::close(fd);
+
+      return std::generic_category().message( error );
+    }
+
+    void        *data_;
+    std::size_t  size_;
+};
+
+/**
+ * @brief mapped_file is trivially relocatable -- the mapping does not
+ *        refer back to it
+ */
+template <>
+  struct is_trivially_relocatable< mapped_file >
+    : std::true_type
+{};
+
+} // namespace mry
@@ -0,0 +1,372 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file simd.h defines the classification of text by blocks of chars --
+ *       by AVX2, SSE2 or portable SWAR instructions -- along with the
+ *       conversion of runs of digits the parsers of `mry::parse` rely on
+ *
+ * the instruction set is chosen at compile time : AVX2 given `__AVX2__`
+ * -- eg. by the `ParseISA` CMake option or `-march` --, SSE2 given
+ * `__SSE2__`, SWAR otherwise or given `MRY_PARSE_SCALAR` defined.
+ *
+ * @see: `mry::parse<T>( std::string_view )`
+ */
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <bit>
+
+#if ! defined(MRY_PARSE_SCALAR) && ( defined(__AVX2__) || defined(__SSE2__) )
+#  include <immintrin.h>
+#endif
+
+namespace mry::internal {
+
+/**
+ * @brief char_classes describes the classes of the chars of a block --
+ *        a bit per char, the first char denoted by the lowest bit
+ *
+ * separators are the chars up to and including `' '` -- whitespace
+ * and control characters -- and `','`.
+ */
+struct char_classes final
+{
+  std::uint64_t digits;
+  std::uint64_t separators;
+};
+
+/**
+ * @brief is_separator predicate tests whether `c` separates tokens
+ *
+ * @see: `char_classes`
+ */
+inline constexpr
+  auto is_separator( char c ) noexcept
+    -> bool
+{ return static_cast<unsigned char>(c) <= ' ' || c == ','; }
+
+/**
+ * @brief swar_block classifies blocks of 8 chars held by a 64-bit word
+ *        -- portable, yet little-endian only
+ */
+struct swar_block final
+{
+  static auto constexpr width =
+    std::size_t{8};
+
+  static auto classify( char const *at ) noexcept
+    -> char_classes
+  {
+    auto w =
+      load(at);
+
+    return { mask( ranged( w, '0', '9' ) )
+           , mask( ranged( w, 0, ' ' ) | equal( w, ',' ) ) };
+  }
+
+  static auto digits( char const *at ) noexcept
+    -> std::uint64_t
+  { return mask( ranged( load(at), '0', '9' ) ); }
+
+  private :
+    static auto constexpr ones =
+      std::uint64_t{ 0x0101010101010101 };
+    static auto constexpr highs =
+      std::uint64_t{ 0x8080808080808080 };
+
+    static auto load( char const *at ) noexcept
+      -> std::uint64_t
+    {
+      auto w =
+        std::uint64_t{};
+
+      std::memcpy( &w, at, sizeof(w) );
+
+      return w;
+    }
+
+    /**
+     * @brief ranged sets the highest bit of the bytes of `w` within
+     *        `[lo, hi]` -- subtracting from bytes having their highest
+     *        bit set never borrows across bytes
+     */
+    static auto ranged( std::uint64_t w, std::uint8_t lo, std::uint8_t hi ) noexcept
+      -> std::uint64_t
+    {
+      auto biased =
+        w | highs;
+
+      return ( biased - ones * lo ) & ~( biased - ones * ( hi + 1 ) ) & ~w & highs;
+    }
+
+    static auto equal( std::uint64_t w, char c ) noexcept
+      -> std::uint64_t
+    { return ranged( w, static_cast<std::uint8_t>(c), static_cast<std::uint8_t>(c) ); }
+
+    /**
+     * @brief mask gathers the highest bits of the bytes of `w` into the
+     *        lowest 8 bits -- the first byte into the lowest one
+     */
+    static auto mask( std::uint64_t w ) noexcept
+      -> std::uint64_t
+    { return ( ( w >> 7 ) * 0x0102040810204080 ) >> 56; }
+};
+
+#if ! defined(MRY_PARSE_SCALAR) && defined(__SSE2__)
+/**
+ * @brief sse2_block classifies blocks of 16 chars
+ */
+struct sse2_block final
+{
+  static auto constexpr width =
+    std::size_t{16};
+
+  static auto classify( char const *at ) noexcept
+    -> char_classes
+  {
+    auto v =
+      _mm_loadu_si128( reinterpret_cast<__m128i const*>(at) );
+    auto separators =
+      _mm_or_si128( _mm_cmpeq_epi8( _mm_min_epu8( v, _mm_set1_epi8(' ') ), v )
+                  , _mm_cmpeq_epi8( v, _mm_set1_epi8(',') ) );
+
+    return { digits(v), mask(separators) };
+  }
+
+  static auto digits( char const *at ) noexcept
+    -> std::uint64_t
+  { return digits( _mm_loadu_si128( reinterpret_cast<__m128i const*>(at) ) ); }
+
+  private :
+    static auto digits( __m128i v ) noexcept
+      -> std::uint64_t
+    {
+      auto d =
+        _mm_sub_epi8( v, _mm_set1_epi8('0') );
+
+      return mask( _mm_cmpeq_epi8( _mm_min_epu8( d, _mm_set1_epi8(9) ), d ) );
+    }
+
+    static auto mask( __m128i v ) noexcept
+      -> std::uint64_t
+    { return static_cast<std::uint16_t>( _mm_movemask_epi8(v) ); }
+};
+#endif
+
+#if ! defined(MRY_PARSE_SCALAR) && defined(__AVX2__)
+/**
+ * @brief avx2_block classifies blocks of 32 chars
+ */
+struct avx2_block final
+{
+  static auto constexpr width =
+    std::size_t{32};
+
+  static auto classify( char const *at ) noexcept
+    -> char_classes
+  {
+    auto v =
+      _mm256_loadu_si256( reinterpret_cast<__m256i const*>(at) );
+    auto separators =
+      _mm256_or_si256( _mm256_cmpeq_epi8( _mm256_min_epu8( v, _mm256_set1_epi8(' ') ), v )
+                     , _mm256_cmpeq_epi8( v, _mm256_set1_epi8(',') ) );
+
+    return { digits(v), mask(separators) };
+  }
+
+  static auto digits( char const *at ) noexcept
+    -> std::uint64_t
+  { return digits( _mm256_loadu_si256( reinterpret_cast<__m256i const*>(at) ) ); }
+
+  private :
+    static auto digits( __m256i v ) noexcept
+      -> std::uint64_t
+    {
+      auto d =
+        _mm256_sub_epi8( v, _mm256_set1_epi8('0') );
+
+      return mask( _mm256_cmpeq_epi8( _mm256_min_epu8( d, _mm256_set1_epi8(9) ), d ) );
+    }
+
+    static auto mask( __m256i v ) noexcept
+      -> std::uint64_t
+    { return static_cast<std::uint32_t>( _mm256_movemask_epi8(v) ); }
+};
+#endif
+
+/**
+ * @brief parse_block denotes the widest block the target supports
+ */
+#if ! defined(MRY_PARSE_SCALAR) && defined(__AVX2__)
+using parse_block =
+  avx2_block;
+#elif ! defined(MRY_PARSE_SCALAR) && defined(__SSE2__)
+using parse_block =
+  sse2_block;
+#else
+using parse_block =
+  swar_block;
+#endif
+
+static_assert( std::endian::native == std::endian::little
+             , "mry::parse requires a little-endian target" );
+
+/**
+ * @brief window_width denotes the number of chars classified at once
+ */
+inline auto constexpr window_width =
+  std::size_t{64};
+
+/**
+ * @brief classify_window classifies the `window_width` chars at `at`
+ *        by `Block`s
+ *
+ * @note: it is the responsibility of the caller to ensure
+ *        `window_width` chars are readable at `at`
+ */
+template <typename Block =parse_block>
+  auto classify_window( char const *at ) noexcept
+    -> char_classes
+{
+  auto classes =
+    char_classes{ 0, 0 };
+
+  for (auto i =std::size_t{0}; i < window_width; i += Block::width)
+  {
+    auto block =
+      Block::classify( at + i );
+
+    classes.digits     |= block.digits << i;
+    classes.separators |= block.separators << i;
+  }
+
+  return classes;
+}
+
+/**
+ * @brief digit_prefix returns the end of the run of digits at `first`
+ *        -- validated a `Block` at a time, the remainder char by char
+ */
+template <typename Block =parse_block>
+  auto digit_prefix( char const *first, char const *last ) noexcept
+    -> char const*
+{
+  auto constexpr full =
+    Block::width == 64 ? ~std::uint64_t{0}
+                       : ( std::uint64_t{1} << Block::width ) - 1;
+
+  for (; static_cast<std::size_t>( last - first ) >= Block::width; first += Block::width)
+    if (auto digits =Block::digits(first); digits != full)
+      return first + std::countr_one( digits );
+
+  while (first != last && static_cast<unsigned char>( *first - '0' ) < 10)
+    ++first;
+
+  return first;
+}
+
+/**
+ * @brief parse_eight converts the 8 digits held by `chunk` -- the first
+ *        one by its lowest byte -- by 3 multiplications
+ */
+inline
+  auto parse_eight( std::uint64_t chunk ) noexcept
+    -> std::uint64_t
+{
+  chunk -= 0x3030303030303030;
+  chunk  = ( chunk * 10 ) + ( chunk >> 8 );
+
+  return ( ( ( chunk & 0x000000FF000000FF ) * ( 100 + ( 1000000ull << 32 ) ) )
+         + ( ( ( chunk >> 16 ) & 0x000000FF000000FF ) * ( 1 + ( 10000ull << 32 ) ) ) ) >> 32;
+}
+
+/**
+ * @brief load_digits loads the `n` -- 1 to 8 -- digits at `at` into a
+ *        word as the last ones of 8, preceded by `'0'`s
+ *
+ * @note: a whole word is loaded whenever `readable` permits
+ */
+inline
+  auto load_digits( char const *at, std::size_t n, char const *readable ) noexcept
+    -> std::uint64_t
+{
+  auto chunk =
+    std::uint64_t{};
+
+  if (static_cast<std::size_t>( readable - at ) >= sizeof(chunk))
+    std::memcpy( &chunk, at, sizeof(chunk) );
+  else
+    std::memcpy( &chunk, at, n );
+
+  if (n == sizeof(chunk))
+    return chunk;
+
+  return ( chunk << ( 8 * ( 8 - n ) ) )
+       | ( std::uint64_t{ 0x3030303030303030 } >> ( 8 * n ) );
+}
+
+/**
+ * @brief parse_digits converts the digits in `[first, last)` -- at most
+ *        20 of them -- into `value`, returning false should it overflow
+ *
+ * @note: it is the responsibility of the caller to ensure
+ *        `[first, last)` are digits, `readable` bounding the chars
+ *        readable beyond `last`
+ */
+inline
+  auto parse_digits( char const *first
+                   , char const *last
+                   , char const *readable
+                   , std::uint64_t &value ) noexcept
+    -> bool
+{
+  auto n =
+    static_cast<std::size_t>( last - first );
+
+  value = 0;
+
+  if (auto head =n % 8)
+  {
+    value  = parse_eight( load_digits( first, head, readable ) );
+    first += head;
+  }
+
+  /* @note: 19 digits never overflow 64 bits, only 20 may */
+  auto const checked =
+    n > std::numeric_limits<std::uint64_t>::digits10;
+
+  for (; first != last; first += 8)
+  {
+    auto chunk =
+      parse_eight( load_digits( first, 8, readable ) );
+
+    if (checked && value > ( std::numeric_limits<std::uint64_t>::max() - chunk ) / 100000000)
+      return false;
+
+    value = value * 100000000 + chunk;
+  }
+
+  return true;
+}
+
+} // namespace mry::internal
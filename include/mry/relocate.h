@@ -0,0 +1,104 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file relocate.h defines facilities for relocating objects -- moving
+ *       them to a new location and destroying them at their former one
+ *       -- by copying their bytes should their types permit
+ *
+ * @see: `mry::is_trivially_relocatable<T>`
+ */
+#include <type_traits>
+#include <cstring>
+#include <cstddef>
+#include <memory>
+
+namespace mry {
+
+/**
+ * @brief is_trivially_relocatable is the {opt-in} customization point
+ *        declaring that relocating instances of T is equivalent to
+ *        copying their bytes -- trivially copyable types always are
+ *
+ * @note: types referring to themselves -- eg. strings implementing SSO
+ *        by a pointer into their own buffer -- are not trivially
+ *        relocatable
+ */
+template <typename T>
+  struct is_trivially_relocatable
+    : std::bool_constant< std::is_trivially_copyable_v<T> >
+{};
+
+/**
+ * @brief unique_ptr with the default deleter does not refer to itself
+ */
+template <typename T>
+  struct is_trivially_relocatable< std::unique_ptr<T> >
+    : std::true_type
+{};
+
+/**
+ * @brief is_trivially_relocatable_v convenience {inline} variable template
+ *        for the `is_trivially_relocatable<T>` trait
+ */
+template <typename T>
+  inline auto constexpr is_trivially_relocatable_v =
+    is_trivially_relocatable<T>::value;
+
+/**
+ * @brief uninitialized_relocate relocates the objects in `[first, last)`
+ *        to the uninitialized storage beginning at `destination`
+ *        returning the end of the relocated objects
+ *
+ * @note: the objects in `[first, last)` are no longer alive after
+ *        the call, it is the responsibility of the caller to ensure
+ *        their storage is not destroyed again
+ */
+template <typename T>
+  auto uninitialized_relocate( T *first, T *last, T *destination )
+    noexcept( is_trivially_relocatable_v<T>
+           || std::is_nothrow_move_constructible_v<T> )
+      -> T*
+{
+  if constexpr (is_trivially_relocatable_v<T>)
+  {
+    auto const size =
+      static_cast<std::size_t>( last - first );
+
+    if (size != 0)
+      std::memcpy( static_cast<void*>(destination)
+                 , static_cast<void const*>(first)
+                 , size * sizeof(T) );
+
+    return destination + size;
+  }
+
+  else
+  {
+    auto end =
+      std::uninitialized_move( first, last, destination );
+
+    std::destroy( first, last );
+
+    return end;
+  }
+}
+
+} // namespace mry
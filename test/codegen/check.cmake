@@ -0,0 +1,117 @@
+# Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# inspects the assembly generated from `SOURCE` by `CXX` at -O2
+#
+#   -DCXX=<compiler>
+#   -DSOURCE=<probes.cc>
+#   -DINCLUDE=<include directory>
+#   -DREGISTER_PROBES=<probe>[,<probe>...] : probes expected to return
+#                                            their results in registers
+#   -DMEMORY_PROBES=<probe>[,<probe>...]   : probes expected to return
+#                                            their results through memory
+#   -DSSE_PROBES=<probe>[,<probe>...]      : probes expected to return
+#                                            their floating point results
+#                                            in `%xmm0`
+#   -DLEAF_PROBES=<probe>[,<probe>...]     : probes expected not to call
+#                                            `operator new` -- nor anything
+#                                            else -- nor to spill on the stack
+#
+cmake_minimum_required( VERSION 3.22 )
+
+execute_process(
+  COMMAND         "${CXX}" -std=c++20 -O2 -S -o - "-I${INCLUDE}" "${SOURCE}"
+  OUTPUT_VARIABLE assembly
+  ERROR_VARIABLE  diagnostics
+  RESULT_VARIABLE result )
+
+if( NOT result EQUAL 0 )
+  message( FATAL_ERROR "-- compiling ${SOURCE} failed :\n${diagnostics}" )
+endif()
+
+#
+# probe_body( <probe> <variable> ) extracts the body of the function
+# named (mangled) `probe` from `assembly` into `variable`
+#
+function( probe_body probe variable )
+  string( REGEX MATCH "\n_Z[0-9]+${probe}v:.*" body "${assembly}" )
+
+  if( NOT body )
+    message( FATAL_ERROR "-- probe ${probe} not found" )
+  endif()
+
+  string( FIND "${body}" ".cfi_endproc" end )
+  string( SUBSTRING "${body}" 0 ${end} body )
+
+  set( ${variable} "${body}" PARENT_SCOPE )
+endfunction()
+
+string( REPLACE "," ";" register_probes "${REGISTER_PROBES}" )
+string( REPLACE "," ";" memory_probes "${MEMORY_PROBES}" )
+string( REPLACE "," ";" sse_probes "${SSE_PROBES}" )
+string( REPLACE "," ";" leaf_probes "${LEAF_PROBES}" )
+
+foreach( probe IN LISTS register_probes )
+  probe_body( ${probe} body )
+
+  if( body MATCHES "%rdi" )
+    message( FATAL_ERROR "-- ${probe} returns its result through memory :${body}" )
+  endif()
+
+  message( "-- ${probe} returns its result in registers" )
+endforeach()
+
+foreach( probe IN LISTS memory_probes )
+  probe_body( ${probe} body )
+
+  if( NOT body MATCHES "%rdi" )
+    message( FATAL_ERROR "-- ${probe} returns its result in registers :${body}" )
+  endif()
+
+  message( "-- ${probe} returns its result through memory" )
+endforeach()
+
+foreach( probe IN LISTS sse_probes )
+  probe_body( ${probe} body )
+
+  if( NOT body MATCHES "%xmm0" OR body MATCHES "movq[\t ]+%xmm[0-9]+, %r" )
+    message( FATAL_ERROR "-- ${probe} returns its result in general purpose registers :${body}" )
+  endif()
+
+  message( "-- ${probe} returns its result in %xmm0" )
+endforeach()
+
+foreach( probe IN LISTS leaf_probes )
+  probe_body( ${probe} body )
+
+  if( body MATCHES "_Znw|_Zna|malloc" )
+    message( FATAL_ERROR "-- ${probe} allocates :${body}" )
+  endif()
+
+  if( body MATCHES "[\t ](call|jmp)[a-z]*[\t ]+[_a-zA-Z*]" )
+    message( FATAL_ERROR "-- ${probe} calls out :${body}" )
+  endif()
+
+  if( body MATCHES "%rsp\\)|, %rsp|[\t ]push" )
+    message( FATAL_ERROR "-- ${probe} spills on the stack :${body}" )
+  endif()
+
+  message( "-- ${probe} neither allocates nor spills" )
+endforeach()
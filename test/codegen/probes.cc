@@ -0,0 +1,236 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+/**
+ * @file probes.cc defines probe functions whose generated code is
+ *       inspected by `check.cmake`
+ *
+ * @note: probes take no arguments -- reading their inputs from volatile
+ *        globals instead -- hence any reference to `%rdi` in their bodies
+ *        denotes a hidden pointer to a result returned through memory
+ *
+ * @note: the layout of the storage and of `mry::expect<T>` is asserted
+ *        at compile time below -- any compiler building the probes
+ *        checks those
+ */
+#include "mry/expect.h"
+
+#include <string_view>
+#include <cstdint>
+#include <vector>
+#include <array>
+
+namespace probe {
+
+enum class errc
+{
+  invalid
+};
+
+struct position
+{
+  int line;
+  int column;
+};
+
+} // namespace probe
+
+template <>
+  struct mry::error_category< probe::errc >
+{
+  static auto constexpr name =
+    std::string_view{ "probe" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "invalid" });
+};
+
+namespace probe {
+
+using mry::internal::variant_storage;
+
+/*
+ * the layout of the storage -- its size and alignment being those of its
+ * largest and most aligned alternative, not a byte beyond
+ */
+static_assert( sizeof(variant_storage<int, errc>) == sizeof(int) );
+static_assert( alignof(variant_storage<int, errc>) == alignof(int) );
+static_assert( sizeof(variant_storage<int, mry::error_t>) == sizeof(mry::error_t) );
+static_assert( alignof(variant_storage<int, mry::error_t>) == alignof(mry::error_t) );
+static_assert( sizeof(variant_storage<void*, mry::error_t>) == sizeof(void*) );
+static_assert( sizeof(variant_storage<std::vector<int>, mry::error_t>) == sizeof(std::vector<int>) );
+static_assert( alignof(variant_storage<std::vector<int>, mry::error_t>) == alignof(std::vector<int>) );
+
+/*
+ * the layout of the storage of a floating point alternative -- side by side
+ * its error condition, lest it be classified INTEGER by the Itanium ABI
+ */
+static_assert( mry::internal::disjoint_alternatives<double, errc> );
+static_assert( ! mry::internal::disjoint_alternatives<float, errc> );
+static_assert( ! mry::internal::disjoint_alternatives<int, errc> );
+static_assert( sizeof(variant_storage<double, errc>) == 2 * sizeof(double) );
+
+/*
+ * the triviality of the storage -- trivial whenever its alternatives are,
+ * a union holding non-trivial ones otherwise
+ */
+static_assert( std::is_trivially_default_constructible_v< variant_storage<int, errc> > );
+static_assert( std::is_trivially_copyable_v< variant_storage<int, errc> > );
+static_assert( std::is_trivially_copyable_v< variant_storage<void*, errc> > );
+static_assert( std::is_nothrow_default_constructible_v< variant_storage<std::vector<int>, mry::error_t> > );
+static_assert( std::is_nothrow_destructible_v< variant_storage<std::vector<int>, mry::error_t> > );
+
+/*
+ * the layout of expect<T> -- its discriminant fitting the padding of a
+ * word, or no discriminant at all given a niche
+ */
+static_assert( sizeof(mry::error_t) == sizeof(std::uintptr_t) );
+static_assert( sizeof(mry::expect<int, errc>) == 2 * sizeof(int) );
+static_assert( sizeof(mry::expect<double, errc>) == 2 * sizeof(double) );
+static_assert( sizeof(mry::expect<int>) == 2 * sizeof(std::uintptr_t) );
+static_assert( sizeof(mry::expect<void*>) == 2 * sizeof(std::uintptr_t) );
+static_assert( sizeof(mry::expect<int*>) == sizeof(int*) );
+static_assert( sizeof(mry::expect<std::vector<int>>) == sizeof(std::vector<int>) + sizeof(std::uintptr_t) );
+static_assert( sizeof(mry::expect<void>) == sizeof(mry::error_t) );
+static_assert( sizeof(mry::expect<int&>) == sizeof(int*) );
+static_assert( sizeof(mry::expect<void, errc>) == 2 * sizeof(errc) );
+static_assert( sizeof(mry::expect<int, errc, position>) == sizeof(position) + sizeof(int) );
+
+/*
+ * the triviality of expect<T> -- passed in registers by the Itanium ABI
+ * only when trivially copyable and destructible
+ */
+static_assert( std::is_trivially_copyable_v< mry::expect<int, errc> > );
+static_assert( std::is_trivially_copyable_v< mry::expect<void*, errc> > );
+static_assert( std::is_trivially_copyable_v< mry::expect<void, errc> > );
+static_assert( std::is_trivially_copyable_v< mry::expect<int&, errc> > );
+static_assert( std::is_trivially_copyable_v< mry::expect<int, errc, position> > );
+static_assert( std::is_trivially_copyable_v< mry::expect<double, errc> > );
+static_assert( ! std::is_trivially_copyable_v< mry::expect<int> > );
+static_assert( ! std::is_trivially_copyable_v< mry::expect<std::vector<int>> > );
+
+} // namespace probe
+
+int    volatile probe_int_input    =0;
+int             probe_int_referent =0;
+double volatile probe_double_input =0.;
+void * volatile probe_pointer_input =nullptr;
+
+std::vector<int> probe_vector_input;
+
+auto probe_expect_int() noexcept
+  -> mry::expect<int, probe::errc>
+{
+  int input =
+    probe_int_input;
+
+  if (input < 0)
+    return probe::errc::invalid;
+
+  return input;
+}
+
+auto probe_expect_double() noexcept
+  -> mry::expect<double, probe::errc>
+{
+  double input =
+    probe_double_input;
+
+  if (input < 0.)
+    return probe::errc::invalid;
+
+  return input;
+}
+
+auto probe_expect_pointer() noexcept
+  -> mry::expect<void*, probe::errc>
+{
+  void *input =
+    probe_pointer_input;
+
+  if (!input)
+    return probe::errc::invalid;
+
+  return input;
+}
+
+auto probe_expect_error_int() noexcept
+  -> mry::expect<int>
+{
+  int input =
+    probe_int_input;
+
+  if (input < 0)
+    return mry::error_t{ probe::errc::invalid };
+
+  return input;
+}
+
+auto probe_expect_error_pointer() noexcept
+  -> mry::expect<void*>
+{
+  void *input =
+    probe_pointer_input;
+
+  if (!input)
+    return mry::error_t{ "no input" };
+
+  return input;
+}
+
+auto probe_expect_vector() noexcept
+  -> mry::expect<std::vector<int>>
+{
+  if (probe_vector_input.empty())
+    return mry::error_t{ probe::errc::invalid };
+
+  return std::move(probe_vector_input);
+}
+
+auto probe_expect_void() noexcept
+  -> mry::expect<void, probe::errc>
+{
+  if (probe_int_input < 0)
+    return probe::errc::invalid;
+
+  return {};
+}
+
+auto probe_expect_reference() noexcept
+  -> mry::expect<int&, probe::errc>
+{
+  if (probe_int_input < 0)
+    return probe::errc::invalid;
+
+  return probe_int_referent;
+}
+
+auto probe_expect_errors() noexcept
+  -> mry::expect<int, probe::errc, probe::position>
+{
+  int input =
+    probe_int_input;
+
+  if (input < 0)
+    return probe::errc::invalid;
+
+  if (input == 0)
+    return probe::position{ 1, input };
+
+  return input;
+}
@@ -0,0 +1,263 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect.h"
+#include "mry/error_t.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string_view>
+#include <cstdint>
+#include <array>
+
+namespace {
+
+enum class config_errc
+{
+  non_digit,
+  overflow,
+  unknown_key
+};
+
+} // namespace
+
+template <>
+  struct mry::error_category< config_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "config" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "non digit", "overflow", "unknown key" });
+};
+
+namespace {
+
+/**
+ * @brief parse_u16 parses `s` as a 16 bit unsigned integer -- at compile
+ *        time given a constant `s`
+ */
+constexpr
+  auto parse_u16( std::string_view s )
+    -> mry::expect< std::uint16_t, config_errc >
+{
+  auto parsed =
+    std::uint32_t{0};
+
+  for (auto c : s)
+  {
+    if (c < '0' || c > '9')
+      return config_errc::non_digit;
+
+    parsed =
+      parsed * 10 + static_cast<std::uint32_t>( c - '0' );
+
+    if (parsed > 0xffff)
+      return config_errc::overflow;
+  }
+
+  return static_cast<std::uint16_t>( parsed );
+}
+
+/**
+ * @brief parse_port parses `s` as a port describing error conditions
+ *        by `mry::error_t`
+ */
+constexpr
+  auto parse_port( std::string_view s )
+    -> mry::expect< std::uint16_t >
+{
+  if (s.empty())
+    return mry::error_t{"empty port"};
+
+  return parse_u16(s)
+    .transform_error( []( config_errc e ) { return mry::error_t{e}; } );
+}
+
+/**
+ * @brief lookup resolves the port of the service `key` of a table
+ *        parsed at compile time
+ */
+constexpr
+  auto lookup( std::string_view key )
+    -> mry::expect< std::uint16_t >
+{
+  auto constexpr services =
+    std::to_array<std::pair<std::string_view, std::string_view>>({
+      { "http", "80" }, { "https", "443" }, { "dns", "53" } });
+
+  for (auto const &[name, port] : services)
+    if (name == key)
+      return parse_port( port );
+
+  return mry::error_t{ config_errc::unknown_key };
+}
+
+auto constexpr service_names =
+  std::to_array<std::string_view>({ "http", "https" });
+
+/**
+ * @brief find_service returns the name of the service `port` refers to
+ *        -- by pointer, hence encoding the error state in its niche
+ */
+constexpr
+  auto find_service( std::uint16_t port )
+    -> mry::expect< std::string_view const* >
+{
+  if (port == 80 || port == 443)
+    return &service_names[ port == 443 ];
+
+  return mry::error_t{ config_errc::unknown_key };
+}
+
+#if MRY_META_WITHIN_LIFETIME
+
+/* @note: evaluated at compile time -- once parsed, only the port is kept */
+auto constexpr https_port =
+  lookup("https").success();
+
+#endif
+
+/* @note: constant initialized, yet read at runtime */
+constinit auto constant_empty =
+  mry::error_t{};
+
+TEST_CASE( "expect<T> constant evaluation", "[expect<T>][constexpr]" )
+{
+  SECTION( "error codes" )
+  {
+    STATIC_REQUIRE( 8080 == parse_u16("8080").success() );
+    STATIC_REQUIRE( config_errc::non_digit == parse_u16("80a").fail() );
+    STATIC_REQUIRE( config_errc::overflow == parse_u16("65536").fail() );
+    STATIC_REQUIRE( 7 == parse_u16("x").value_or( 7 ) );
+  }
+
+  SECTION( "alternatives told apart by a flag" )
+  {
+    STATIC_REQUIRE( 80 == []{
+                            auto result =
+                              parse_u16("x");
+                            auto copy =
+                              result;
+
+                            result = parse_u16("80");
+                            copy = std::move(result);
+                            result = parse_u16("65536");
+
+                            return result.holds_error() ? copy.success() : 0;
+                          }() );
+    STATIC_REQUIRE( 1.5 == mry::expect<double, config_errc>{ 1.5 }.success() );
+    STATIC_REQUIRE( config_errc::overflow == mry::expect<double, config_errc>{ config_errc::overflow }.fail() );
+  }
+
+  SECTION( "several error conditions" )
+  {
+    using expect_t =
+      mry::expect< std::uint64_t, config_errc, char >;
+
+    STATIC_REQUIRE( 'c' == expect_t{ 'c' }.fail().get<char>() );
+    STATIC_REQUIRE( 1 == expect_t{ std::uint64_t{1} }.success() );
+    STATIC_REQUIRE( ! expect_t{ std::uint64_t{1} }.holds_error() );
+    STATIC_REQUIRE( expect_t{ config_errc::overflow }.holds_error() );
+  }
+
+  SECTION( "the empty state constant initialized" )
+  {
+    REQUIRE( ! constant_empty.holds_error() );
+    REQUIRE( mry::expect<int*>{ mry::error_t{ constant_empty } }.holds_error() );
+  }
+
+#if MRY_META_WITHIN_LIFETIME
+
+  SECTION( "error_t" )
+  {
+    STATIC_REQUIRE( 443 == https_port );
+    STATIC_REQUIRE( "empty port" == parse_port("").fail().get() );
+    STATIC_REQUIRE( parse_port("99999").fail().is( config_errc::overflow ) );
+    STATIC_REQUIRE( "overflow" == parse_port("99999").fail().get() );
+    STATIC_REQUIRE( lookup("ftp").fail().is( config_errc::unknown_key ) );
+    STATIC_REQUIRE( ! mry::error_t{}.holds_error() );
+    STATIC_REQUIRE( ! []{
+                        auto empty =
+                          mry::error_t{};
+                        auto moved =
+                          mry::error_t{ std::move(empty) };
+
+                        moved = mry::error_t{"e"};
+                        moved = std::move(empty);
+
+                        return moved.holds_error() || empty.holds_error();
+                      }() );
+  }
+
+  SECTION( "niche" )
+  {
+    STATIC_REQUIRE( "https" == *find_service(443).success() );
+    STATIC_REQUIRE( ! find_service(80).holds_error() );
+    STATIC_REQUIRE( find_service(21).fail().is( config_errc::unknown_key ) );
+    STATIC_REQUIRE( nullptr == find_service(21).value_or( nullptr ) );
+    STATIC_REQUIRE( "http" == *[]{
+                                 auto result =
+                                   find_service(21);
+                                 auto copy =
+                                   result;
+
+                                 result = find_service(80);
+                                 copy = std::move(result);
+
+                                 return copy.success();
+                               }() );
+  }
+
+  SECTION( "combinators" )
+  {
+    STATIC_REQUIRE( 160 == lookup("http").transform( []( std::uint16_t p ) { return p * 2; } ).success() );
+    STATIC_REQUIRE( 53 == lookup("ftp").or_else( []( mry::error_t const & ) { return lookup("dns"); } ).success() );
+    STATIC_REQUIRE( lookup("dns").and_then( []( std::uint16_t ) { return parse_port("x"); } ).fail().is( config_errc::non_digit ) );
+  }
+
+  SECTION( "value semantics" )
+  {
+    auto constexpr reassigned =
+      []{
+        auto result =
+          lookup("ftp");
+        auto copy =
+          result;
+
+        result = lookup("http");
+        copy = std::move(result);
+
+        return copy.success();
+      }();
+
+    STATIC_REQUIRE( 80 == reassigned );
+  }
+
+  SECTION( "the same at runtime" )
+  {
+    auto key =
+      std::string_view{ "https" };
+
+    REQUIRE( https_port == lookup( key ).success() );
+    REQUIRE( parse_port("").fail().get() == "empty port" );
+  }
+
+#endif
+}
+
+} // namespace
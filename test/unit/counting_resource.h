@@ -0,0 +1,59 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+/**
+ * @file counting_resource.h defines the memory resource the unit tests
+ *       count the allocations of `mry::expect<T>` facilities by
+ */
+#include <memory_resource>
+#include <cstddef>
+
+namespace test {
+
+/**
+ * @brief counting_resource counts the allocations and deallocations it
+ *        forwards to `std::pmr::new_delete_resource()`
+ */
+struct counting_resource final
+  : std::pmr::memory_resource
+{
+  std::size_t allocated =0;
+  std::size_t deallocated =0;
+
+  auto do_allocate( std::size_t size, std::size_t alignment )
+    -> void* override
+  {
+    ++allocated;
+    return std::pmr::new_delete_resource()->allocate( size, alignment );
+  }
+
+  auto do_deallocate( void *p, std::size_t size, std::size_t alignment )
+    -> void override
+  {
+    ++deallocated;
+    std::pmr::new_delete_resource()->deallocate( p, size, alignment );
+  }
+
+  auto do_is_equal( std::pmr::memory_resource const &o ) const noexcept
+    -> bool override
+  { return this == &o; }
+};
+
+} // namespace test
@@ -0,0 +1,217 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/error_t/counters.h"
+#include "mry/expect.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <source_location>
+#include <string_view>
+#include <algorithm>
+#include <utility>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+enum class errc
+{
+  invalid
+};
+
+} // namespace
+
+template <>
+  struct mry::error_category< errc >
+{
+  static auto constexpr name =
+    std::string_view{ "errc" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "invalid" });
+};
+
+namespace {
+
+/**
+ * @brief hits returns the hits recorded against the line of `where`
+ *        so far
+ */
+auto hits( std::source_location const &where )
+  -> std::uint64_t
+{
+  auto hits =
+    std::uint64_t{0};
+
+  for (auto &count : mry::error_counts())
+    if (std::strcmp( count.where.file_name(), where.file_name() ) == 0
+     && count.where.line() == where.line())
+      hits += count.hits;
+
+  return hits;
+}
+
+#if defined(MRY_ERROR_COUNTERS)
+/**
+ * @brief total returns the hits recorded so far
+ */
+auto total()
+  -> std::uint64_t
+{
+  auto hits =
+    std::uint64_t{0};
+
+  for (auto &count : mry::error_counts())
+    hits += count.hits;
+
+  return hits;
+}
+#endif
+
+TEST_CASE( "error counters", "[error_t][counters]" )
+{
+  SECTION( "site table" )
+  {
+    auto table =
+      std::make_unique<mry::internal::site_table>();
+    auto first =
+      std::source_location::current();
+    auto second =
+      std::source_location::current();
+
+    for (auto i =0; i < 3; ++i)
+      table->record( first );
+
+    table->record( second );
+
+    auto counts =
+      std::vector<std::pair<std::source_location, std::uint64_t>>{};
+
+    table->merge_into( counts );
+
+    REQUIRE( 2 == counts.size() );
+    REQUIRE( 4 == counts[0].second + counts[1].second );
+    REQUIRE( 3 == std::ranges::max( counts, {}, &decltype(counts)::value_type::second ).second );
+  }
+
+  SECTION( "merged over threads" )
+  {
+    auto where =
+      std::source_location::current();
+    auto before =
+      hits( where );
+
+    auto record =
+      [&]
+      {
+        for (auto i =0; i < 1000; ++i)
+          mry::internal::this_thread_sites().record( where );
+      };
+
+    {
+      auto threads =
+        std::vector<std::jthread>{};
+
+      for (auto i =0; i < 4; ++i)
+        threads.emplace_back( record );
+    }
+
+    record();
+
+    REQUIRE( before + 5000 == hits( where ) );
+  }
+
+  SECTION( "retired tables are reused" )
+  {
+    auto tables =
+      [&]
+      {
+        auto n =
+          std::size_t{0};
+
+        for (auto t =mry::internal::site_tables.load(); t; t = t->next)
+          ++n;
+
+        return n;
+      };
+
+    std::jthread{ []{ mry::internal::this_thread_sites(); } }.join();
+
+    auto n =
+      tables();
+
+    for (auto i =0; i < 8; ++i)
+      std::jthread{ []{ mry::internal::this_thread_sites(); } }.join();
+
+    REQUIRE( n == tables() );
+  }
+
+  SECTION( "most hit first" )
+  {
+    auto counts =
+      mry::error_counts();
+
+    REQUIRE( std::ranges::is_sorted( counts, std::greater{}, &mry::error_count::hits ) );
+  }
+
+#if defined(MRY_ERROR_COUNTERS)
+  SECTION( "error_t records its call site" )
+  {
+    using located =
+      std::pair< mry::error_t, std::source_location >;
+
+    auto literal =
+      []() -> located { return { mry::error_t{ "literal" }, std::source_location::current() }; };
+    auto code =
+      []() -> located { return { mry::error_t{ errc::invalid }, std::source_location::current() }; };
+    auto formatted =
+      []() -> located { return { mry::error_t{ "at {}", 1 }, std::source_location::current() }; };
+
+    for (auto make : { +literal, +code, +formatted })
+    {
+      auto where =
+        make().second;
+      auto before =
+        hits( where );
+
+      make();
+
+      REQUIRE( before + 1 == hits( where ) );
+    }
+  }
+
+  SECTION( "expect<T, E> records its call site, not its propagation" )
+  {
+    auto fail =
+      []( int ) -> mry::expect<int, errc> { return errc::invalid; };
+
+    auto before =
+      total();
+    auto propagated =
+      fail( 0 ).and_then( fail ).transform( []( int i ){ return i; } );
+
+    REQUIRE( propagated.holds_error() );
+    REQUIRE( before + 1 == total() );
+  }
+#endif
+}
+
+} // namespace
@@ -0,0 +1,351 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/error_list.h"
+#include "mry/expect.h"
+#include "mry/error_t.h"
+
+#include "counting_resource.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory_resource>
+#include <stdexcept>
+#include <string_view>
+#include <cstdint>
+#include <utility>
+#include <string>
+#include <vector>
+#include <array>
+
+namespace {
+
+enum class field_errc
+{
+  empty,
+  out_of_range
+};
+
+} // namespace
+
+template <>
+  struct mry::error_category< field_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "field" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "empty", "out of range" });
+};
+
+namespace {
+
+struct user
+{
+  std::string   name;
+  std::string   email;
+  std::uint32_t age;
+};
+
+auto validate( user const &u )
+  -> mry::expect< user const*, mry::error_list<mry::error_t, 2> >
+{
+  auto errors =
+    mry::error_list<mry::error_t, 2>{};
+
+  if (u.name.empty())
+    errors.push_back( mry::error_t{ field_errc::empty } );
+  if (u.email.find('@') == std::string::npos)
+    errors.push_back( mry::error_t{ "email {} lacks @", u.email } );
+  if (u.age > 150)
+    errors.push_back( mry::error_t{ field_errc::out_of_range } );
+
+  return std::move(errors).into( &u );
+}
+
+using test::counting_resource;
+
+/**
+ * @brief throwing_copy describes an error condition whose copy throws
+ *        once `copies` copies are made
+ */
+struct throwing_copy
+{
+  static inline int copies =0;
+
+  throwing_copy() noexcept
+    =default;
+
+  throwing_copy( throwing_copy const & )
+  {
+    if (--copies < 0)
+      throw std::runtime_error{ "uncopyable" };
+  }
+
+  throwing_copy( throwing_copy && ) noexcept
+    =default;
+};
+
+TEST_CASE( "error_list<E, N> semantics", "[error_list]" )
+{
+  SECTION( "inline" )
+  {
+    auto errors =
+      mry::error_list<field_errc, 4>{};
+
+    REQUIRE( errors.empty() );
+    REQUIRE( ! errors );
+    REQUIRE( 4 == errors.capacity() );
+
+    errors.push_back( field_errc::empty );
+    errors.emplace_back( field_errc::out_of_range );
+
+    REQUIRE( errors );
+    REQUIRE( 2 == errors.size() );
+    REQUIRE( ! errors.spilled() );
+    REQUIRE( field_errc::empty == errors[0] );
+    REQUIRE( field_errc::out_of_range == errors.errors().back() );
+
+    errors.clear();
+
+    REQUIRE( errors.empty() );
+  }
+
+  SECTION( "spilled to a memory resource" )
+  {
+    auto resource =
+      counting_resource{};
+    auto errors =
+      mry::error_list<mry::error_t, 2>{ &resource };
+
+    for (auto i =0; i < 2; ++i)
+      errors.push_back( mry::error_t{ "inline" } );
+
+    REQUIRE( 0 == resource.allocated );
+
+    for (auto i =0; i < 3; ++i)
+      errors.push_back( mry::error_t{ "spilled" } );
+
+    REQUIRE( errors.spilled() );
+    REQUIRE( 5 == errors.size() );
+    REQUIRE( 8 == errors.capacity() );
+    REQUIRE( 2 == resource.allocated );
+    REQUIRE( "inline" == errors[1].get() );
+    REQUIRE( "spilled" == errors[4].get() );
+  }
+
+  SECTION( "spilled copy throwing" )
+  {
+    auto resource =
+      counting_resource{};
+    auto errors =
+      mry::error_list<throwing_copy, 2>{ &resource };
+
+    for (auto i =0; i < 4; ++i)
+      errors.emplace_back();
+
+    throwing_copy::copies = 2;
+
+    REQUIRE_THROWS( mry::error_list<throwing_copy, 2>{ errors } );
+    REQUIRE( 2 == resource.allocated );
+    REQUIRE( 1 == resource.deallocated );
+  }
+
+  SECTION( "spilled to the error resource" )
+  {
+    auto resource =
+      counting_resource{};
+    auto former =
+      mry::set_error_resource( &resource );
+    auto errors =
+      mry::error_list<mry::error_t, 1>{};
+
+    errors.push_back( mry::error_t{ "a" } );
+    errors.push_back( mry::error_t{ std::string{ "b" } } );
+
+    mry::set_error_resource( former );
+
+    /* @note: the spilled storage and the dynamic description of "b" */
+    REQUIRE( 2 == resource.allocated );
+    REQUIRE( errors.spilled() );
+    REQUIRE( "b" == errors[1].get() );
+  }
+
+  SECTION( "spilled to an error arena" )
+  {
+    auto arena =
+      mry::error_arena{};
+    auto errors =
+      mry::error_list<mry::error_t, 1>{};
+
+    for (auto i =0; i < 16; ++i)
+      errors.push_back( mry::error_t{ "e" } );
+
+    REQUIRE( 16 == errors.size() );
+    REQUIRE( &arena.resource() == mry::error_resource() );
+  }
+
+  SECTION( "value semantics" )
+  {
+    auto errors =
+      mry::error_list<mry::error_t, 2>{};
+
+    errors.push_back( mry::error_t{ "a" } );
+
+    auto copied =
+      errors;
+    auto moved =
+      std::move(errors);
+
+    REQUIRE( errors.empty() );
+    REQUIRE( "a" == copied[0].get() );
+    REQUIRE( "a" == moved[0].get() );
+
+    for (auto i =0; i < 3; ++i)
+      moved.push_back( mry::error_t{ std::string{ "b" } } );
+
+    auto spilled =
+      moved;
+    auto stolen =
+      std::move(moved);
+
+    REQUIRE( spilled.spilled() );
+    REQUIRE( stolen.spilled() );
+    REQUIRE( ! moved.spilled() );
+    REQUIRE( 4 == spilled.size() );
+    REQUIRE( "b" == stolen[3].get() );
+
+    copied = stolen;
+    stolen = std::move(copied);
+
+    REQUIRE( 4 == stolen.size() );
+    REQUIRE( copied.empty() );
+  }
+
+  SECTION( "assignment keeps the resource" )
+  {
+    auto given =
+      counting_resource{};
+    auto other =
+      counting_resource{};
+    auto errors =
+      mry::error_list<mry::error_t, 2>{ &given };
+    auto spilled =
+      mry::error_list<mry::error_t, 2>{ &other };
+
+    for (auto i =0; i < 3; ++i)
+      spilled.push_back( mry::error_t{ "e" } );
+
+    errors = std::move(spilled);
+
+    REQUIRE( 1 == given.allocated );
+    REQUIRE( errors.spilled() );
+    REQUIRE( 3 == errors.size() );
+    REQUIRE( spilled.empty() );
+
+    errors = mry::error_list<mry::error_t, 2>{ &other };
+    errors.push_back( mry::error_t{ "e" } );
+
+    REQUIRE( 1 == given.deallocated );
+    REQUIRE( ! errors.spilled() );
+
+    for (auto i =0; i < 2; ++i)
+      errors.push_back( mry::error_t{ "e" } );
+
+    REQUIRE( 2 == given.allocated );
+    REQUIRE( 1 == other.allocated );
+
+    auto taken =
+      mry::error_list<mry::error_t, 2>{ &given };
+
+    taken = std::move(errors);
+
+    REQUIRE( 2 == given.allocated );
+    REQUIRE( 3 == taken.size() );
+  }
+
+  SECTION( "spilled to the error resource of the thread growing" )
+  {
+    auto first =
+      counting_resource{};
+    auto then =
+      counting_resource{};
+    auto errors =
+      mry::error_list<mry::error_t, 1>{};
+
+    auto former =
+      mry::set_error_resource( &first );
+
+    for (auto i =0; i < 2; ++i)
+      errors.push_back( mry::error_t{ "e" } );
+
+    mry::set_error_resource( &then );
+
+    for (auto i =0; i < 2; ++i)
+      errors.push_back( mry::error_t{ "e" } );
+
+    mry::set_error_resource( former );
+
+    REQUIRE( 1 == first.allocated );
+    REQUIRE( 1 == first.deallocated );
+    REQUIRE( 1 == then.allocated );
+    REQUIRE( 4 == errors.size() );
+  }
+
+  SECTION( "relocation" )
+  {
+    STATIC_REQUIRE( mry::is_trivially_relocatable_v< mry::error_list<> > );
+    STATIC_REQUIRE( mry::is_trivially_relocatable_v< mry::error_list<field_errc> > );
+    STATIC_REQUIRE( ! mry::is_trivially_relocatable_v< mry::error_list<std::string> > );
+
+    auto lists =
+      std::vector< mry::error_list<mry::error_t, 2> >{};
+
+    for (auto i =0; i < 64; ++i)
+      lists.emplace_back().push_back( mry::error_t{ std::string( i % 8 + 1, 'e' ) } );
+
+    for (auto i =0; i < 64; ++i)
+      REQUIRE( std::size_t( i % 8 + 1 ) == lists[i][0].get().size() );
+  }
+
+  SECTION( "expect<T, error_list<E, N>>" )
+  {
+    auto valid =
+      user{ "ada", "ada@example.com", 36 };
+    auto invalid =
+      user{ "", "ada", 200 };
+
+    auto accepted =
+      validate( valid );
+    auto rejected =
+      validate( invalid );
+
+    REQUIRE( &valid == accepted.success() );
+    REQUIRE( rejected.holds_error() );
+    REQUIRE( 3 == rejected.fail().size() );
+    REQUIRE( rejected.fail()[0].is( field_errc::empty ) );
+    REQUIRE( "email ada lacks @" == rejected.fail()[1].get() );
+    REQUIRE( rejected.fail()[2].is( field_errc::out_of_range ) );
+
+    auto named =
+      validate( valid ).transform( []( user const *u ) { return u->name; } );
+
+    REQUIRE( "ada" == named.success() );
+  }
+}
+
+} // namespace
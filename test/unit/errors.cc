@@ -0,0 +1,200 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string_view>
+#include <type_traits>
+#include <cstdint>
+#include <string>
+#include <array>
+
+namespace {
+
+enum class syntax_errc : std::uint8_t
+{
+  empty,
+  unexpected
+};
+
+enum class range_errc
+{
+  overflow
+};
+
+/**
+ * @brief position describes a plain error condition : where parsing
+ *        failed
+ */
+struct position
+{
+  std::uint32_t line;
+  std::uint32_t column;
+};
+
+} // namespace
+
+template <>
+  struct mry::error_category< range_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "range" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "overflow" });
+};
+
+namespace {
+
+using errors_t =
+  mry::errors< syntax_errc, position >;
+using expect_t =
+  mry::expect< std::int32_t, syntax_errc, position >;
+
+auto parse( std::int32_t v )
+  -> expect_t
+{
+  if (v < 0)
+    return syntax_errc::unexpected;
+
+  if (v == 0)
+    return position{ 3, 4 };
+
+  return v;
+}
+
+auto checked( std::int32_t v )
+  -> mry::expect< std::int32_t, syntax_errc, position, range_errc >
+{
+  auto parsed =
+    co_await parse(v);
+
+  if (parsed > 100)
+    co_return range_errc::overflow;
+
+  co_return parsed * 2;
+}
+
+/**
+ * @brief describe describes any of the error conditions of `expect_t`
+ */
+auto describe( syntax_errc e )
+  -> std::string
+{ return e == syntax_errc::empty ? "empty" : "unexpected"; }
+
+auto describe( position p )
+  -> std::string
+{ return std::to_string( p.line ) + ":" + std::to_string( p.column ); }
+
+TEST_CASE( "errors<Es...> semantics", "[errors][expect<T>]" )
+{
+  SECTION( "alternatives" )
+  {
+    auto syntax =
+      errors_t{ syntax_errc::empty };
+    auto at =
+      errors_t{ position{ 1, 2 } };
+
+    STATIC_REQUIRE( 0 == errors_t::index_of<syntax_errc> );
+    STATIC_REQUIRE( 1 == errors_t::index_of<position> );
+
+    REQUIRE( 0 == syntax.index() );
+    REQUIRE( syntax.holds<syntax_errc>() );
+    REQUIRE( syntax_errc::empty == syntax.get<syntax_errc>() );
+    REQUIRE( nullptr == syntax.get_if<position>() );
+    REQUIRE( at.holds<position>() );
+    REQUIRE( 2 == at.get_if<position>()->column );
+  }
+
+  SECTION( "visit" )
+  {
+    auto visitor =
+      []( auto e ) { return describe(e); };
+
+    REQUIRE( "empty" == errors_t{ syntax_errc::empty }.visit( visitor ) );
+    REQUIRE( "1:2" == errors_t{ position{ 1, 2 } }.visit( visitor ) );
+  }
+
+  SECTION( "widened" )
+  {
+    auto widened =
+      mry::errors< range_errc, position, syntax_errc >{ errors_t{ position{ 1, 2 } } };
+
+    REQUIRE( widened.holds<position>() );
+    REQUIRE( 1 == widened.get<position>().line );
+  }
+}
+
+TEST_CASE( "expect<T, Es...> semantics", "[errors][expect<T>]" )
+{
+  SECTION( "footprint" )
+  {
+    STATIC_REQUIRE( std::is_same_v< expect_t::fail_type, errors_t > );
+    STATIC_REQUIRE( std::is_trivially_copyable_v<expect_t> );
+    STATIC_REQUIRE( sizeof(errors_t) == sizeof(position) + alignof(position) );
+    STATIC_REQUIRE( sizeof(expect_t) == sizeof(errors_t) );
+    STATIC_REQUIRE( sizeof(mry::expect< std::int64_t, syntax_errc, position >) == sizeof(std::int64_t) + alignof(std::int64_t) );
+    STATIC_REQUIRE( sizeof(mry::expect< std::array<std::int64_t, 2>, syntax_errc, position >) == 3 * sizeof(std::int64_t) );
+  }
+
+  SECTION( "success and fail" )
+  {
+    REQUIRE( 7 == parse(7).success() );
+    REQUIRE( parse(-1).fail().holds<syntax_errc>() );
+    REQUIRE( 4 == parse(0).fail().get<position>().column );
+  }
+
+  SECTION( "copy across alternatives" )
+  {
+    auto success =
+      parse(7);
+
+    success = parse(0);
+
+    REQUIRE( success.holds_error() );
+    REQUIRE( success.fail().holds<position>() );
+
+    success = parse(8);
+
+    REQUIRE( 8 == success.success() );
+  }
+
+  SECTION( "combinators" )
+  {
+    auto transformed =
+      parse(7).transform( []( std::int32_t v ) { return v * 0.5; } );
+
+    STATIC_REQUIRE( std::is_same_v< decltype(transformed), mry::expect< double, syntax_errc, position > > );
+
+    REQUIRE( 3.5 == transformed.success() );
+    REQUIRE( parse(-1).and_then( parse ).fail().holds<syntax_errc>() );
+    REQUIRE( 0 == parse(0).or_else( []( errors_t const & ) { return expect_t{0}; } ).success() );
+    REQUIRE( "3:4" == parse(0).transform_error( []( errors_t const &e ) { return e.visit( []( auto v ) { return describe(v); } ); } ).fail() );
+  }
+
+  SECTION( "coroutines widen the error conditions awaited" )
+  {
+    REQUIRE( 14 == checked(7).success() );
+    REQUIRE( checked(0).fail().holds<position>() );
+    REQUIRE( checked(-1).fail().holds<syntax_errc>() );
+    REQUIRE( checked(101).fail().holds<range_errc>() );
+  }
+}
+
+} // namespace
@@ -21,8 +21,31 @@
 
 #include <catch2/catch_test_macros.hpp>
 #include <string_view>
+#include <type_traits>
 #include <string>
 #include <cctype>
+#include <array>
+
+namespace {
+
+/**
+ * @brief atoi_errc describes the error conditions `my_atoi` may meet
+ */
+enum class atoi_errc
+{
+  non_digit
+};
+
+} //< namespace
+
+template <>
+  struct mry::error_category< atoi_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "atoi" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "non digit char" });
+};
 
 namespace {
 
@@ -33,8 +56,36 @@ namespace {
 auto my_atoi( std::string_view s ) noexcept
   -> mry::expect<int>
 {
-  using std::string_literals::operator"" s;
+  auto parsed =
+    0;
+
+  auto constexpr numeric =
+    []( char code ) noexcept
+      { return (code - '0'); };
 
+  for (auto c : s)
+    if (! std::isdigit(c))
+      return mry::error_t{"non digit char {}", c};
+
+    else
+      parsed =
+        ( parsed * 10 ) + numeric(c);
+
+  return parsed;
+}
+
+/**
+ * @brief my_atoi examplar implementation of `std::atoi`
+ *        demonstrating the use of `mry::expect<T, E>` describing
+ *        error conditions by error codes
+ *
+ * @note: as both `int` and `atoi_errc` are trivially copyable the
+ *        result is returned in registers -- just like an `int` and a
+ *        flag would be
+ */
+auto my_atoi_errc( std::string_view s ) noexcept
+  -> mry::expect<int, atoi_errc>
+{
   auto parsed =
     0;
 
@@ -44,7 +95,7 @@ auto my_atoi( std::string_view s ) noexcept
 
   for (auto c : s)
     if (! std::isdigit(c))
-      return mry::error_t{"non digit char "s + c};
+      return atoi_errc::non_digit;
 
     else
       parsed =
@@ -74,6 +125,12 @@ TEST_CASE( "expect<T> examples compile", "[expect<T>][examples]" )
 
   expect_fail( "non digit char d"
              , my_atoi( "9d" ) );
+
+  STATIC_REQUIRE( std::is_trivially_copyable_v< decltype(my_atoi_errc("")) > );
+
+  expect_success( 10, my_atoi_errc("10") );
+
+  REQUIRE( atoi_errc::non_digit == my_atoi_errc("9d").fail() );
 }
 
 } //< namespace
@@ -0,0 +1,218 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string_view>
+#include <stdexcept>
+#include <cstdint>
+#include <utility>
+#include <string>
+#include <array>
+
+namespace {
+
+enum class port_errc
+{
+  not_a_number,
+  out_of_range
+};
+
+/**
+ * @brief timeout describes an exception not derived from `std::exception`
+ */
+struct timeout
+{
+  int after;
+};
+
+} // namespace
+
+template <>
+  struct mry::error_category< port_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "port" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "not a number", "out of range" });
+};
+
+namespace {
+
+/**
+ * @brief legacy_port stands in for third-party code raising exceptions
+ */
+auto legacy_port( std::string const &text )
+  -> int
+{
+  auto port =
+    std::stoi( text );
+
+  if (port < 0 || port > 65535)
+    throw std::out_of_range{ "port out of range" };
+
+  return port;
+}
+
+auto parse_port( std::string const &text )
+  -> mry::expect<int, port_errc>
+{
+  return mry::catch_into<int, port_errc>( [&]{ return legacy_port( text ); }
+                                        , mry::catching<std::invalid_argument>( port_errc::not_a_number )
+                                        , mry::catching<std::out_of_range>( port_errc::out_of_range ) );
+}
+
+TEST_CASE( "exception boundary", "[exception][expect<T>]" )
+{
+  SECTION( "catch_into : mapped to error codes" )
+  {
+    REQUIRE( 8080 == parse_port( "8080" ).success() );
+    REQUIRE( port_errc::not_a_number == parse_port( "http" ).fail() );
+    REQUIRE( port_errc::out_of_range == parse_port( "65536" ).fail() );
+    REQUIRE( port_errc::out_of_range == parse_port( "99999999999" ).fail() );
+  }
+
+  SECTION( "catch_into : mapped to error_t" )
+  {
+    auto describe =
+      []( std::out_of_range const &x )
+        { return std::string{ "range : " } + x.what(); };
+
+    auto parsed =
+      [&]( std::string const &text )
+        {
+          return mry::catch_into<int>( [&]{ return legacy_port( text ); }
+                                     , mry::catching<std::invalid_argument>( "not a number" )
+                                     , mry::catching<std::out_of_range>( describe )
+                                     , mry::catching<timeout>( port_errc::out_of_range ) );
+        };
+
+    REQUIRE( 443 == parsed( "443" ).success() );
+    REQUIRE( "not a number" == parsed( "http" ).fail().get() );
+    REQUIRE( "range : port out of range" == parsed( "70000" ).fail().get() );
+
+    auto timed_out =
+      mry::catch_into<int>( []() -> int { throw timeout{ 30 }; }
+                          , mry::catching<std::exception>( "unexpected" )
+                          , mry::catching<timeout>( port_errc::out_of_range ) );
+
+    REQUIRE( timed_out.fail().is( port_errc::out_of_range ) );
+  }
+
+  SECTION( "catch_into : the first mapping catching wins" )
+  {
+    auto caught =
+      mry::catch_into<int>( []() -> int { throw std::out_of_range{ "e" }; }
+                          , mry::catching<std::out_of_range>( "out of range" )
+                          , mry::catching<std::logic_error>( "logic error" ) );
+
+    REQUIRE( "out of range" == caught.fail().get() );
+  }
+
+  SECTION( "catch_into : std::exception described by what()" )
+  {
+    auto caught =
+      mry::catch_into<int>( []() -> int { throw std::domain_error{ "domain" }; } );
+    auto returned =
+      mry::catch_into<std::string>( []{ return std::string{ "ok" }; } );
+
+    REQUIRE( caught.holds_error() );
+    REQUIRE( "domain" == caught.fail().get() );
+    REQUIRE( "ok" == returned.success() );
+  }
+
+  SECTION( "catch_into : exceptions not mapped propagate" )
+  {
+    auto unmapped =
+      []{ return mry::catch_into<int, port_errc>( []() -> int { throw timeout{ 1 }; }
+                                                , mry::catching<std::exception>( port_errc::out_of_range ) ); };
+    auto unmapped_code =
+      []{ return mry::catch_into<int, port_errc>( []{ return legacy_port( "x" ); } ); };
+
+    REQUIRE_THROWS_AS( unmapped(), timeout );
+    REQUIRE_THROWS_AS( unmapped_code(), std::invalid_argument );
+  }
+
+  SECTION( "catch_into : expect<void>" )
+  {
+    auto calls =
+      0;
+    auto done =
+      mry::catch_into<void>( [&]{ ++calls; } );
+    auto failed =
+      mry::catch_into<void>( []{ throw std::runtime_error{ "failed" }; } );
+
+    REQUIRE( 1 == calls );
+    REQUIRE( ! done.holds_error() );
+    REQUIRE( "failed" == failed.fail().get() );
+  }
+
+  SECTION( "value_or_throw" )
+  {
+    auto port =
+      parse_port( "22" );
+
+    REQUIRE( 22 == port.value_or_throw() );
+    REQUIRE( 22 == std::as_const( port ).value_or_throw() );
+    REQUIRE( 22 == parse_port( "22" ).value_or_throw() );
+
+    try
+    {
+      parse_port( "http" ).value_or_throw();
+      FAIL( "value_or_throw shall raise on error" );
+    }
+    catch( mry::bad_expect_access<port_errc> const &x )
+    {
+      REQUIRE( port_errc::not_a_number == x.error() );
+      REQUIRE( std::string_view{ "not a number" } == x.what() );
+    }
+
+    auto referent =
+      std::int64_t{ 7 };
+    auto reference =
+      mry::expect<std::int64_t&>{ referent };
+
+    REQUIRE( &referent == &reference.value_or_throw() );
+    REQUIRE_THROWS_AS( mry::expect<void>{ mry::error_t{ "e" } }.value_or_throw()
+                     , mry::bad_expect_access<mry::error_t> );
+  }
+
+  SECTION( "value_or_throw : across a boundary and back" )
+  {
+    auto through_legacy =
+      []( std::string const &text )
+        {
+          /* @note: the error condition crosses code raising exceptions
+           *        unchanged -- not mapped by `catching` */
+          return mry::catch_into<int, port_errc>( [&]{ return parse_port( text ).value_or_throw() + 1; }
+                                                , mry::catching<std::exception>( port_errc::not_a_number ) );
+        };
+
+    REQUIRE( 81 == through_legacy( "80" ).success() );
+    REQUIRE( port_errc::out_of_range == through_legacy( "70000" ).fail() );
+
+    auto described =
+      mry::catch_into<int>( []{ return mry::expect<int>{ mry::error_t{ "from {}", 42 } }.value_or_throw(); } );
+
+    REQUIRE( "from 42" == described.fail().get() );
+  }
+}
+
+} // namespace
@@ -0,0 +1,216 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/executor.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <system_error>
+#include <type_traits>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+auto halve( int v ) noexcept
+  -> mry::expect<int>
+{
+  if (v % 2)
+    return mry::error_t{ "odd {}", v };
+
+  return v / 2;
+}
+
+TEST_CASE( "executor semantics", "[expect<T>][executor]" )
+{
+  auto pool =
+    mry::executor{ 4 };
+
+  SECTION( "submit" )
+  {
+    auto plain =
+      pool.submit( []{ return 42; } );
+    auto halved =
+      pool.submit( []{ return halve( 8 ); } );
+    auto failed =
+      pool.submit( []{ return halve( 7 ); } );
+
+    STATIC_REQUIRE( std::is_same_v< decltype(plain), mry::future<int> > );
+
+    REQUIRE( 42 == plain.get().success() );
+    REQUIRE( 4 == halved.get().success() );
+    REQUIRE( "odd 7" == failed.get().fail().get() );
+  }
+
+  SECTION( "then" )
+  {
+    auto chained =
+      pool.submit( []{ return halve( 16 ); } )
+          .then( halve )
+          .then( []( int v ){ return v + 1; } )
+          .then( halve );
+
+    REQUIRE( "odd 5" == chained.get().fail().get() );
+
+    auto propagated =
+      pool.submit( []{ return halve( 3 ); } )
+          .then( []( int v ){ return v * 100; } );
+
+    REQUIRE( "odd 3" == propagated.get().fail().get() );
+  }
+
+  SECTION( "then : error conditions other than error_t" )
+  {
+    using errc_expect =
+      mry::expect<int, std::errc>;
+
+    auto doubled =
+      pool.submit( []{ return errc_expect{ 21 }; } )
+          .then( []( int v ){ return v * 2; } );
+
+    STATIC_REQUIRE( std::is_same_v< decltype(doubled), mry::future<int, std::errc> > );
+
+    REQUIRE( 42 == doubled.get().success() );
+
+    auto propagated =
+      pool.submit( []{ return errc_expect{ std::errc::invalid_argument }; } )
+          .then( []( int v ){ return v * 2; } )
+          .then( []( int v ){ return errc_expect{ v + 1 }; } );
+
+    REQUIRE( std::errc::invalid_argument == propagated.get().fail() );
+  }
+
+  SECTION( "then : inline once completed" )
+  {
+    auto completed =
+      pool.submit( []{ return 8; } );
+
+    completed.wait();
+
+    auto caller =
+      std::this_thread::get_id();
+    auto ran_on =
+      std::thread::id{};
+
+    auto chained =
+      completed.then( [&]( int v ){ ran_on = std::this_thread::get_id(); return v; } );
+
+    REQUIRE( chained.ready() );
+    REQUIRE( caller == ran_on );
+    REQUIRE( 8 == chained.get().success() );
+  }
+
+  SECTION( "submit / then : void" )
+  {
+    auto ran =
+      std::atomic<int>{0};
+    auto submitted =
+      pool.submit( [&]{ ++ran; } );
+
+    STATIC_REQUIRE( std::is_same_v< decltype(submitted), mry::future<void> > );
+
+    auto counted =
+      submitted.then( [&]{ return ++ran; } );
+
+    REQUIRE( 2 == counted.get().success() );
+
+    auto discarded =
+      pool.submit( []{ return 7; } )
+          .then( [&]( int v ){ ran += v; } );
+
+    STATIC_REQUIRE( std::is_same_v< decltype(discarded), mry::future<void> > );
+
+    REQUIRE( discarded.get() );
+    REQUIRE( 9 == ran.load() );
+
+    auto failed =
+      pool.submit( []{ return mry::expect<void>{ mry::error_t{ "failed" } }; } )
+          .then( [&]{ ++ran; } );
+
+    REQUIRE( "failed" == failed.get().fail().get() );
+    REQUIRE( 9 == ran.load() );
+  }
+
+  SECTION( "fan-out fan-in" )
+  {
+    auto futures =
+      std::vector< mry::future<int> >{};
+
+    for (auto i =0; i < 1000; ++i)
+      futures.push_back( pool.submit( [i]{ return halve( i ); } ) );
+
+    auto sum =
+      std::int64_t{0};
+    auto errors =
+      std::size_t{0};
+
+    for (auto &f : futures)
+    {
+      auto result =
+        f.get();
+
+      if (result.holds_error())
+        ++errors;
+
+      else
+        sum += result.success();
+    }
+
+    REQUIRE( 500 == errors );
+    REQUIRE( 249'500 / 2 == sum );
+  }
+
+  SECTION( "nested submit" )
+  {
+    auto inner =
+      std::atomic<int>{0};
+    auto outer =
+      pool.submit( [&]
+                   {
+                     for (auto i =0; i < 64; ++i)
+                       pool.submit( [&]{ return ++inner; } );
+
+                     return 0;
+                   } );
+
+    REQUIRE( 0 == outer.get().success() );
+
+    while (inner.load() < 64)
+      std::this_thread::yield();
+  }
+}
+
+TEST_CASE( "executor drains on destruction", "[expect<T>][executor]" )
+{
+  auto ran =
+    std::atomic<int>{0};
+  {
+    auto pool =
+      mry::executor{ 2 };
+
+    for (auto i =0; i < 256; ++i)
+      pool.submit( [&]{ return ++ran; } );
+  }
+
+  REQUIRE( 256 == ran.load() );
+}
+
+} // namespace
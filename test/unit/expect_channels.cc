@@ -0,0 +1,375 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect_channel.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::string_literals;
+
+/**
+ * @brief produce returns the `i`th value passed by the producers, every
+ *        8th one denoting an error
+ */
+auto produce( std::int64_t i )
+  -> mry::expect<std::int64_t>
+{
+  if (i % 8 == 7)
+    return mry::error_t{ "failed {}", i };
+
+  return i;
+}
+
+/**
+ * @brief transfer passes `count` values per producer through `channel`
+ *        returning the sum of the results and the number of errors
+ *        received
+ */
+template <typename Channel>
+  auto transfer( Channel &channel
+               , std::size_t producers
+               , std::size_t consumers
+               , std::int64_t count
+               , std::size_t batch )
+    -> std::pair<std::int64_t, std::int64_t>
+{
+  auto sum =
+    std::atomic<std::int64_t>{0};
+  auto errors =
+    std::atomic<std::int64_t>{0};
+  auto received =
+    std::atomic<std::int64_t>{0};
+  auto threads =
+    std::vector<std::jthread>{};
+
+  for (auto p =std::size_t{0}; p < producers; ++p)
+    threads.emplace_back( [&]
+    {
+      auto values =
+        std::vector< mry::expect<std::int64_t> >{};
+
+      for (auto i =std::int64_t{0}; i < count; ++i)
+        values.push_back( produce(i) );
+
+      for (auto first =values.begin(); first != values.end();)
+      {
+        auto pushed =
+          channel.push_n( first, std::min<std::size_t>( batch, values.end() - first ) );
+
+        /* @note: a full channel yields to the consumers -- lest spinning
+         *        producers starve them on runners of few cores */
+        if (pushed == 0)
+          std::this_thread::yield();
+
+        first += pushed;
+      }
+    } );
+
+  for (auto c =std::size_t{0}; c < consumers; ++c)
+    threads.emplace_back( [&]
+    {
+      auto values =
+        std::vector< mry::expect<std::int64_t> >{};
+
+      while (received.load() < count * std::int64_t( producers ))
+      {
+        values.clear();
+
+        auto popped =
+          channel.pop_n( std::back_inserter(values), batch );
+
+        for (auto &v : values)
+          v.holds_error() ? void( ++errors )
+                          : void( sum += v.success() );
+
+        if (popped == 0)
+          std::this_thread::yield();
+
+        received += popped;
+      }
+    } );
+
+  threads.clear();
+
+  return { sum.load(), errors.load() };
+}
+
+/**
+ * @brief throwing_input reads the values of `values`, throwing once
+ *        reaching the `limit`th one
+ */
+struct throwing_input
+{
+  using value_type =
+    mry::expect<std::string>;
+  using difference_type =
+    std::ptrdiff_t;
+
+  std::vector<value_type> *values;
+  std::size_t              at;
+  std::size_t              limit;
+
+  auto operator*() const
+    -> value_type&
+  {
+    if (at == limit)
+      throw std::runtime_error{ "unreadable" };
+
+    return (*values)[at];
+  }
+
+  auto operator++()
+    -> throwing_input&
+  { return ++at, *this; }
+
+  auto operator++(int)
+    -> void
+  { ++at; }
+};
+
+/**
+ * @brief throwing_output appends to `values`, throwing once holding
+ *        `limit` values
+ */
+struct throwing_output
+{
+  using difference_type =
+    std::ptrdiff_t;
+
+  std::vector< mry::expect<std::string> > *values;
+  std::size_t                              limit;
+
+  auto operator*()
+    -> throwing_output&
+  { return *this; }
+
+  auto operator++()
+    -> throwing_output&
+  { return *this; }
+
+  auto operator++(int)
+    -> throwing_output
+  { return *this; }
+
+  auto operator=( mry::expect<std::string> &&v )
+    -> throwing_output&
+  {
+    if (values->size() == limit)
+      throw std::runtime_error{ "unwritable" };
+
+    values->push_back( std::move(v) );
+    return *this;
+  }
+};
+
+/**
+ * @brief throwing_transfer pushes 4 values to `channel` with the read of
+ *        the 3rd throwing and another value past them, then pops them
+ *        with the write of the 2nd throwing, returning the values popped
+ */
+template <typename Channel>
+  auto throwing_transfer( Channel &channel )
+    -> std::vector< mry::expect<std::string> >
+{
+  auto values =
+    std::vector< mry::expect<std::string> >{ "a string beyond SSO capacity"s
+                                           , mry::error_t{ "e" }
+                                           , "x"s
+                                           , "y"s };
+  auto popped =
+    std::vector< mry::expect<std::string> >{};
+
+  REQUIRE_THROWS( channel.push_n( throwing_input{ &values, 0, 2 }, 4 ) );
+  REQUIRE( channel.try_push( "z"s ) );
+
+  REQUIRE_THROWS( channel.pop_n( throwing_output{ &popped, 1 }, 4 ) );
+
+  REQUIRE( 1 == channel.pop_n( std::back_inserter(popped), 4 ) );
+
+  return popped;
+}
+
+TEST_CASE( "expect_channel semantics", "[expect<T>][channel]" )
+{
+  SECTION( "capacity" )
+  {
+    REQUIRE( 8 == mry::expect_channel<int, mry::error_t, mry::spsc>{ 5 }.capacity() );
+    REQUIRE( 16 == mry::expect_channel<int>{ 16 }.capacity() );
+  }
+
+  SECTION( "push and pop" )
+  {
+    auto channel =
+      mry::expect_channel<std::string>{ 4 };
+
+    REQUIRE( !channel.try_pop() );
+    REQUIRE( channel.try_push( "a string beyond SSO capacity"s ) );
+    REQUIRE( channel.try_push( mry::error_t{ "e" } ) );
+
+    auto first =
+      channel.try_pop();
+    auto second =
+      channel.try_pop();
+
+    REQUIRE( "a string beyond SSO capacity" == first->success() );
+    REQUIRE( "e" == second->fail().get() );
+    REQUIRE( !channel.try_pop() );
+  }
+
+  SECTION( "failures and results of any alternative" )
+  {
+    auto spsc =
+      mry::expect_channel<void, mry::error_t, mry::spsc>{ 4 };
+    auto i =
+      42;
+    auto mpmc =
+      mry::expect_channel<int&>{ 4 };
+
+    REQUIRE( spsc.try_push( mry::expect<void>{} ) );
+    REQUIRE( spsc.try_push( mry::error_t{ "e" } ) );
+    REQUIRE( mpmc.try_push( mry::expect<int&>{ i } ) );
+    REQUIRE( mpmc.try_push( mry::error_t{ "f" } ) );
+
+    REQUIRE( !spsc.try_pop()->holds_error() );
+    REQUIRE( "e" == spsc.try_pop()->fail().get() );
+    REQUIRE( &i == &mpmc.try_pop()->success() );
+    REQUIRE( "f" == mpmc.try_pop()->fail().get() );
+  }
+
+  SECTION( "bounded" )
+  {
+    auto channel =
+      mry::expect_channel<int, mry::error_t, mry::spsc>{ 4 };
+    auto values =
+      std::vector< mry::expect<int> >{ 1, 2, 3, 4, 5, 6 };
+
+    REQUIRE( 4 == channel.push_n( values.begin(), values.size() ) );
+    REQUIRE( !channel.try_push( 7 ) );
+
+    auto popped =
+      std::vector< mry::expect<int> >{};
+
+    REQUIRE( 3 == channel.pop_n( std::back_inserter(popped), 3 ) );
+    REQUIRE( 2 == channel.push_n( values.begin() + 4, 2 ) );
+    REQUIRE( 3 == channel.pop_n( std::back_inserter(popped), 8 ) );
+    REQUIRE( 6 == popped.back().success() );
+  }
+
+  SECTION( "empty batches" )
+  {
+    auto spsc =
+      mry::expect_channel<int, mry::error_t, mry::spsc>{ 8 };
+    auto mpmc =
+      mry::expect_channel<int>{ 8 };
+    auto values =
+      std::vector< mry::expect<int> >{ 1, 2 };
+    auto popped =
+      std::vector< mry::expect<int> >{};
+
+    REQUIRE( 0 == spsc.push_n( values.begin(), 0 ) );
+    REQUIRE( 0 == spsc.pop_n( std::back_inserter(popped), 0 ) );
+    REQUIRE( 0 == mpmc.push_n( values.begin(), 0 ) );
+    REQUIRE( 0 == mpmc.pop_n( std::back_inserter(popped), 0 ) );
+
+    REQUIRE( 2 == mpmc.push_n( values.begin(), 2 ) );
+    REQUIRE( 0 == mpmc.push_n( values.begin(), 0 ) );
+    REQUIRE( 0 == mpmc.pop_n( std::back_inserter(popped), 0 ) );
+    REQUIRE( popped.empty() );
+  }
+
+  SECTION( "spsc : throwing iterators" )
+  {
+    auto channel =
+      mry::expect_channel<std::string, mry::error_t, mry::spsc>{ 8 };
+    auto popped =
+      throwing_transfer( channel );
+
+    REQUIRE( 2 == popped.size() );
+    REQUIRE( "a string beyond SSO capacity" == popped.front().success() );
+    REQUIRE( "z" == popped.back().success() );
+  }
+
+  SECTION( "mpmc : throwing iterators" )
+  {
+    auto channel =
+      mry::expect_channel<std::string>{ 8 };
+    auto popped =
+      throwing_transfer( channel );
+
+    REQUIRE( 2 == popped.size() );
+    REQUIRE( "a string beyond SSO capacity" == popped.front().success() );
+    REQUIRE( "z" == popped.back().success() );
+
+    channel.try_push( "a string beyond SSO capacity"s );
+    REQUIRE( channel.try_pop() );
+    REQUIRE( !channel.try_pop() );
+  }
+
+  SECTION( "left over values destroyed" )
+  {
+    auto channel =
+      mry::expect_channel<std::string>{ 4 };
+
+    channel.try_push( "a string beyond SSO capacity"s );
+    channel.try_push( mry::error_t{ "a dynamic {}", "description"s } );
+  }
+
+  SECTION( "spsc : concurrent" )
+  {
+    auto channel =
+      mry::expect_channel<std::int64_t, mry::error_t, mry::spsc>{ 64 };
+
+    for (auto batch : { std::size_t{1}, std::size_t{16} })
+    {
+      auto [sum, errors] =
+        transfer( channel, 1, 1, 10'000, batch );
+
+      REQUIRE( 1250 == errors );
+      REQUIRE( 10'000 * 9'999 / 2 - ( 7 + 9'999 ) * 1250 / 2 == sum );
+    }
+  }
+
+  SECTION( "mpmc : concurrent" )
+  {
+    auto channel =
+      mry::expect_channel<std::int64_t>{ 64 };
+
+    for (auto batch : { std::size_t{1}, std::size_t{16} })
+    {
+      auto [sum, errors] =
+        transfer( channel, 4, 4, 10'000, batch );
+
+      REQUIRE( 4 * 1250 == errors );
+      REQUIRE( 4 * ( 10'000 * 9'999 / 2 - ( 7 + 9'999 ) * 1250 / 2 ) == sum );
+    }
+  }
+}
+
+} // namespace
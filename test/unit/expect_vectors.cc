@@ -0,0 +1,196 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/expect_vector.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string_view>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <cstddef>
+#include <ranges>
+#include <vector>
+
+namespace {
+
+using std::string_view_literals::operator""sv;
+
+/**
+ * @brief batch returns a batch of `n` elements, every `stride`th of
+ *        which denotes an error
+ */
+auto batch( std::size_t n, std::size_t stride )
+  -> mry::expect_vector<int>
+{
+  auto batch =
+    mry::expect_vector<int>{};
+
+  batch.reserve( n );
+
+  for (auto i =std::size_t{0}; i < n; ++i)
+    if (i % stride == stride - 1)
+      batch.push_back( mry::error_t{ "at {}", i } );
+
+    else
+      batch.push_back( static_cast<int>(i) );
+
+  return batch;
+}
+
+/**
+ * @brief throwing_default throws on being default constructed once armed
+ */
+struct throwing_default
+{
+  static inline bool armed =false;
+
+  throwing_default()
+  {
+    if (armed)
+      throw std::runtime_error{ "armed" };
+  }
+
+  throwing_default( int v ) noexcept
+    : value{ v }
+  {}
+
+  int value =0;
+};
+
+TEST_CASE( "expect_vector<T> semantics", "[expect_vector<T>]" )
+{
+  SECTION( "empty" )
+  {
+    auto batch =
+      mry::expect_vector<int>{};
+
+    REQUIRE( batch.empty() );
+    REQUIRE( 0 == batch.count_errors() );
+    REQUIRE( 0 == batch.first_error() );
+    REQUIRE( batch.successes().empty() );
+  }
+
+  SECTION( "enum class : bool" )
+  {
+    enum class flag : bool { off, on };
+
+    auto batch =
+      mry::expect_vector<flag>{};
+
+    batch.push_back( flag::on );
+    batch.push_back( mry::error_t{ "off" } );
+
+    batch.success( 0 ) =
+      flag::off;
+
+    REQUIRE( flag::off == batch.success( 0 ) );
+    REQUIRE( batch.holds_error( 1 ) );
+  }
+
+  SECTION( "push_back" )
+  {
+    auto batch =
+      ::batch( 200, 7 );
+
+    REQUIRE( 200 == batch.size() );
+    REQUIRE( !batch.holds_error( 0 ) );
+    REQUIRE( batch.holds_error( 6 ) );
+    REQUIRE( 130 == batch.success( 130 ) );
+    REQUIRE( "at 69"sv == batch.fail( 69 ).get() );
+  }
+
+  SECTION( "push_fail : throwing" )
+  {
+    auto batch =
+      mry::expect_vector<throwing_default>{};
+
+    batch.push_fail( mry::error_t{ "first" } );
+    batch.push_success( 1 );
+
+    throwing_default::armed = true;
+
+    REQUIRE_THROWS( batch.push_fail( mry::error_t{ "thrown" } ) );
+
+    throwing_default::armed = false;
+
+    REQUIRE( 2 == batch.size() );
+    REQUIRE( 1 == batch.count_errors() );
+    REQUIRE( 1 == batch.errors().size() );
+
+    batch.push_fail( mry::error_t{ "second" } );
+
+    REQUIRE( batch.holds_error( 2 ) );
+    REQUIRE( "second"sv == batch.fail( 2 ).get() );
+  }
+
+  SECTION( "count_errors : across words" )
+  {
+    for (auto n : { 63u, 64u, 65u, 1000u })
+    {
+      auto batch =
+        ::batch( n, 3 );
+
+      REQUIRE( n / 3 == batch.count_errors() );
+      REQUIRE( n / 3 == batch.errors().size() );
+    }
+  }
+
+  SECTION( "first_error" )
+  {
+    REQUIRE( 99 == ::batch( 1000, 100 ).first_error() );
+    REQUIRE( 1000 == ::batch( 1000, 1001 ).first_error() );
+  }
+
+  SECTION( "successes" )
+  {
+    auto batch =
+      ::batch( 130, 2 );
+    auto expect =
+      std::vector<int>{};
+
+    for (auto i =0; i < 130; i += 2)
+      expect.push_back( i );
+
+    static_assert( std::forward_iterator< decltype(batch.successes().begin()) > );
+
+    REQUIRE( std::ranges::equal( expect, batch.successes() ) );
+    REQUIRE( 2 == std::ranges::next( batch.successes().begin() ).index() );
+    REQUIRE( 130 == std::ranges::distance( ::batch( 130, 1000 ).successes() ) );
+    REQUIRE( 0 == std::ranges::distance( ::batch( 130, 1 ).successes() ) );
+  }
+
+  SECTION( "partition" )
+  {
+    auto batch =
+      ::batch( 300, 4 );
+    auto results =
+      batch.partition();
+
+    REQUIRE( 225 == results );
+    REQUIRE( 225 == batch.first_error() );
+    REQUIRE( 75 == batch.count_errors() );
+    REQUIRE( 5 == batch.success( 4 ) );
+    REQUIRE( "at 7"sv == batch.fail( 226 ).get() );
+    REQUIRE( std::ranges::is_sorted( batch.successes() ) );
+    REQUIRE( 225 == std::ranges::distance( batch.successes() ) );
+  }
+}
+
+} // namespace
@@ -20,9 +20,201 @@
 #include "mry/expect.h"
 #include "mry/error_t.h"
 
+#include "counting_resource.h"
+
 #include <catch2/catch_test_macros.hpp>
+#include <source_location>
+#include <memory_resource>
+#include <string_view>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <thread>
+#include <memory>
 #include <string>
+#include <vector>
+#include <array>
+#include <new>
+
+namespace {
+
+enum class test_errc
+{
+  invalid,
+  overflow
+};
+
+/**
+ * @brief opaque describes a type only ever declared -- as of pimpl
+ *        and opaque handles
+ */
+struct opaque;
+
+/**
+ * @brief handle describes a type with a sentinel niche : its `fd`
+ *        is never negative
+ */
+struct handle
+{
+  std::int64_t fd;
+  std::int64_t generation;
+};
+
+/**
+ * @brief several_errors tells the alternatives of an expect of several
+ *        error conditions apart -- within constant evaluation
+ */
+constexpr
+  auto several_errors() noexcept
+    -> bool
+{
+  using expect_t =
+    mry::expect< std::int32_t, test_errc, std::uint16_t >;
+
+  auto success =
+    expect_t{ 7 };
+  auto fail =
+    expect_t{ std::uint16_t{42} };
+  auto copy =
+    expect_t{ test_errc::overflow };
+
+  if (success.holds_error() || 7 != success.success())
+    return false;
+
+  if (! fail.holds_error() || ! fail.fail().holds<std::uint16_t>())
+    return false;
+
+  copy = success;
+
+  if (copy.holds_error() || 7 != copy.success())
+    return false;
+
+  copy = fail;
+
+  return copy.holds_error()
+      && 42 == copy.fail().get<std::uint16_t>();
+}
+
+using test::counting_resource;
+
+/**
+ * @brief failing_resource fails to allocate once `remaining`
+ *        allocations are made
+ */
+struct failing_resource final
+  : std::pmr::memory_resource
+{
+  explicit
+    failing_resource( std::size_t allowed ) noexcept
+      : remaining{ allowed }
+  {}
+
+  std::size_t remaining;
+
+  auto do_allocate( std::size_t size, std::size_t alignment )
+    -> void* override
+  {
+    if (remaining == 0)
+      throw std::bad_alloc{};
+
+    --remaining;
+    return std::pmr::new_delete_resource()->allocate( size, alignment );
+  }
+
+  auto do_deallocate( void *p, std::size_t size, std::size_t alignment )
+    -> void override
+  { std::pmr::new_delete_resource()->deallocate( p, size, alignment ); }
+
+  auto do_is_equal( std::pmr::memory_resource const &o ) const noexcept
+    -> bool override
+  { return this == &o; }
+};
+
+/**
+ * @brief throwing throws on being copied or moved once armed --
+ *        counting its instances alive
+ */
+struct throwing
+{
+  static inline auto armed =false;
+  static inline auto alive =0;
+
+  std::int32_t value;
+
+  throwing( std::int32_t v ) noexcept
+    : value{ v }
+  { ++alive; }
+
+  throwing( throwing const &o )
+    : value{ o.value }
+  {
+    if (armed)
+      throw std::runtime_error{ "copy" };
+
+    ++alive;
+  }
+
+  throwing( throwing &&o )
+    : value{ o.value }
+  {
+    if (armed)
+      throw std::runtime_error{ "move" };
+
+    ++alive;
+  }
+
+  auto operator=( throwing const & )
+    -> throwing& =default;
+  auto operator=( throwing && )
+    -> throwing& =default;
+
+  ~throwing() noexcept
+  { --alive; }
+};
+
+} // namespace
+
+template <>
+  struct mry::niche_traits< handle >
+{
+  static auto constexpr available =
+    true;
+  static auto constexpr error_offset =
+    offsetof( handle, generation );
+
+  static auto holds_niche( char const *storage ) noexcept
+    -> bool
+  {
+    auto fd =
+      std::int64_t{};
+
+    std::memcpy( &fd, storage + offsetof(handle, fd), sizeof(fd) );
+
+    return fd < 0;
+  }
+
+  static auto set_niche( char *storage ) noexcept
+    -> void
+  {
+    auto constexpr fd =
+      std::int64_t{-1};
+
+    std::memcpy( storage + offsetof(handle, fd), &fd, sizeof(fd) );
+  }
+};
+
+template <>
+  struct mry::error_category< test_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "test" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "invalid", "overflow" });
+};
 
 namespace {
 
@@ -69,6 +261,326 @@ TEST_CASE( "error_t semantics", "[expect<T>][error_t]" )
     REQUIRE( fail() );
     REQUIRE( expect == fail().get() );
   }
+
+  SECTION( "literal : referred to by address" )
+  {
+    static char constexpr expect[] =
+      "e";
+    auto error =
+      mry::error_t{ expect };
+
+    REQUIRE( error );
+    REQUIRE( expect == error.get() );
+    REQUIRE( expect == error.get().data() );
+  }
+
+  SECTION( "copy and move" )
+  {
+    auto expect =
+      "a description long enough to escape SSO"s;
+    auto error =
+      mry::error_t{ expect };
+    auto copy =
+      error;
+
+    REQUIRE( expect == copy.get() );
+    REQUIRE( error.get().data() != copy.get().data() );
+
+    auto moved =
+      std::move( copy );
+
+    REQUIRE( !copy );
+    REQUIRE( expect == moved.get() );
+
+    moved =
+      mry::error_t{ "e" };
+
+    REQUIRE( "e" == moved.get() );
+  }
+
+  SECTION( "move assign : leaves the source empty" )
+  {
+    auto arena =
+      mry::basic_error_arena< counting_resource >{};
+    auto &resource =
+      arena.resource();
+
+    auto target =
+      mry::error_t{ "target"s };
+    auto source =
+      mry::error_t{ "source"s };
+
+    target =
+      std::move( source );
+
+    REQUIRE( !source );
+    REQUIRE( "source" == target.get() );
+    REQUIRE( 2 == resource.allocated );
+    REQUIRE( 1 == resource.deallocated );
+
+    auto &self =
+      target;
+
+    target =
+      std::move( self );
+
+    REQUIRE( "source" == target.get() );
+  }
+
+  SECTION( "literal : arrays of automatic storage copied" )
+  {
+    char buffer[] =
+      "mutable";
+    auto error =
+      mry::error_t{ buffer };
+    auto copied =
+      mry::error_t{ std::string{ buffer } };
+
+    buffer[0] = 'M';
+
+    REQUIRE( "mutable" == error.get() );
+    REQUIRE( "mutable" == copied.get() );
+    REQUIRE( buffer != copied.get().data() );
+  }
+
+  SECTION( "error code" )
+  {
+    auto error =
+      mry::error_t{ test_errc::overflow };
+    auto copy =
+      error;
+
+    REQUIRE( error );
+    REQUIRE( error.is( test_errc::overflow ) );
+    REQUIRE( !error.is( test_errc::invalid ) );
+    REQUIRE( "overflow" == error.get() );
+    REQUIRE( copy.is( test_errc::overflow ) );
+
+    STATIC_REQUIRE( mry::internal::code_table<test_errc>::entries[1].message
+                 == "overflow" );
+  }
+
+  SECTION( "pointer-sized" )
+  {
+#if !defined(MRY_ERROR_LOCATION) && !defined(MRY_ERROR_BACKTRACE)
+    STATIC_REQUIRE( sizeof(mry::error_t) == sizeof(void*) );
+#else
+    STATIC_REQUIRE( sizeof(mry::error_t)
+                 == sizeof(void*)
+                  + ( std::is_empty_v<mry::internal::error_location> ? 0 : sizeof(std::source_location) )
+                  + ( std::is_empty_v<mry::internal::error_backtrace> ? 0 : sizeof(mry::backtrace) ) );
+#endif
+  }
+
+  SECTION( "where" )
+  {
+    auto [e, line] =
+      std::pair{ mry::error_t{"e"}, std::source_location::current().line() };
+    auto copied =
+      e;
+    auto moved =
+      std::move(e);
+
+#if defined(MRY_ERROR_LOCATION)
+    REQUIRE( line == copied.where().line() );
+    REQUIRE( line == moved.where().line() );
+    REQUIRE( std::string_view{ __FILE__ } == moved.where().file_name() );
+#else
+    REQUIRE( 0 == copied.where().line() );
+    REQUIRE( 0 == moved.where().line() );
+    (void) line;
+#endif
+  }
+
+  SECTION( "backtrace" )
+  {
+    auto trace =
+      mry::backtrace::capture();
+
+    REQUIRE( trace.frames().size() <= mry::backtrace_depth );
+    REQUIRE( std::ranges::count( trace.symbolize(), '\n' ) == std::ssize( trace.frames() ) );
+  }
+
+  SECTION( "trace" )
+  {
+    auto e =
+      mry::error_t{"e"};
+    auto copied =
+      e;
+
+#if defined(MRY_ERROR_BACKTRACE)
+    REQUIRE( !e.trace().empty() );
+    REQUIRE( std::ranges::equal( e.trace().frames(), copied.trace().frames() ) );
+#else
+    REQUIRE( e.trace().empty() );
+    REQUIRE( copied.trace().empty() );
+#endif
+  }
+
+  SECTION( "error resource" )
+  {
+    auto resource =
+      counting_resource{};
+    auto former =
+      mry::set_error_resource( &resource );
+    {
+      auto error =
+        mry::error_t{ "dynamic "s + "description" };
+      auto copy =
+        error;
+      auto literal =
+        mry::error_t{ "static" };
+
+      REQUIRE( "dynamic description" == copy.get() );
+      REQUIRE( 2 == resource.allocated );
+    }
+
+    REQUIRE( 2 == resource.deallocated );
+    REQUIRE( &resource == mry::set_error_resource( former ) );
+    REQUIRE( std::pmr::new_delete_resource() == mry::error_resource() );
+  }
+
+  SECTION( "error resource : failing to allocate" )
+  {
+    auto arena =
+      mry::basic_error_arena< failing_resource >{ std::size_t{0} };
+    auto buffer =
+      std::array<char, 8>{ "buffer" };
+
+    REQUIRE_THROWS_AS( mry::error_t{ "dynamic"s }, std::bad_alloc );
+    REQUIRE_THROWS_AS( mry::error_t{ buffer.data() }, std::bad_alloc );
+    REQUIRE_THROWS_AS( ( mry::error_t{ "deferred {}", 42 } ), std::bad_alloc );
+  }
+
+  SECTION( "deferred description" )
+  {
+    auto error =
+      mry::error_t{ "{} at {}: {{{}}} {} {} {}", 'x', 42, "literal", -1.5, true, "owned"s };
+
+    REQUIRE( "x at 42: {literal} -1.5 true owned" == error.get() );
+    REQUIRE( error.get().data() == error.get().data() );
+
+    auto copy =
+      error;
+
+    REQUIRE( error.get() == copy.get() );
+    REQUIRE( error.get().data() != copy.get().data() );
+
+    REQUIRE( "surplus 1 {} }" == mry::error_t{ "surplus {} {} }", 1 }.get() );
+    REQUIRE( "ignored 1" == mry::error_t{ "ignored {}", 1, 2 }.get() );
+  }
+
+  SECTION( "deferred description : char arrays copied" )
+  {
+    auto make =
+      []
+      {
+        char const name[8] = { 'a', 'r', 'r', 'a', 'y', '\0', 'x', 'x' };
+
+        return mry::error_t{ "bad {} {}", name, "literal" };
+      };
+    auto error =
+      make();
+
+    REQUIRE( "bad array literal" == error.get() );
+    REQUIRE( "bad array literal" == mry::error_t{ error }.get() );
+  }
+
+  SECTION( "deferred description : rendered on demand" )
+  {
+    auto arena =
+      mry::basic_error_arena< counting_resource >{};
+    auto &resource =
+      arena.resource();
+    {
+      auto discarded =
+        mry::error_t{ "index {} out of range [0, {})", 1024, 512 };
+
+      REQUIRE( discarded );
+      REQUIRE( 1 == resource.allocated );
+
+      REQUIRE( "index 1024 out of range [0, 512)" == discarded.get() );
+      REQUIRE( 2 == resource.allocated );
+    }
+
+    REQUIRE( 2 == resource.deallocated );
+  }
+
+  SECTION( "deferred description : read concurrently" )
+  {
+    auto const error =
+      mry::error_t{ "index {} out of range [0, {})", 1024, 512 };
+    auto descriptions =
+      std::array< std::string_view, 4 >{};
+    {
+      auto readers =
+        std::vector< std::jthread >{};
+
+      for (auto &description : descriptions)
+        readers.emplace_back( [&error, &description]{ description = error.get(); } );
+    }
+
+    for (auto description : descriptions)
+    {
+      REQUIRE( "index 1024 out of range [0, 512)" == description );
+      REQUIRE( error.get().data() == description.data() );
+    }
+  }
+
+  SECTION( "deferred description : rendering fails to allocate" )
+  {
+    auto arena =
+      mry::basic_error_arena< failing_resource >{ std::size_t{1} };
+    auto error =
+      mry::error_t{ "index {} out of range [0, {})", 1024, 512 };
+
+    REQUIRE( "index {} out of range [0, {})" == error.get() );
+
+    arena.resource().remaining = 2;
+
+    REQUIRE( "index {} out of range [0, {})" == error.get() );
+    REQUIRE( "index 1024 out of range [0, 512)" == mry::error_t{ error }.get() );
+  }
+
+  SECTION( "error arena" )
+  {
+    auto former =
+      mry::error_resource();
+    {
+      auto arena =
+        mry::error_arena{};
+
+      REQUIRE( &arena.resource() == mry::error_resource() );
+
+      auto error =
+        mry::error_t{ "allocated from the arena"s };
+
+      REQUIRE( "allocated from the arena" == error.get() );
+    }
+
+    REQUIRE( former == mry::error_resource() );
+  }
+
+  SECTION( "error pool : released on another thread" )
+  {
+    auto pool =
+      mry::error_pool{};
+    auto errors =
+      std::vector< mry::error_t >{};
+
+    for (auto i =0; i < 1024; ++i)
+      errors.push_back( mry::error_t{ "pooled {}", i } );
+
+    auto releaser =
+      std::thread{ [&errors]{ errors.clear(); } };
+
+    for (auto i =0; i < 1024; ++i)
+      REQUIRE( mry::error_t{ "pooled {}", i } );
+
+    releaser.join();
+
+    REQUIRE( errors.empty() );
+  }
 }
 
 TEST_CASE( "expect<T> semantics", "[expect<T>][error_t]" )
@@ -106,4 +618,584 @@ TEST_CASE( "expect<T> semantics", "[expect<T>][error_t]" )
   }
 }
 
+TEST_CASE( "expect<T> value semantics", "[expect<T>][value]" )
+{
+  using success_t =
+    std::vector<std::int32_t>;
+  using expect_t =
+    mry::expect< success_t >;
+
+  SECTION( "copy" )
+  {
+    auto success =
+      expect_t{ success_t{ 1, 2, 3 } };
+    auto fail =
+      expect_t{ mry::error_t{ std::string{"dynamic"} } };
+    auto success_copy =
+      success;
+    auto fail_copy =
+      fail;
+
+    REQUIRE( success.success() == success_copy.success() );
+    REQUIRE( success.success().data() != success_copy.success().data() );
+    REQUIRE( fail_copy.holds_error() );
+    REQUIRE( "dynamic" == fail_copy.fail().get() );
+  }
+
+  SECTION( "move" )
+  {
+    auto success =
+      expect_t{ success_t{ 1, 2, 3 } };
+    auto data =
+      success.success().data();
+    auto moved =
+      std::move( success );
+
+    REQUIRE( moved );
+    REQUIRE( data == moved.success().data() );
+
+    STATIC_REQUIRE( std::is_nothrow_move_constructible_v<expect_t> );
+    STATIC_REQUIRE( std::is_nothrow_move_assignable_v<expect_t> );
+  }
+
+  SECTION( "assign across alternatives" )
+  {
+    auto success =
+      expect_t{ success_t{ 1, 2, 3 } };
+    auto fail =
+      expect_t{ mry::error_t{ "e" } };
+
+    success =
+      fail;
+
+    REQUIRE( success.holds_error() );
+    REQUIRE( "e" == success.fail().get() );
+
+    fail =
+      expect_t{ success_t{ 4 } };
+
+    REQUIRE( fail );
+    REQUIRE( success_t{ 4 } == fail.success() );
+  }
+
+  SECTION( "assign across alternatives : niche" )
+  {
+    auto value =
+      std::int32_t{7};
+    auto success =
+      mry::expect< std::int32_t* >{ &value };
+
+    success =
+      mry::expect< std::int32_t* >{ mry::error_t{"e"} };
+
+    REQUIRE( success.holds_error() );
+
+    success =
+      mry::expect< std::int32_t* >{ &value };
+
+    REQUIRE( &value == success.success() );
+  }
+
+  SECTION( "assign across alternatives : throwing" )
+  {
+    using throwing_t =
+      mry::expect< throwing >;
+    {
+      auto fail =
+        throwing_t{ mry::error_t{ std::string{"dynamic"} } };
+      auto success =
+        throwing_t{ throwing{ 7 } };
+
+      throwing::armed = true;
+
+      REQUIRE_THROWS_AS( fail = std::move(success), std::runtime_error );
+      REQUIRE_THROWS_AS( fail = success, std::runtime_error );
+
+      throwing::armed = false;
+
+      REQUIRE( fail.holds_error() );
+      REQUIRE( "dynamic" == fail.fail().get() );
+      REQUIRE( 1 == throwing::alive );
+
+      fail =
+        std::move(success);
+
+      REQUIRE( 7 == fail.success().value );
+      REQUIRE( 2 == throwing::alive );
+    }
+
+    REQUIRE( 0 == throwing::alive );
+
+    STATIC_REQUIRE( std::is_move_assignable_v<throwing_t> );
+    STATIC_REQUIRE( !std::is_nothrow_move_assignable_v<throwing_t> );
+  }
+
+  SECTION( "relocate" )
+  {
+    STATIC_REQUIRE( mry::is_trivially_relocatable_v< mry::error_t > );
+    STATIC_REQUIRE( mry::is_trivially_relocatable_v< mry::expect<std::int32_t> > );
+    STATIC_REQUIRE( !mry::is_trivially_relocatable_v< mry::expect<std::string> > );
+    STATIC_REQUIRE( mry::is_trivially_relocatable_v< mry::expect< std::unique_ptr<std::int32_t> > > );
+
+    using relocated_t =
+      mry::expect< std::int32_t >;
+
+    alignas(relocated_t) char from[ 2 * sizeof(relocated_t) ];
+    alignas(relocated_t) char to[ 2 * sizeof(relocated_t) ];
+
+    auto first =
+      std::construct_at( reinterpret_cast<relocated_t*>(from), 7 );
+
+    std::construct_at( first + 1, mry::error_t{ std::string{"dynamic"} } );
+
+    auto relocated =
+      reinterpret_cast<relocated_t*>(to);
+    auto end =
+      mry::uninitialized_relocate( first, first + 2, relocated );
+
+    REQUIRE( relocated + 2 == end );
+    REQUIRE( 7 == relocated[0].success() );
+    REQUIRE( "dynamic" == relocated[1].fail().get() );
+
+    std::destroy( relocated, end );
+  }
+}
+
+TEST_CASE( "expect<T> combinators", "[expect<T>][combinators]" )
+{
+  using expect_t =
+    mry::expect< std::int32_t >;
+
+  auto halve =
+    []( std::int32_t v ) -> expect_t
+      {
+        if (v % 2)
+          return mry::error_t{"odd"};
+
+        return v / 2;
+      };
+
+  SECTION( "and_then" )
+  {
+    REQUIRE( 2 == expect_t{ 8 }.and_then( halve ).and_then( halve ).success() );
+    REQUIRE( "odd" == expect_t{ 6 }.and_then( halve ).and_then( halve ).fail().get() );
+    REQUIRE( "e" == expect_t{ mry::error_t{"e"} }.and_then( halve ).fail().get() );
+  }
+
+  SECTION( "transform" )
+  {
+    auto success =
+      expect_t{ 7 };
+    auto transformed =
+      success.transform( []( std::int32_t v ) { return std::to_string(v); } );
+
+    STATIC_REQUIRE( std::is_same_v< decltype(transformed), mry::expect<std::string> > );
+
+    REQUIRE( "7" == transformed.success() );
+    REQUIRE( 7 == success.success() );
+  }
+
+  SECTION( "or_else" )
+  {
+    auto recover =
+      []( mry::error_t const & ) -> expect_t
+        { return 0; };
+
+    REQUIRE( 0 == expect_t{ mry::error_t{"e"} }.or_else( recover ).success() );
+    REQUIRE( 7 == expect_t{ 7 }.or_else( recover ).success() );
+  }
+
+  SECTION( "transform_error" )
+  {
+    auto to_code =
+      []( mry::error_t const & )
+        { return test_errc::invalid; };
+    auto transformed =
+      expect_t{ mry::error_t{"e"} }.transform_error( to_code );
+
+    STATIC_REQUIRE( std::is_same_v< decltype(transformed), mry::expect<std::int32_t, test_errc> > );
+
+    REQUIRE( test_errc::invalid == transformed.fail() );
+    REQUIRE( 7 == expect_t{ 7 }.transform_error( to_code ).success() );
+  }
+
+  SECTION( "value_or" )
+  {
+    REQUIRE( 7 == expect_t{ 7 }.value_or( 0 ) );
+    REQUIRE( 0 == expect_t{ mry::error_t{"e"} }.value_or( 0 ) );
+  }
+
+  SECTION( "rvalue receivers move" )
+  {
+    using vector_t =
+      std::vector<std::int32_t>;
+
+    auto success =
+      mry::expect< vector_t >{ vector_t{ 1, 2, 3 } };
+    auto data =
+      success.success().data();
+    auto moved =
+      std::move( success ).transform( []( vector_t v ) { return v; } );
+
+    REQUIRE( data == moved.success().data() );
+    REQUIRE( data == std::move( moved ).value_or( vector_t{} ).data() );
+  }
+}
+
+/**
+ * @brief parse describes a coroutine awaiting `mry::expect<T>`s
+ */
+auto parse( std::int32_t v ) noexcept
+  -> mry::expect< std::int32_t >
+{
+  if (v < 0)
+    return mry::error_t{"negative"};
+
+  return v;
+}
+
+auto sum( std::int32_t a, std::int32_t b )
+  -> mry::expect< std::string >
+{ co_return std::to_string( co_await parse(a) + co_await parse(b) ); }
+
+auto nested( std::int32_t depth, std::int32_t v )
+  -> mry::expect< std::int32_t, test_errc >
+{
+  if (depth == 0)
+  {
+    if (v < 0)
+      co_return test_errc::invalid;
+
+    co_return v;
+  }
+
+  co_return co_await nested( depth - 1, v ) + 1;
+}
+
+auto converted( std::int32_t v )
+  -> mry::expect< std::int32_t >
+{ co_return co_await nested( 2, v ); }
+
+auto awaiting_lvalue( mry::expect< std::int32_t > const *awaited )
+  -> mry::expect< std::int32_t >
+{ co_return co_await *awaited + 1; }
+
+auto throwing( std::int32_t v )
+  -> mry::expect< std::int32_t >
+{
+  auto parsed =
+    co_await parse(v);
+
+  if (parsed > 1)
+    throw std::runtime_error{ "thrown" };
+
+  co_return parsed;
+}
+
+auto throwing_nested( std::int32_t v )
+  -> mry::expect< std::string >
+{ co_return std::to_string( co_await throwing(v) ); }
+
+TEST_CASE( "expect<T> coroutines", "[expect<T>][coroutine]" )
+{
+  SECTION( "co_await yields the expected result" )
+  {
+    REQUIRE( "3" == sum( 1, 2 ).success() );
+  }
+
+  SECTION( "co_await returns the error condition early" )
+  {
+    auto fail =
+      sum( 1, -2 );
+
+    REQUIRE( fail.holds_error() );
+    REQUIRE( "negative" == fail.fail().get() );
+  }
+
+  SECTION( "nested" )
+  {
+    REQUIRE( 10 == nested( 8, 2 ).success() );
+    REQUIRE( test_errc::invalid == nested( 8, -2 ).fail() );
+    REQUIRE( 0 == mry::internal::frames().top );
+  }
+
+  SECTION( "return object converted once the coroutine returns" )
+  {
+    STATIC_REQUIRE( MRY_EXPECT_COROUTINES_DEFER_RETURN );
+    STATIC_REQUIRE( std::is_trivially_copyable_v< decltype( nested( 0, 0 ) ) > );
+
+    REQUIRE( 3 == nested( 2, 1 ).success() );
+    REQUIRE( test_errc::invalid == nested( 2, -1 ).fail() );
+  }
+
+  SECTION( "exceptions propagate to the caller" )
+  {
+    REQUIRE_THROWS_AS( throwing( 2 ), std::runtime_error );
+    REQUIRE_THROWS_AS( throwing_nested( 2 ), std::runtime_error );
+    REQUIRE( 0 == mry::internal::frames().top );
+
+    REQUIRE( "1" == throwing_nested( 1 ).success() );
+    REQUIRE( throwing_nested( -1 ).holds_error() );
+  }
+
+  SECTION( "error condition converted" )
+  {
+    REQUIRE( converted( -1 ).fail().is( test_errc::invalid ) );
+    REQUIRE( 3 == converted( 1 ).success() );
+  }
+
+  SECTION( "lvalue awaited : left intact" )
+  {
+    auto const awaited =
+      mry::expect< std::int32_t >{ mry::error_t{ "dynamic {}", 42 } };
+
+    REQUIRE( "dynamic 42" == awaiting_lvalue( &awaited ).fail().get() );
+    REQUIRE( "dynamic 42" == awaited.fail().get() );
+
+    auto const success =
+      mry::expect< std::int32_t >{ 41 };
+
+    REQUIRE( 42 == awaiting_lvalue( &success ).success() );
+  }
+}
+
+TEST_CASE( "expect<T> triviality", "[expect<T>][trivial]" )
+{
+  SECTION( "trivial alternatives" )
+  {
+    STATIC_REQUIRE( std::is_trivially_copyable_v< mry::expect<std::int32_t, test_errc> > );
+    STATIC_REQUIRE( std::is_trivially_copyable_v< mry::expect<double, test_errc> > );
+    STATIC_REQUIRE( std::is_trivially_destructible_v< mry::expect<std::int32_t, test_errc> > );
+  }
+
+  SECTION( "non-trivial alternatives" )
+  {
+    STATIC_REQUIRE( !std::is_trivially_destructible_v< mry::expect<std::int32_t> > );
+    STATIC_REQUIRE( !std::is_trivially_destructible_v< mry::expect<std::string, test_errc> > );
+  }
+
+  SECTION( "several error alternatives" )
+  {
+    static_assert( several_errors() );
+  }
+
+  SECTION( "floating point alternative : side by side its error code" )
+  {
+    using expect_t =
+      mry::expect< double, test_errc >;
+
+    STATIC_REQUIRE( sizeof(expect_t) == 2 * sizeof(double) );
+
+    auto success =
+      expect_t{ 0.5 };
+    auto fail =
+      expect_t{ test_errc::overflow };
+
+    REQUIRE( 0.5 == success.success() );
+    REQUIRE( test_errc::overflow == fail.fail() );
+
+    success = fail;
+
+    REQUIRE( success.holds_error() );
+    REQUIRE( test_errc::overflow == success.fail() );
+
+    fail = expect_t{ 1.5 };
+
+    REQUIRE( 1.5 == fail.success() );
+  }
+
+  SECTION( "error code alternative" )
+  {
+    using expect_t =
+      mry::expect< std::int32_t, test_errc >;
+
+    auto success =
+      expect_t{ 7 };
+    auto fail =
+      expect_t{ test_errc::overflow };
+
+    REQUIRE( 7 == success.success() );
+    REQUIRE( fail.holds_error() );
+    REQUIRE( test_errc::overflow == fail.fail() );
+  }
+}
+
+TEST_CASE( "expect<T> niche", "[expect<T>][niche]" )
+{
+  SECTION( "pointer" )
+  {
+    using expect_t =
+      mry::expect< std::int32_t* >;
+
+    STATIC_REQUIRE( sizeof(expect_t) == std::max( sizeof(std::int32_t*), sizeof(mry::error_t) ) );
+
+    auto value =
+      std::int32_t{7};
+    auto success =
+      expect_t{ &value };
+    auto null =
+      expect_t{ nullptr };
+    auto fail =
+      expect_t{ mry::error_t{"e"} };
+
+    REQUIRE( success );
+    REQUIRE( &value == success.success() );
+    REQUIRE( null );
+    REQUIRE( nullptr == null.success() );
+    REQUIRE( fail.holds_error() );
+    REQUIRE( "e" == fail.fail().get() );
+  }
+
+  SECTION( "unique_ptr" )
+  {
+    using expect_t =
+      mry::expect< std::unique_ptr<std::int32_t> >;
+
+    STATIC_REQUIRE( sizeof(expect_t) == std::max( sizeof(void*), sizeof(mry::error_t) ) );
+
+    auto success =
+      expect_t{ std::make_unique<std::int32_t>(7) };
+    auto fail =
+      expect_t{ mry::error_t{ std::string{"dynamic"} } };
+
+    REQUIRE( success );
+    REQUIRE( 7 == *success.success() );
+    REQUIRE( fail.holds_error() );
+    REQUIRE( "dynamic" == fail.fail().get() );
+  }
+
+  SECTION( "no niche : pointer to unaligned" )
+  {
+    STATIC_REQUIRE( sizeof(mry::expect<char*>) > sizeof(char*) );
+  }
+
+  SECTION( "no niche : pointer to incomplete" )
+  {
+    using expect_t =
+      mry::expect< opaque* >;
+
+    STATIC_REQUIRE( sizeof(expect_t) > std::max( sizeof(opaque*), sizeof(mry::error_t) ) );
+
+    auto null =
+      expect_t{ nullptr };
+    auto fail =
+      expect_t{ mry::error_t{"e"} };
+
+    REQUIRE( null );
+    REQUIRE( nullptr == null.success() );
+    REQUIRE( fail.holds_error() );
+    REQUIRE( "e" == fail.fail().get() );
+  }
+
+  SECTION( "sentinel" )
+  {
+    using expect_t =
+      mry::expect< handle >;
+
+#if !defined(MRY_ERROR_LOCATION) && !defined(MRY_ERROR_BACKTRACE)
+    STATIC_REQUIRE( sizeof(expect_t) == sizeof(handle) );
+#endif
+
+    auto success =
+      expect_t{ handle{ 3, 1 } };
+    auto fail =
+      expect_t{ mry::error_t{ test_errc::invalid } };
+
+    REQUIRE( success );
+    REQUIRE( 3 == success.success().fd );
+    REQUIRE( fail.holds_error() );
+    REQUIRE( fail.fail().is( test_errc::invalid ) );
+  }
+}
+
+
+/**
+ * @brief validate describes a coroutine returning `mry::expect<void>`
+ */
+auto validate( std::int32_t v )
+  -> mry::expect<void>
+{
+  co_await parse(v);
+
+  co_return {};
+}
+
+TEST_CASE( "expect<void> and expect<T&>", "[expect<T>][void][reference]" )
+{
+  using void_t =
+    mry::expect<void>;
+  using reference_t =
+    mry::expect< std::int32_t& >;
+
+  SECTION( "footprint" )
+  {
+    STATIC_REQUIRE( sizeof(void_t) == sizeof(mry::error_t) );
+    STATIC_REQUIRE( sizeof(reference_t) == std::max( sizeof(void*), sizeof(mry::error_t) ) );
+    STATIC_REQUIRE( sizeof(mry::expect<void, test_errc>) == sizeof(test_errc) + alignof(test_errc) );
+    STATIC_REQUIRE( sizeof(mry::expect<char&>) > sizeof(char*) );
+    STATIC_REQUIRE( std::is_trivially_copyable_v< mry::expect<void, test_errc> > );
+    STATIC_REQUIRE( std::is_trivially_copyable_v< mry::expect<std::int32_t&, test_errc> > );
+  }
+
+  SECTION( "void" )
+  {
+    auto success =
+      void_t{};
+    auto fail =
+      void_t{ mry::error_t{"e"} };
+
+    REQUIRE( success );
+    REQUIRE( fail.holds_error() );
+    REQUIRE( "e" == fail.fail().get() );
+
+    success = fail;
+
+    REQUIRE( success.holds_error() );
+    REQUIRE( "e" == success.fail().get() );
+  }
+
+  SECTION( "reference : refers to its referent" )
+  {
+    auto referent =
+      std::int32_t{7};
+    auto success =
+      reference_t{ referent };
+    auto copy =
+      success;
+
+    success.success() = 8;
+
+    REQUIRE( 8 == referent );
+    REQUIRE( &referent == &copy.success() );
+    REQUIRE( &referent == &std::move( copy ).success() );
+    REQUIRE( !std::is_constructible_v< reference_t, std::int32_t&& > );
+  }
+
+  SECTION( "combinators" )
+  {
+    auto referent =
+      std::int32_t{7};
+    auto twice =
+      void_t{}.and_then( [&]{ return reference_t{ referent }; } )
+              .transform( []( std::int32_t &v ) { return v * 2; } );
+    auto discarded =
+      reference_t{ referent }.transform( []( std::int32_t &v ) { ++v; } );
+
+    STATIC_REQUIRE( std::is_same_v< decltype(discarded), void_t > );
+
+    REQUIRE( 14 == twice.success() );
+    REQUIRE( discarded );
+    REQUIRE( 8 == referent );
+    REQUIRE( void_t{ mry::error_t{"e"} }.or_else( []( mry::error_t const & ) { return void_t{}; } ) );
+    REQUIRE( &referent == &reference_t{ referent }.transform_error( []( mry::error_t const & ) { return test_errc::invalid; } ).success() );
+    REQUIRE( "e" == void_t{ mry::error_t{"e"} }.and_then( [&]{ return reference_t{ referent }; } ).fail().get() );
+  }
+
+  SECTION( "coroutines" )
+  {
+    REQUIRE( validate(1) );
+    REQUIRE( "negative" == validate(-1).fail().get() );
+  }
+}
+
 } // namespace
@@ -0,0 +1,272 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/parallel.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <numeric>
+#include <limits>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <ranges>
+#include <vector>
+#include <array>
+
+namespace {
+
+enum class parse_errc
+{
+  negative
+};
+
+} // namespace
+
+template <>
+  struct mry::error_category< parse_errc >
+{
+  static auto constexpr name =
+    std::string_view{ "parse" };
+  static auto constexpr messages =
+    std::to_array<std::string_view>({ "negative" });
+};
+
+namespace {
+
+auto validate( int v ) noexcept
+  -> mry::expect<int>
+{
+  if (v < 0)
+    return mry::error_t{ "negative at {}", -v };
+
+  return v * 2;
+}
+
+auto inputs( std::size_t n, std::vector<std::size_t> failing ={} )
+  -> std::vector<int>
+{
+  auto inputs =
+    std::vector<int>( n );
+
+  std::iota( inputs.begin(), inputs.end(), 0 );
+
+  for (auto i : failing)
+    inputs[i] = -static_cast<int>(i);
+
+  return inputs;
+}
+
+auto constexpr policy =
+  mry::parallel_policy{ .threads = 4, .grain = 16 };
+
+TEST_CASE( "parallel algorithms", "[expect<T>][parallel]" )
+{
+  SECTION( "parallel_collect : success" )
+  {
+    auto collected =
+      mry::parallel_collect( inputs( 1000 ), validate, policy );
+
+    REQUIRE( !collected.holds_error() );
+    REQUIRE( 1000 == collected.success().size() );
+    REQUIRE( 1998 == collected.success().back() );
+    REQUIRE( std::ranges::is_sorted( collected.success() ) );
+  }
+
+  SECTION( "parallel_collect : first error by position" )
+  {
+    for (auto run =0; run < 16; ++run)
+    {
+      auto collected =
+        mry::parallel_collect( inputs( 1000, { 999, 517, 40, 41 } ), validate, policy );
+
+      REQUIRE( collected.holds_error() );
+      REQUIRE( "negative at 40" == collected.fail().get() );
+    }
+  }
+
+  SECTION( "parallel_collect : cancels beyond the first error" )
+  {
+    auto invoked =
+      std::atomic<std::size_t>{0};
+    auto collected =
+      mry::parallel_collect( inputs( 100'000, { 10 } )
+                           , [&]( int v )
+                             {
+                               ++invoked;
+                               return validate( v );
+                             }
+                           , policy );
+
+    REQUIRE( collected.holds_error() );
+    REQUIRE( invoked < 100'000 );
+  }
+
+  SECTION( "parallel_collect : error codes" )
+  {
+    auto collected =
+      mry::parallel_collect( std::views::iota( -4, 4 )
+                           , []( int v ) -> mry::expect<int, parse_errc>
+                             {
+                               if (v < 0)
+                                 return parse_errc::negative;
+
+                               return v;
+                             }
+                           , policy );
+
+    REQUIRE( parse_errc::negative == collected.fail() );
+  }
+
+  SECTION( "parallel_collect_all" )
+  {
+    auto collected =
+      mry::parallel_collect_all( inputs( 1000, { 999, 517, 40 } ), validate, policy );
+
+    REQUIRE( collected.holds_error() );
+    REQUIRE( 3 == collected.fail().size() );
+    REQUIRE( "negative at 40" == collected.fail()[0].get() );
+    REQUIRE( "negative at 999" == collected.fail()[2].get() );
+
+    REQUIRE( 1000 == mry::parallel_collect_all( inputs( 1000 ), validate, policy )
+                       .success().size() );
+  }
+
+  SECTION( "parallel_transform_reduce" )
+  {
+    auto plus =
+      []( std::int64_t l, std::int64_t r ){ return l + r; };
+    auto widen =
+      []( int v ) -> mry::expect<std::int64_t>
+      {
+        auto validated =
+          validate( v );
+
+        if (validated.holds_error())
+          return std::move( validated.fail() );
+
+        return std::int64_t{ validated.success() };
+      };
+
+    auto reduced =
+      mry::parallel_transform_reduce( inputs( 1000 ), std::int64_t{1}, plus, widen, policy );
+
+    REQUIRE( 1 + 999 * 1000 == reduced.success() );
+
+    auto failed =
+      mry::parallel_transform_reduce( inputs( 1000, { 700, 300 } ), std::int64_t{0}, plus, widen, policy );
+
+    REQUIRE( "negative at 300" == failed.fail().get() );
+  }
+
+  SECTION( "grain beyond the size of the range" )
+  {
+    auto huge =
+      mry::parallel_policy{ .threads = 4, .grain = std::numeric_limits<std::size_t>::max() };
+
+    REQUIRE( "negative at 5" == mry::parallel_collect( inputs( 10, { 5 } ), validate, huge )
+                                  .fail().get() );
+    REQUIRE( 1 == mry::parallel_collect_all( inputs( 10, { 5 } ), validate, huge )
+                    .fail().size() );
+    REQUIRE( 10 == mry::parallel_collect( inputs( 10 ), validate, huge )
+                     .success().size() );
+    REQUIRE( 90 == mry::parallel_transform_reduce( inputs( 10 ), 0, std::plus<>{}, validate, huge )
+                     .success() );
+  }
+
+  SECTION( "empty range" )
+  {
+    REQUIRE( mry::parallel_collect( std::vector<int>{}, validate ).success().empty() );
+  }
+
+  SECTION( "executor given" )
+  {
+    auto pool =
+      mry::executor{ 2 };
+    auto pooled =
+      policy;
+
+    pooled.pool = &pool;
+
+    auto collected =
+      mry::parallel_collect( inputs( 1000, { 517 } ), validate, pooled );
+
+    REQUIRE( "negative at 517" == collected.fail().get() );
+    REQUIRE( 999 * 1000 == mry::parallel_transform_reduce( inputs( 1000 ), 0, std::plus<>{}, validate, pooled )
+                             .success() );
+  }
+
+  SECTION( "run_chunks : throwing on the calling thread" )
+  {
+    auto pool =
+      mry::executor{ 2 };
+    auto pooled =
+      policy;
+
+    pooled.pool = &pool;
+
+    auto caller =
+      std::this_thread::get_id();
+    auto running =
+      std::atomic<int>{0};
+
+    auto chunk =
+      [&]( std::size_t )
+      {
+        if (std::this_thread::get_id() == caller)
+          throw std::runtime_error{ "chunk" };
+
+        ++running;
+        std::this_thread::sleep_for( std::chrono::milliseconds{1} );
+        --running;
+      };
+
+    REQUIRE_THROWS_AS( mry::internal::run_chunks( 64, pooled, chunk ), std::runtime_error );
+    REQUIRE( 0 == running.load() );
+  }
+
+  SECTION( "executor given : nested within its jobs" )
+  {
+    auto pool =
+      mry::executor{ 2 };
+    auto pooled =
+      policy;
+
+    pooled.pool = &pool;
+
+    auto nested =
+      std::vector< mry::future<std::size_t> >{};
+
+    for (auto j =0; j < 8; ++j)
+      nested.push_back( pool.submit( [&pooled]
+                                     {
+                                       return mry::parallel_collect( inputs( 1000 ), validate, pooled )
+                                                .success().size();
+                                     } ) );
+
+    for (auto &f : nested)
+      REQUIRE( 1000 == f.get().success() );
+  }
+}
+
+} // namespace
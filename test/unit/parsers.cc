@@ -0,0 +1,333 @@
+// Copyright (c) 2024 Imre Szekeres <iszekeres.x@gmail.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "mry/parse.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <system_error>
+#include <string_view>
+#include <filesystem>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+#include <bit>
+
+namespace {
+
+using mry::parse_errc;
+
+/**
+ * @brief digit_prefix_of validates `text` by `Block`s against a plain
+ *        char by char loop
+ */
+template <typename Block>
+  auto digit_prefix_of( std::string const &text )
+    -> bool
+{
+  auto first =
+    text.data();
+  auto last =
+    first + text.size();
+  auto expected =
+    first;
+
+  while (expected != last && *expected >= '0' && *expected <= '9')
+    ++expected;
+
+  return expected == mry::internal::digit_prefix<Block>( first, last );
+}
+
+template <typename Block>
+  auto classifies( std::string const &window )
+    -> bool
+{
+  auto classes =
+    mry::internal::classify_window<Block>( window.data() );
+
+  for (auto i =std::size_t{0}; i < mry::internal::window_width; ++i)
+  {
+    auto c =
+      window[i];
+
+    if (( ( classes.digits >> i ) & 1 ) != ( c >= '0' && c <= '9' )
+     || ( ( classes.separators >> i ) & 1 ) != mry::internal::is_separator(c))
+      return false;
+  }
+
+  return true;
+}
+
+TEST_CASE( "parse<T>", "[parse]" )
+{
+  SECTION( "integers" )
+  {
+    REQUIRE( 0 == mry::parse<int>( "0" ).success() );
+    REQUIRE( 8080 == mry::parse<std::uint16_t>( "8080" ).success() );
+    REQUIRE( -42 == mry::parse<int>( "-42" ).success() );
+    REQUIRE( 7 == mry::parse<int>( "0000000000000000000000000000000000000000007" ).success() );
+    REQUIRE( 12345678901234567 == mry::parse<std::int64_t>( "12345678901234567" ).success() );
+
+    REQUIRE( std::numeric_limits<std::int32_t>::min() == mry::parse<std::int32_t>( "-2147483648" ).success() );
+    REQUIRE( std::numeric_limits<std::int32_t>::max() == mry::parse<std::int32_t>( "2147483647" ).success() );
+    REQUIRE( std::numeric_limits<std::int64_t>::min() == mry::parse<std::int64_t>( "-9223372036854775808" ).success() );
+    REQUIRE( std::numeric_limits<std::uint64_t>::max() == mry::parse<std::uint64_t>( "18446744073709551615" ).success() );
+    REQUIRE( 255 == mry::parse<std::uint8_t>( "255" ).success() );
+  }
+
+  SECTION( "integers : error conditions" )
+  {
+    REQUIRE( parse_errc::empty == mry::parse<int>( "" ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<int>( "-" ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<int>( "+1" ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<int>( " 1" ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<int>( "12a" ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<int>( "1.5" ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<unsigned>( "-1" ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<int>( "12345678901234567890123456789012345x" ).fail() );
+
+    REQUIRE( parse_errc::overflow == mry::parse<std::int32_t>( "2147483648" ).fail() );
+    REQUIRE( parse_errc::overflow == mry::parse<std::int32_t>( "-2147483649" ).fail() );
+    REQUIRE( parse_errc::overflow == mry::parse<std::uint8_t>( "256" ).fail() );
+    REQUIRE( parse_errc::overflow == mry::parse<std::int64_t>( "9223372036854775808" ).fail() );
+    REQUIRE( parse_errc::overflow == mry::parse<std::uint64_t>( "18446744073709551616" ).fail() );
+    REQUIRE( parse_errc::overflow == mry::parse<std::uint64_t>( "99999999999999999999" ).fail() );
+    REQUIRE( parse_errc::overflow == mry::parse<std::uint64_t>( "100000000000000000000" ).fail() );
+
+    auto failed =
+      mry::expect<int>{ mry::error_t{ mry::parse<int>( "x" ).fail() } };
+
+    REQUIRE( "invalid char" == failed.fail().get() );
+  }
+
+  SECTION( "floating point numbers" )
+  {
+    auto matches =
+      []<typename T>( T, std::string_view text )
+        {
+          using bits_type =
+            std::conditional_t< sizeof(T) == 8, std::uint64_t, std::uint32_t >;
+
+          auto expected =
+            T{};
+          auto [_, error] =
+            std::from_chars( text.data(), text.data() + text.size(), expected );
+          auto parsed =
+            mry::parse<T>( text );
+
+          if (error != std::errc{})
+            return parsed.holds_error() && parse_errc::overflow == parsed.fail();
+
+          return ! parsed.holds_error()
+              && std::bit_cast<bits_type>( parsed.success() ) == std::bit_cast<bits_type>( expected );
+        };
+
+    for (auto text : { "0", "-0", "1", "3.25", "-0.5", ".5", "5.", "1e10", "1E-5", "2.5e+3"
+                     , "0.1", "0.3", "123456789012345678", "1.7976931348623157e308"
+                     , "4.9406564584124654e-324", "2.2250738585072014e-308"
+                     , "9007199254740993", "0.000000000000000000000000000001"
+                     , "3.14159265358979323846264338327950288", "1e22", "1e23", "7e-23" })
+    {
+      INFO( text );
+      REQUIRE( matches( double{}, text ) );
+      REQUIRE( matches( float{}, text ) );
+    }
+  }
+
+  SECTION( "floating point numbers : error conditions" )
+  {
+    REQUIRE( parse_errc::empty == mry::parse<double>( "" ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<double>( "." ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<double>( "-" ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<double>( "1e" ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<double>( "1.2.3" ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<double>( "inf" ).fail() );
+    REQUIRE( parse_errc::invalid_char == mry::parse<double>( "0x1p3" ).fail() );
+
+    REQUIRE( parse_errc::overflow == mry::parse<double>( "1e309" ).fail() );
+    REQUIRE( parse_errc::overflow == mry::parse<float>( "1e39" ).fail() );
+  }
+
+  SECTION( "digits validated by SIMD and SWAR blocks alike" )
+  {
+    auto texts =
+      std::vector<std::string>{};
+
+    for (auto length : { 0, 1, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100 })
+      for (auto invalid : { -1, 0, 7, 8, 15, 16, 31, 32, 63, 64 })
+      {
+        auto text =
+          std::string( length, '7' );
+
+        if (invalid >= 0 && invalid < length)
+          text[invalid] = invalid % 2 ? '/' : ':';
+
+        texts.push_back( text );
+      }
+
+    for (auto const &text : texts)
+    {
+      INFO( text );
+      REQUIRE( digit_prefix_of<mry::internal::swar_block>( text ) );
+      REQUIRE( digit_prefix_of<mry::internal::parse_block>( text ) );
+    }
+
+    auto window =
+      std::string{};
+
+    for (auto c =0; c < 256; ++c)
+      window.push_back( static_cast<char>(c) );
+
+    for (auto at =std::size_t{0}; at < window.size(); at += mry::internal::window_width)
+    {
+      auto part =
+        window.substr( at, mry::internal::window_width );
+
+      REQUIRE( classifies<mry::internal::swar_block>( part ) );
+      REQUIRE( classifies<mry::internal::parse_block>( part ) );
+    }
+  }
+}
+
+TEST_CASE( "parse_many<T>", "[parse]" )
+{
+  SECTION( "tokens and error conditions" )
+  {
+    auto parsed =
+      mry::parse_many<int>( "1, 2,3\n-4 x\t99999999999\r\n 007  " );
+
+    REQUIRE( 7 == parsed.size() );
+    REQUIRE( 2 == parsed.count_errors() );
+    REQUIRE( -4 == parsed.success(3) );
+    REQUIRE( parse_errc::invalid_char == parsed.fail(4) );
+    REQUIRE( parse_errc::overflow == parsed.fail(5) );
+    REQUIRE( 7 == parsed.success(6) );
+
+    REQUIRE( mry::parse_many<int>( "" ).empty() );
+    REQUIRE( mry::parse_many<int>( " ,\n, " ).empty() );
+  }
+
+  SECTION( "tokens across windows" )
+  {
+    auto text =
+      std::string{};
+    auto expected =
+      std::vector<std::int64_t>{};
+
+    /* @note: tokens of growing lengths, separated by growing runs, end
+     *        at any offset within a window -- a long one spans several */
+    for (auto i =std::int64_t{1}; i < 400; ++i)
+    {
+      auto value =
+        ( i * 7919 ) % 1000000007 * ( i % 3 ? 1 : -1 );
+
+      text += std::to_string( value );
+      text += std::string( i % 5 + 1, i % 2 ? ' ' : ',' );
+      expected.push_back( value );
+    }
+
+    text += std::string( 150, '0' ) + "12";
+    expected.push_back( 12 );
+
+    auto parsed =
+      mry::parse_many<std::int64_t>( text );
+
+    REQUIRE( expected.size() == parsed.size() );
+    REQUIRE( 0 == parsed.count_errors() );
+
+    for (auto i =std::size_t{0}; i < expected.size(); ++i)
+      REQUIRE( expected[i] == parsed.success(i) );
+  }
+
+  SECTION( "floating point numbers" )
+  {
+    auto parsed =
+      mry::parse_many<double>( "0.5 -1e3,2.25\n.125 1e999 nan" );
+
+    REQUIRE( 6 == parsed.size() );
+    REQUIRE( 0.5 == parsed.success(0) );
+    REQUIRE( -1000.0 == parsed.success(1) );
+    REQUIRE( 0.125 == parsed.success(3) );
+    REQUIRE( parse_errc::overflow == parsed.fail(4) );
+    REQUIRE( parse_errc::invalid_char == parsed.fail(5) );
+  }
+
+  SECTION( "memory-mapped file" )
+  {
+    auto path =
+      ( std::filesystem::temp_directory_path() / "mry_parse_many.txt" ).string();
+
+    {
+      auto file =
+        std::ofstream{ path };
+
+      for (auto i =0; i < 1000; ++i)
+        file << i << '\n';
+    }
+
+    auto mapped =
+      mry::mapped_file::open( path );
+
+    REQUIRE( ! mapped.holds_error() );
+
+    auto parsed =
+      mry::parse_many<int>( mapped.success().text() );
+
+    REQUIRE( 1000 == parsed.size() );
+    REQUIRE( 999 == parsed.success(999) );
+
+    std::filesystem::remove( path );
+
+    auto missing =
+      mry::mapped_file::open( path );
+
+    REQUIRE( missing.holds_error() );
+    REQUIRE( missing.fail().get().starts_with( "cannot open " + path ) );
+
+    std::ofstream{ path };
+
+    auto empty =
+      mry::mapped_file::open( path );
+
+    REQUIRE( ! empty.holds_error() );
+    REQUIRE( empty.success().text().empty() );
+
+    std::filesystem::remove( path );
+  }
+
+  SECTION( "memory-mapped file : not a regular file" )
+  {
+    auto device =
+      mry::mapped_file::open( "/dev/null" );
+
+    REQUIRE( device.holds_error() );
+    REQUIRE( device.fail().get() == "cannot map /dev/null : not a regular file" );
+
+    auto directory =
+      mry::mapped_file::open( std::filesystem::temp_directory_path().string() );
+
+    REQUIRE( directory.holds_error() );
+    REQUIRE( directory.fail().get().ends_with( "not a regular file" ) );
+  }
+}
+
+} // namespace